@@ -0,0 +1,42 @@
+#include "stdafx.h"
+
+#include "NES/Allocator.h"
+
+namespace ninmuse
+{
+	Arena::Arena( const size_t capacity ) noexcept
+		: mCapacity( capacity )
+		, mOffset( 0 )
+		, mData( static_cast<std::byte*>( ::operator new( capacity, std::align_val_t( DEFAULT_ALIGNMENT ), std::nothrow ) ) )
+	{
+		NM_ASSERT( mData != nullptr, "Failed to allocate an arena!!" );
+	}
+
+	Arena::~Arena() noexcept
+	{
+		if ( mData != nullptr )
+		{
+			::operator delete( mData, std::align_val_t( DEFAULT_ALIGNMENT ) );
+		}
+	}
+
+	void* Arena::Allocate( const size_t size, const size_t alignment ) noexcept
+	{
+		NM_ASSERT( ( alignment & ( alignment - 1 ) ) == 0, "Alignment must be a power of two!!" );
+
+		const size_t alignedOffset = ( mOffset + alignment - 1 ) & ~( alignment - 1 );
+		if ( mData == nullptr || alignedOffset + size > mCapacity )
+		{
+			NM_ASSERT( false, "Arena is out of memory!!" );
+			return nullptr;
+		}
+
+		mOffset = alignedOffset + size;
+		return mData + alignedOffset;
+	}
+
+	void Arena::Reset() noexcept
+	{
+		mOffset = 0;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <new>
+
+#include "Common.h"
+
+namespace ninmuse
+{
+	template <typename T>
+	concept Allocator = requires( T allocator, void* memory, const size_t size, const size_t alignment )
+	{
+		{ allocator.Allocate( size, alignment ) } noexcept -> std::same_as<void*>;
+		{ allocator.Deallocate( memory, size, alignment ) } noexcept;
+	};
+
+	// General purpose heap allocator. Stateless, so containers using it stay as small as before.
+	class DefaultAllocator final
+	{
+	public:
+		inline void* Allocate( const size_t size, const size_t alignment ) noexcept
+		{
+			return ::operator new( size, std::align_val_t( alignment ), std::nothrow );
+		}
+
+		inline void Deallocate( void* memory, const size_t, const size_t alignment ) noexcept
+		{
+			::operator delete( memory, std::align_val_t( alignment ) );
+		}
+
+		inline constexpr bool operator==( const DefaultAllocator& ) const noexcept { return true; }
+	};
+	static_assert( Allocator<DefaultAllocator> );
+
+	// Linear (bump) arena. Every allocation is carved out of one contiguous block, and nothing is
+	// returned to the arena until Reset(). Meant for emulator state whose lifetime is the lifetime of the console.
+	class Arena final
+	{
+	public:
+		static constexpr const size_t DEFAULT_ALIGNMENT = CACHE_LINE_SIZE;
+
+	public:
+		Arena() = delete;
+		Arena( const size_t capacity ) noexcept;
+		Arena( const Arena& ) = delete;
+		Arena( Arena&& ) = delete;
+		~Arena() noexcept;
+
+		Arena& operator=( const Arena& ) = delete;
+		Arena& operator=( Arena&& ) = delete;
+
+	public:
+		void*						Allocate( const size_t size, const size_t alignment ) noexcept;
+		inline constexpr void		Deallocate( void*, const size_t, const size_t ) noexcept {}
+		void						Reset() noexcept;
+
+		inline constexpr std::byte*			GetData() noexcept { return mData; }
+		inline constexpr const std::byte*	GetData() const noexcept { return mData; }
+		inline constexpr size_t				GetCapacity() const noexcept { return mCapacity; }
+		inline constexpr size_t				GetUsedSize() const noexcept { return mOffset; }
+
+	private:
+		size_t		mCapacity;
+		size_t		mOffset;
+		std::byte*	mData;
+	};
+
+	// Allocator handle that forwards to an Arena. Containers store the handle, not the arena itself.
+	class ArenaAllocator final
+	{
+	public:
+		ArenaAllocator() = delete;
+		inline constexpr explicit ArenaAllocator( Arena& arena ) noexcept : mArena( &arena ) {}
+
+	public:
+		inline void* Allocate( const size_t size, const size_t alignment ) noexcept
+		{
+			return mArena->Allocate( size, alignment );
+		}
+
+		inline void Deallocate( void* memory, const size_t size, const size_t alignment ) noexcept
+		{
+			mArena->Deallocate( memory, size, alignment );
+		}
+
+		inline constexpr Arena&		GetArena() const noexcept { return *mArena; }
+		inline constexpr bool		operator==( const ArenaAllocator& other ) const noexcept { return mArena == other.mArena; }
+
+	private:
+		Arena*	mArena;
+	};
+	static_assert( Allocator<ArenaAllocator> );
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdlib>
+
+#include "NES/Allocator.h"
+
+namespace ninmuse
+{
+	// Raw storage operations of the growable arrays. DynamicArray and InlineArray only differ in where their first
+	// elements live, so allocation, relocation and destruction are written once here for both.
+	template <typename ElementType>
+	struct ArrayStorage final
+	{
+		// Element types that can be moved to a new address with a plain memcpy and no destructor call on the old one.
+		static constexpr const bool IS_TRIVIALLY_RELOCATABLE = std::is_trivially_copyable_v<ElementType> && std::is_trivially_destructible_v<ElementType>;
+
+		template <Allocator TAllocator>
+		static inline ElementType* Allocate( TAllocator& allocator, const size_t capacity ) noexcept
+		{
+			ElementType* paData = static_cast<ElementType*>( allocator.Allocate( sizeof( ElementType ) * capacity, alignof( ElementType ) ) );
+			NM_ASSERT( paData != nullptr, "Failed to allocate an array!!" );
+			return paData;
+		}
+
+		// For growth that has to succeed, like EmplaceBack(), which must return a reference to the new element.
+		// With a fixed-size arena behind the array a failure means the arena was sized too small; no caller can recover.
+		template <Allocator TAllocator>
+		static inline ElementType* AllocateOrAbort( TAllocator& allocator, const size_t capacity ) noexcept
+		{
+			ElementType* paData = Allocate( allocator, capacity );
+			if ( paData == nullptr )
+			{
+				std::cerr << "Failed to grow an array to " << capacity << " elements!!" << std::endl;
+				std::abort();
+			}
+
+			return paData;
+		}
+
+		template <Allocator TAllocator>
+		static inline void Deallocate( TAllocator& allocator, ElementType* data, const size_t capacity ) noexcept
+		{
+			if ( data != nullptr )
+			{
+				allocator.Deallocate( data, sizeof( ElementType ) * capacity, alignof( ElementType ) );
+			}
+		}
+
+		// Moves count elements to uninitialized destination and ends their lifetime at source
+		static inline void Relocate( ElementType* destination, ElementType* source, const size_t count ) noexcept
+		{
+			if ( count == 0 )
+			{
+				return;
+			}
+
+			if constexpr ( IS_TRIVIALLY_RELOCATABLE )
+			{
+				memcpy( destination, source, sizeof( ElementType ) * count );
+			}
+			else
+			{
+				for ( size_t index = 0; index < count; ++index )
+				{
+					std::construct_at( destination + index, std::move( source[index] ) );
+					std::destroy_at( source + index );
+				}
+			}
+		}
+
+		static inline void Destroy( ElementType* data, const size_t count ) noexcept
+		{
+			if constexpr ( std::is_trivially_destructible_v<ElementType> == false )
+			{
+				std::destroy_n( data, count );
+			}
+		}
+	};
+}
\ No newline at end of file
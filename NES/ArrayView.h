@@ -5,7 +5,7 @@
 namespace ninmuse
 {
 	template <typename ElementType>
-	class ArrayView final : IArray<ElementType>
+	class ArrayView final : public IArray<ElementType>
 	{
 	public:
 		ArrayView() = delete;
@@ -13,6 +13,10 @@ namespace ninmuse
 			: mSize( size )
 			, mData( originalArray.GetData() + startIndex )
 		{}
+		inline constexpr ArrayView( ElementType* data, const size_t size ) noexcept
+			: mSize( size )
+			, mData( data )
+		{}
 		ArrayView( const ArrayView& ) = delete;
 		explicit ArrayView( ArrayView&& ) noexcept = default;
 		~ArrayView() = default;
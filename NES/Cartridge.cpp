@@ -1,350 +1,252 @@
 #include "stdafx.h"
 
-#include <bitset>
-
 #include "NES/Cartridge.h"
 #include "NES/DynamicArray.hpp"
+#include "NES/Hash.h"
+#include "NES/RomDatabase.h"
 
 namespace ninmuse
 {
 	namespace nes
 	{
-		Cartridge::Cartridge( const std::filesystem::path& romFilePath ) noexcept
+		RomImage::RomImage( const std::filesystem::path& romFilePath ) noexcept
 			: mRomFilePath( romFilePath )
-			, mRomFile()
-			, mHeader()
+			, mRomFile( romFilePath )
+			, mCrc32( 0 )
+			, mInfo()
 			, mTrainer()
 			, mProgramRom()
 			, mCharacterRom()
+			, mCharacterRomTileCacheFlag()
+			, mCharacterRomTileCache()
 		{
-			mRomFile.open( mRomFilePath.c_str(), std::ios_base::binary | std::ios_base::in );
-			NM_ASSERT( mRomFile.is_open(), "Given ROM file is not open!!" );
+			NM_ASSERT( mRomFile.IsOpen(), "Given ROM file is not open!!" );
+			if ( mRomFile.IsOpen() )
+			{
+				read();
+			}
 		}
 
-		Cartridge::~Cartridge()
+		std::shared_ptr<const RomImage> RomImage::Open( const std::filesystem::path& romFilePath ) noexcept
 		{
-			mRomFile.close();
-		}
+			// Weak references, so an image is unmapped as soon as the last cartridge using it goes away
+			static std::mutex openedImagesMutex;
+			static std::map<std::filesystem::path, std::weak_ptr<const RomImage>> openedImages;
 
-		static constexpr const char* PRESENT = "Present";
-		static constexpr const char* NOT_PRESENT = "Not Present";
-		static constexpr const char* IsPresentToString( const bool isPresent ) noexcept
-		{
-			return isPresent ? PRESENT : NOT_PRESENT;
-		}
+			std::error_code errorCode;
+			std::filesystem::path key = std::filesystem::weakly_canonical( romFilePath, errorCode );
+			if ( errorCode )
+			{
+				key = romFilePath;
+			}
 
-		void Cartridge::Read() noexcept
-		{
-			ReadHeader();
-			if ( mHeader->Flags06.Bits.IsTrainerPresent )
+			const std::lock_guard<std::mutex> lock( openedImagesMutex );
+			std::weak_ptr<const RomImage>& openedImage = openedImages[key];
+			std::shared_ptr<const RomImage> romImage = openedImage.lock();
+			if ( romImage == nullptr )
 			{
-				ReadTrainer();
+				romImage = std::make_shared<const RomImage>( romFilePath );
+				openedImage = romImage;
 			}
-			ReadProgramRom();
+
+			return romImage;
 		}
 
-		const Cartridge::Header& Cartridge::ReadHeader() noexcept
+		const TileCache& RomImage::GetCharacterRomTileCache() const noexcept
 		{
-			mHeader = std::make_unique<Header>();
-			static constexpr const size_t HEADER_DATA_KEY_WIDTH = 32;
-#define HEADER_DATA_KEY_ALIGNMENT (std::right)
-			// Read Header (16 bytes)
-			{
-				char headerData[Header::SIZE] = {
-					0,
-				};
-				mRomFile.read( headerData, Header::SIZE );
-				memcpy( mHeader->Identification, &headerData[Header::ID_INDEX], Header::ID_SIZE );
-				memcpy( &mHeader->ProgramRomSize, &headerData[Header::PRG_ROM_SIZE_INDEX], Header::PRG_ROM_SIZE_SIZE );
-				memcpy( &mHeader->CharacterRomSize, &headerData[Header::CHARACTER_ROM_SIZE_INDEX], Header::CHARACTER_ROM_SIZE_SIZE );
-				memcpy( &mHeader->Flags06.Value, &headerData[Header::FLAGS06_INDEX], Header::FLAGS06_SIZE );
-				memcpy( &mHeader->Flags07.Value, &headerData[Header::FLAGS07_INDEX], Header::FLAGS07_SIZE );
-				memcpy( &mHeader->Flags08.Value, &headerData[Header::FLAGS08_INDEX], Header::FLAGS08_SIZE );
-				memcpy( &mHeader->Flags09.Value, &headerData[Header::FLAGS09_INDEX], Header::FLAGS09_SIZE );
-				memcpy( &mHeader->Flags10.Value, &headerData[Header::FLAGS10_INDEX], Header::FLAGS10_SIZE );
-				memcpy( &mHeader->Flags11.Value, &headerData[Header::FLAGS11_INDEX], Header::FLAGS11_SIZE );
-				memcpy( &mHeader->Flags12.Value, &headerData[Header::FLAGS12_INDEX], Header::FLAGS12_SIZE );
-				memcpy( &mHeader->Flags13.Value, &headerData[Header::FLAGS13_INDEX], Header::FLAGS13_SIZE );
-				memcpy( &mHeader->Flags14.Value, &headerData[Header::FLAGS14_INDEX], Header::FLAGS14_SIZE );
-				memcpy( &mHeader->Flags15.Value, &headerData[Header::FLAGS15_INDEX], Header::FLAGS15_SIZE );
-
-				// Read Identification String (4 bytes)
-				{
-					std::cout << std::setw( HEADER_DATA_KEY_WIDTH ) << HEADER_DATA_KEY_ALIGNMENT << "Identification: ";
-					std::cout << mHeader->Identification << std::endl;
-				}
-				// PRG-ROM Size
+			// Not built by the constructor, so scanning a ROM library never decodes CHR-ROM
+			std::call_once( mCharacterRomTileCacheFlag, [this]() noexcept
 				{
-					std::cout << std::setw( HEADER_DATA_KEY_WIDTH ) << HEADER_DATA_KEY_ALIGNMENT;
-					if ( isNes2_0Format() == false )
-					{
-						std::cout << "PRG-ROM Size: ";
-					}
-					else
-					{
-						std::cout << "PRG-ROM Size Low: ";
-					}
-					std::cout << static_cast< uint32_t >( mHeader->ProgramRomSize.Value ) << std::endl;
-				}
-				// CHR-ROM Size
-				{
-					std::cout << std::setw( HEADER_DATA_KEY_WIDTH ) << HEADER_DATA_KEY_ALIGNMENT;
-					if ( isNes2_0Format() == false )
-					{
-						std::cout << "CHR-ROM Size: ";
-					}
-					else
-					{
-						std::cout << "CHR-ROM Size Low: ";
-					}
-					std::cout << static_cast< uint32_t >( mHeader->CharacterRomSize.Value ) << std::endl;
-				}
-				// Flags06
-				{
-					// Mapper
-					std::cout << std::setw( HEADER_DATA_KEY_WIDTH ) << HEADER_DATA_KEY_ALIGNMENT << "Mapper D03...D00: ";
-					std::cout << "0b"
-						<< static_cast< uint32_t >( mHeader->Flags06.Bits.MapperD03 )
-						<< static_cast< uint32_t >( mHeader->Flags06.Bits.MapperD02 )
-						<< static_cast< uint32_t >( mHeader->Flags06.Bits.MapperD01 )
-						<< static_cast< uint32_t >( mHeader->Flags06.Bits.MapperD00 ) << std::endl;
-					// Four Screen Mode
-					std::cout << std::setw( HEADER_DATA_KEY_WIDTH ) << HEADER_DATA_KEY_ALIGNMENT << "Hard-Wired Four Screen Mode: ";
-					std::cout << std::boolalpha << mHeader->Flags06.Bits.FourScreenMode << std::endl;
-					// Trainer
-					std::cout << std::setw( HEADER_DATA_KEY_WIDTH ) << HEADER_DATA_KEY_ALIGNMENT << "512-byte Trainer: ";
-					std::cout << IsPresentToString( mHeader->Flags06.Bits.IsTrainerPresent ) << std::endl;
-					// Battery
-					std::cout << std::setw( HEADER_DATA_KEY_WIDTH ) << HEADER_DATA_KEY_ALIGNMENT << "Battery: ";
-					std::cout << IsPresentToString( mHeader->Flags06.Bits.Battery ) << std::endl;
-					// Mirroring Type
-					std::cout << std::setw( HEADER_DATA_KEY_WIDTH ) << HEADER_DATA_KEY_ALIGNMENT << "Mirroring Type: ";
-					std::cout << ( mHeader->Flags06.Bits.MirroringType ? "Vertical" : "Horizontal" ) << std::endl;
-				}
-				// Flags07
-				{
-					// Mapper
-					std::cout << std::setw( HEADER_DATA_KEY_WIDTH ) << HEADER_DATA_KEY_ALIGNMENT << "Mapper D07...D04: ";
-					std::cout << "0b"
-						<< mHeader->Flags07.Bits.MapperD07
-						<< mHeader->Flags07.Bits.MapperD06
-						<< mHeader->Flags07.Bits.MapperD05
-						<< mHeader->Flags07.Bits.MapperD04 << std::endl;
-					// NES 2.0 Identifier
-					std::cout << std::setw( HEADER_DATA_KEY_WIDTH ) << HEADER_DATA_KEY_ALIGNMENT << "Is NES 2.0 Format?: ";
-					std::cout << std::boolalpha << isNes2_0Format() << std::endl;
-					// Console Type
-					std::cout << std::setw( HEADER_DATA_KEY_WIDTH ) << HEADER_DATA_KEY_ALIGNMENT << "Console Type: ";
-					std::cout << ConsoleTypeToString( mHeader->Flags07.Bits.ConsoleType ) << std::endl;
-				}
-				// Flags08
-				{
-					// NES
-					if ( isNes2_0Format() == false )
-					{
-						std::cout << std::setw( HEADER_DATA_KEY_WIDTH ) << HEADER_DATA_KEY_ALIGNMENT << "PRG RAM Size: ";
-						std::cout << static_cast< uint32_t >( mHeader->Flags08.NESBits.PrgRamSize ) << std::endl;
-					}
-					// NES 2.0
-					else
-					{
-						// Submapper number
-						std::cout << std::setw( HEADER_DATA_KEY_WIDTH ) << HEADER_DATA_KEY_ALIGNMENT << "Mapper D11...D08: ";
-						std::cout << "0b"
-							<< std::bitset<4>( mHeader->Flags08.NES2_0Bits.SubmapperNumber ) << std::endl;
+					mCharacterRomTileCache.Build( mCharacterRom.Data.GetData(), mCharacterRom.Data.GetSize() );
+				} );
+			return mCharacterRomTileCache;
+		}
 
-						// Mapper number
-						std::cout << std::setw( HEADER_DATA_KEY_WIDTH ) << HEADER_DATA_KEY_ALIGNMENT << "Mapper D11...D08: ";
-						std::cout << "0b"
-							<< mHeader->Flags08.NES2_0Bits.MapperD11
-							<< mHeader->Flags08.NES2_0Bits.MapperD10
-							<< mHeader->Flags08.NES2_0Bits.MapperD09
-							<< mHeader->Flags08.NES2_0Bits.MapperD08 << std::endl;
-					}
-				}
-				// Flags09
-				{
-					// NES
-					if ( isNes2_0Format() == false )
-					{
-						std::cout << std::setw( HEADER_DATA_KEY_WIDTH ) << HEADER_DATA_KEY_ALIGNMENT << "TV System: ";
-						switch ( mHeader->Flags09.NESBits.TvSystem )
-						{
-						case eTvSystemType::NTSC:
-							std::cout << "NTSC";
-							break;
-						case eTvSystemType::PAL:
-							std::cout << "PAL";
-							break;
-						default:
-							NM_ASSERT( false, "Invalid TV System Type!!" );
-							break;
-						}
-						std::cout << std::endl;
-					}
-					// NES 2.0
-					else
-					{
-						// CHR-Rom Size MSB
-						std::cout << std::setw( HEADER_DATA_KEY_WIDTH ) << HEADER_DATA_KEY_ALIGNMENT << "CHR-ROM Size High: ";
-						std::cout << mHeader->Flags09.NES2_0Bits.ChrRomSizeHigh << std::endl;
+		Cartridge::Cartridge( std::shared_ptr<const RomImage> romImage ) noexcept
+			: Cartridge( std::move( romImage ), std::filesystem::path() )
+		{
+		}
 
-						// PRG-ROM Size MSB
-						std::cout << std::setw( HEADER_DATA_KEY_WIDTH ) << HEADER_DATA_KEY_ALIGNMENT << "PRG-ROM Size High: ";
-						std::cout << mHeader->Flags09.NES2_0Bits.PrgRomSizeHigh << std::endl;
-					}
-				}
-				// Flags10
-				{
-					// NES
-					if ( isNes2_0Format() == false )
-					{
-						if ( ( isNtsc() && HasTvSystemType( mHeader->Flags10.NESBits.TvSystemBits, eTvSystemType::NTSC ) ) || ( isPal() && HasTvSystemType( mHeader->Flags10.NESBits.TvSystemBits, eTvSystemType::PAL ) ) )
-						{
-							std::cout << std::setw( HEADER_DATA_KEY_WIDTH ) << HEADER_DATA_KEY_ALIGNMENT << "Board has confict: ";
-							std::cout << std::boolalpha << mHeader->Flags10.NESBits.HasBusConflict << std::endl;
-							std::cout << std::setw( HEADER_DATA_KEY_WIDTH ) << HEADER_DATA_KEY_ALIGNMENT << "Is PRG-RAM present: ";
-							std::cout << std::boolalpha << mHeader->Flags10.NESBits.PrgRam << std::endl;
-							std::cout << std::setw( HEADER_DATA_KEY_WIDTH ) << HEADER_DATA_KEY_ALIGNMENT << "TV System Bits: ";
+		Cartridge::Cartridge( std::shared_ptr<const RomImage> romImage, const std::filesystem::path& saveFilePath ) noexcept
+			: mRomImage( std::move( romImage ) )
+			, mSaveFileOrNull()
+		{
+			NM_ASSERT( mRomImage != nullptr, "Cartridge needs a ROM image!!" );
+			const CartridgeInfo& info = mRomImage->GetInfo();
 
-							std::cout << TvSystemTypeBitsToString( mHeader->Flags10.NESBits.TvSystemBits ) << std::endl;
-						}
-					}
-					// NES 2.0
-					else
-					{
-						std::cout << std::setw( HEADER_DATA_KEY_WIDTH ) << HEADER_DATA_KEY_ALIGNMENT << "PRG-NVRAM/EEPROM (non-volatile) shift count: ";
-						std::cout << mHeader->Flags10.NES2_0Bits.PrgNvramEepromShiftCount << std::endl;
-						std::cout << std::setw( HEADER_DATA_KEY_WIDTH ) << HEADER_DATA_KEY_ALIGNMENT << "PRG-RAM (volatile) shift count: ";
-						std::cout << mHeader->Flags10.NES2_0Bits.PrgRamShiftCount << std::endl;
-					}
-				}
-				if ( isNes2_0Format() )
+			// Only the battery-backed part; it leads CartridgeRamState::ProgramRam, so the volatile part after it never reaches the file
+			if ( info.ProgramNvramSize > 0 && saveFilePath.empty() == false )
+			{
+				mSaveFileOrNull = std::make_unique<WritableMappedFile>( saveFilePath, info.ProgramNvramSize );
+				NM_ASSERT( mSaveFileOrNull->IsOpen(), "Failed to open the save file!!" );
+				if ( mSaveFileOrNull->IsOpen() == false )
 				{
-					// Flags11
-					{
-						std::cout << std::setw( HEADER_DATA_KEY_WIDTH ) << HEADER_DATA_KEY_ALIGNMENT << "CHR-NVRAM (non-volatile) shift count: ";
-						std::cout << mHeader->Flags11.NES2_0Bits.ChrNvramShiftCount << std::endl;
-						std::cout << std::setw( HEADER_DATA_KEY_WIDTH ) << HEADER_DATA_KEY_ALIGNMENT << "CHR-RAM (volatile) shift count: ";
-						std::cout << mHeader->Flags11.NES2_0Bits.ChrRamShiftCount << std::endl;
-					}
-					// Flags12
-					{
-						std::cout << std::setw( HEADER_DATA_KEY_WIDTH ) << HEADER_DATA_KEY_ALIGNMENT << "CPU/PPU timing mode: ";
-						std::cout << CpuPpuTimingModeToString( mHeader->Flags12.NES2_0Bits.CpuPpuTimingMode ) << std::endl;
-					}
-					// Flags13
-					{
-						if ( isVsSystem() )
-						{
-							std::cout << std::setw( HEADER_DATA_KEY_WIDTH ) << HEADER_DATA_KEY_ALIGNMENT << "Vs. Hardware Type: ";
-							std::cout << VsHardwareTypeToString( mHeader->Flags13.NES2_0BitsVsSystem.VsHardwareType ) << std::endl;
-							std::cout << std::setw( HEADER_DATA_KEY_WIDTH ) << HEADER_DATA_KEY_ALIGNMENT << "PPU Type: ";
-							std::cout << PpuTypeToString( mHeader->Flags13.NES2_0BitsVsSystem.PpuType ) << std::endl;
-						}
-						else if ( isExtendedConsoleType() )
-						{
-							std::cout << std::setw( HEADER_DATA_KEY_WIDTH ) << HEADER_DATA_KEY_ALIGNMENT << "Extended Console Type: ";
-							std::cout << ExtendedConsoleTypeToString( mHeader->Flags13.NES2_0BitsExtendedConsoleType.ExtendedConsoleType ) << std::endl;
-						}
-						else
-						{
-							NM_ASSERT( false, "Invalid system!!" );
-						}
-					}
-					// Flags14
-					{
-						std::cout << std::setw( HEADER_DATA_KEY_WIDTH ) << HEADER_DATA_KEY_ALIGNMENT << "Number of miscellaneous ROMs present: ";
-						std::cout << mHeader->Flags14.NES2_0Bits.NumMiscellaneousRomsPresent << std::endl;
-					}
-					// Flags15
-					{
-						std::cout << std::setw( HEADER_DATA_KEY_WIDTH ) << HEADER_DATA_KEY_ALIGNMENT << "Default Expansion Device: ";
-						std::cout << mHeader->Flags15.NES2_0Bits.DefaultExpansionDevice << std::endl;
-					}
+					mSaveFileOrNull.reset();
 				}
 			}
 
-			return *mHeader;
+			// Decoded here, on the loading thread, so the renderer never decodes CHR-ROM; only the first cartridge of an image pays for it
+			if ( mRomImage->GetCharacterRom().Data.IsEmpty() == false )
+			{
+				mRomImage->GetCharacterRomTileCache();
+			}
 		}
 
-		const Cartridge::Trainer& Cartridge::ReadTrainer() noexcept
+		Cartridge::Cartridge( const std::filesystem::path& romFilePath ) noexcept
+			: Cartridge( RomImage::Open( romFilePath ) )
 		{
-			NM_ASSERT( mHeader->Flags06.Bits.IsTrainerPresent, "Trainer data is not present!!" );
-			mTrainer = std::make_unique<Cartridge::Trainer>();
-
-			mRomFile.read( mTrainer->Data, Trainer::DATA_SIZE );
-
-			return *mTrainer;
 		}
 
-		const DynamicArray<data_t>& Cartridge::ReadProgramRom() noexcept
+		void Cartridge::ReadSaveData( data_t* outProgramRam ) const noexcept
 		{
-			// [TODO]: Vs. Dual System calculates program ROM differently.
-			const size_t programRomSize = getProgramRomSize();
-			std::cout << "PRG-ROM Size: " << programRomSize << std::endl;
-
-			mProgramRom.Data.SetSize( programRomSize );
-			for ( size_t i = 0; i < programRomSize; ++i )
+			if ( mSaveFileOrNull != nullptr )
 			{
-				mRomFile.read( reinterpret_cast<char*>( &mProgramRom.Data[i] ), 1 );
+				memcpy( outProgramRam, mSaveFileOrNull->GetData(), mSaveFileOrNull->GetSize() );
 			}
+		}
 
-			return mProgramRom.Data;
+		void Cartridge::FlushSaveData( const data_t* programRam, const bool waitForCompletion ) noexcept
+		{
+			if ( mSaveFileOrNull != nullptr )
+			{
+				// Unchanged RAM leaves the mapped pages clean, so there is nothing for the writeback to do
+				if ( memcmp( mSaveFileOrNull->GetData(), programRam, mSaveFileOrNull->GetSize() ) != 0 )
+				{
+					memcpy( mSaveFileOrNull->GetData(), programRam, mSaveFileOrNull->GetSize() );
+				}
+				mSaveFileOrNull->Flush( waitForCompletion );
+			}
 		}
 
-		const DynamicArray<data_t>& Cartridge::ReadCharacterRom() noexcept
+		// Header field extraction, checked against known headers
+		namespace
 		{
-			const size_t characterRomSize = getCharacterRomSize();
-			std::cout << "CHR-ROM Size: " << characterRomSize << std::endl;
+			// The Legend of Zelda: iNES, MMC1, battery-backed PRG-RAM, CHR-RAM
+			constexpr const data_t ZELDA_HEADER[CartridgeInfo::HEADER_SIZE] = { 0x4E, 0x45, 0x53, 0x1A, 0x08, 0x00, 0x12, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+			constexpr const CartridgeInfo ZELDA_INFO = ParseCartridgeInfo( ZELDA_HEADER );
+			static_assert( ZELDA_INFO.IsValid && ZELDA_INFO.IsNes2_0 == false );
+			static_assert( ZELDA_INFO.MapperNumber == 1 );
+			static_assert( ZELDA_INFO.MirroringType == eMirroringType::HORIZONTAL );
+			static_assert( ZELDA_INFO.HasBattery && ZELDA_INFO.HasTrainer == false );
+			static_assert( ZELDA_INFO.ProgramRomSize == 128 * KILO_BYTE && ZELDA_INFO.CharacterRomSize == 0 );
+			static_assert( ZELDA_INFO.ProgramRamSize == 0 && ZELDA_INFO.ProgramNvramSize == 8 * KILO_BYTE );
+			static_assert( ZELDA_INFO.CharacterRamSize == 8 * KILO_BYTE );
+			static_assert( ZELDA_INFO.CpuPpuTimingMode == eCpuPpuTimingMode::RP2C02 );
+
+			// NES 2.0, UxROM, vertical mirroring, 8 KB CHR-RAM as shift count 7, multiple-region timing
+			constexpr const data_t NES_2_0_UXROM_HEADER[CartridgeInfo::HEADER_SIZE] = { 0x4E, 0x45, 0x53, 0x1A, 0x02, 0x00, 0x21, 0x08, 0x00, 0x00, 0x00, 0x07, 0x02, 0x00, 0x00, 0x00 };
+			constexpr const CartridgeInfo NES_2_0_UXROM_INFO = ParseCartridgeInfo( NES_2_0_UXROM_HEADER );
+			static_assert( NES_2_0_UXROM_INFO.IsValid && NES_2_0_UXROM_INFO.IsNes2_0 );
+			static_assert( NES_2_0_UXROM_INFO.MapperNumber == 2 && NES_2_0_UXROM_INFO.SubmapperNumber == 0 );
+			static_assert( NES_2_0_UXROM_INFO.MirroringType == eMirroringType::VERTICAL );
+			static_assert( NES_2_0_UXROM_INFO.ProgramRomSize == 32 * KILO_BYTE && NES_2_0_UXROM_INFO.CharacterRomSize == 0 );
+			static_assert( NES_2_0_UXROM_INFO.ProgramRamSize == 0 && NES_2_0_UXROM_INFO.CharacterRamSize == 8 * KILO_BYTE );
+			static_assert( NES_2_0_UXROM_INFO.CpuPpuTimingMode == eCpuPpuTimingMode::MULTIPLE_REGION );
+
+			// NES 2.0 edge cases: 12-bit mapper with submapper, exponent-multiplier PRG-ROM size, four-screen, trainer, PAL
+			constexpr const data_t NES_2_0_EXTREME_HEADER[CartridgeInfo::HEADER_SIZE] = { 0x4E, 0x45, 0x53, 0x1A, ( 10 << 2 ) | 1, 0x01, 0xFC, 0xF8, 0x5F, 0x0F, 0x97, 0x00, 0x01, 0x00, 0x00, 0x00 };
+			constexpr const CartridgeInfo NES_2_0_EXTREME_INFO = ParseCartridgeInfo( NES_2_0_EXTREME_HEADER );
+			static_assert( NES_2_0_EXTREME_INFO.MapperNumber == 0xFFF && NES_2_0_EXTREME_INFO.SubmapperNumber == 5 );
+			static_assert( NES_2_0_EXTREME_INFO.ProgramRomSize == ( 1 << 10 ) * 3 );
+			static_assert( NES_2_0_EXTREME_INFO.CharacterRomSize == 8 * KILO_BYTE );
+			static_assert( NES_2_0_EXTREME_INFO.MirroringType == eMirroringType::FOUR_SCREEN && NES_2_0_EXTREME_INFO.HasTrainer );
+			static_assert( NES_2_0_EXTREME_INFO.ProgramRamSize == ( 64 << 7 ) && NES_2_0_EXTREME_INFO.ProgramNvramSize == ( 64 << 9 ) );
+			static_assert( NES_2_0_EXTREME_INFO.CpuPpuTimingMode == eCpuPpuTimingMode::RP2C07 );
+
+			constexpr const data_t INVALID_HEADER[CartridgeInfo::HEADER_SIZE] = { 0x4E, 0x45, 0x53, 0x00, 0x08 };
+			static_assert( ParseCartridgeInfo( INVALID_HEADER ).IsValid == false );
+		}
 
-			mCharacterRom.Data.SetSize( characterRomSize );
-			mRomFile.read( reinterpret_cast<char*>( mCharacterRom.Data.GetData() ), characterRomSize );
-			return mCharacterRom.Data;
+		static constexpr const char* PRESENT = "Present";
+		static constexpr const char* NOT_PRESENT = "Not Present";
+		static constexpr const char* IsPresentToString( const bool isPresent ) noexcept
+		{
+			return isPresent ? PRESENT : NOT_PRESENT;
 		}
 
-		size_t Cartridge::getProgramRomSize() const noexcept
+		void RomImage::read() noexcept
 		{
-			ProgramRom::Size programRomSizeData;
-			if ( isNes2_0Format() )
+			const data_t* headerData = getRomData( 0, CartridgeInfo::HEADER_SIZE );
+			if ( headerData == nullptr )
 			{
-				programRomSizeData.NES2_0Bits.SizeHigh = mHeader->Flags09.NES2_0Bits.PrgRomSizeHigh;
+				return;
 			}
-			programRomSizeData.NESBits.Size = mHeader->ProgramRomSize.Value;
 
-			if ( isNes2_0Format() && programRomSizeData.NES2_0Bits.SizeHigh != 0b1111 )
+			mInfo = ParseCartridgeInfo( headerData );
+			if ( mInfo.IsValid == false )
 			{
-				const size_t programRomSize =
-					( static_cast< size_t >( 2 ) << static_cast< size_t >( programRomSizeData.NES2_0Bits.SizeLow.ExponentMultiplier.Exponent ) ) * ( static_cast< size_t >( programRomSizeData.NES2_0Bits.SizeLow.ExponentMultiplier.Multiplier ) * 2 + 1 );
-				return programRomSize;
+				return;
 			}
-			else
+
+			// Known dumps get their board from the database, before any section offset or RAM size is derived from it
+			mCrc32 = ComputeCrc32( mRomFile.GetData() + CartridgeInfo::HEADER_SIZE, mRomFile.GetSize() - CartridgeInfo::HEADER_SIZE );
+			if ( const RomDatabaseEntry* databaseEntry = FindRomDatabaseEntry( mCrc32 ); databaseEntry != nullptr )
+			{
+				ApplyRomDatabaseEntry( *databaseEntry, mInfo );
+			}
+
+			if ( mInfo.HasTrainer )
+			{
+				const data_t* trainerData = getRomData( getTrainerOffset(), Trainer::DATA_SIZE );
+				if ( trainerData != nullptr )
+				{
+					mTrainer.emplace();
+					memcpy( mTrainer->Data, trainerData, Trainer::DATA_SIZE );
+				}
+			}
+
+			// [TODO]: Vs. Dual System calculates program ROM differently.
+			const data_t* programRomData = getRomData( getProgramRomOffset(), mInfo.ProgramRomSize );
+			if ( programRomData != nullptr )
 			{
-				const size_t programRomSize = programRomSizeData.Value * ProgramRom::PROGRAM_SIZE_UNIT;
-				return programRomSize;
+				mProgramRom.Data = ArrayView<const data_t>( programRomData, mInfo.ProgramRomSize );
+			}
+
+			const data_t* characterRomData = getRomData( getCharacterRomOffset(), mInfo.CharacterRomSize );
+			if ( characterRomData != nullptr )
+			{
+				mCharacterRom.Data = ArrayView<const data_t>( characterRomData, mInfo.CharacterRomSize );
 			}
 		}
 
-		size_t Cartridge::getCharacterRomSize() const noexcept
+		void PrintCartridgeInfo( const CartridgeInfo& info ) noexcept
 		{
-			CharacterRom::Size characterRomSizeData;
-			if ( isNes2_0Format() )
+			static constexpr const int KEY_WIDTH = 32;
+
+			if ( info.IsValid == false )
 			{
-				characterRomSizeData.NES2_0Bits.SizeHigh = mHeader->Flags09.NES2_0Bits.ChrRomSizeHigh;
+				std::cout << std::setw( KEY_WIDTH ) << std::right << "Identification: " << "Invalid" << std::endl;
+				return;
 			}
-			characterRomSizeData.NESBits.Size = mHeader->CharacterRomSize.Value;
 
-			if ( isNes2_0Format() && characterRomSizeData.NES2_0Bits.SizeHigh != 0b1111 )
+			std::cout << std::setw( KEY_WIDTH ) << std::right << "Format: " << ( info.IsNes2_0 ? "NES 2.0" : "iNES" ) << ( info.IsCorrected ? " (corrected by ROM database)" : "" ) << '\n';
+			std::cout << std::setw( KEY_WIDTH ) << std::right << "Mapper: " << info.MapperNumber << '\n';
+			if ( info.IsNes2_0 )
 			{
-				const size_t characterRomSize =
-					( static_cast< size_t >( 2 ) << static_cast< size_t >( characterRomSizeData.NES2_0Bits.SizeLow.ExponentMultiplier.Exponent ) ) * ( static_cast< size_t >( characterRomSizeData.NES2_0Bits.SizeLow.ExponentMultiplier.Multiplier ) * 2 + 1 );
-				return characterRomSize;
+				std::cout << std::setw( KEY_WIDTH ) << std::right << "Submapper: " << static_cast< uint32_t >( info.SubmapperNumber ) << '\n';
 			}
-			else
+			std::cout << std::setw( KEY_WIDTH ) << std::right << "Console Type: " << ConsoleTypeToString( info.ConsoleType ) << '\n';
+			std::cout << std::setw( KEY_WIDTH ) << std::right << "CPU/PPU Timing Mode: " << CpuPpuTimingModeToString( info.CpuPpuTimingMode ) << '\n';
+			std::cout << std::setw( KEY_WIDTH ) << std::right << "Mirroring Type: " << MirroringTypeToString( info.MirroringType ) << '\n';
+			std::cout << std::setw( KEY_WIDTH ) << std::right << "Battery: " << IsPresentToString( info.HasBattery ) << '\n';
+			std::cout << std::setw( KEY_WIDTH ) << std::right << "512-byte Trainer: " << IsPresentToString( info.HasTrainer ) << '\n';
+			std::cout << std::setw( KEY_WIDTH ) << std::right << "PRG-ROM Size: " << info.ProgramRomSize << '\n';
+			std::cout << std::setw( KEY_WIDTH ) << std::right << "CHR-ROM Size: " << info.CharacterRomSize << '\n';
+			std::cout << std::setw( KEY_WIDTH ) << std::right << "PRG-RAM Size: " << info.ProgramRamSize << '\n';
+			std::cout << std::setw( KEY_WIDTH ) << std::right << "PRG-NVRAM Size: " << info.ProgramNvramSize << '\n';
+			std::cout << std::setw( KEY_WIDTH ) << std::right << "CHR-RAM Size: " << info.CharacterRamSize << '\n';
+			std::cout << std::setw( KEY_WIDTH ) << std::right << "CHR-NVRAM Size: " << info.CharacterNvramSize << std::endl;
+		}
+
+		const data_t* RomImage::getRomData( const size_t offset, const size_t size ) const noexcept
+		{
+			if ( mRomFile.IsOpen() == false || offset + size > mRomFile.GetSize() )
 			{
-				const size_t characterRomSize = characterRomSizeData.Value * CharacterRom::PROGRAM_SIZE_UNIT;
-				return characterRomSize;
+				NM_ASSERT( false, "ROM file is truncated!!" );
+				return nullptr;
 			}
+
+			return reinterpret_cast<const data_t*>( mRomFile.GetData() ) + offset;
 		}
 	}
 }
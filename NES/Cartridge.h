@@ -1,8 +1,13 @@
 #pragma once
 
-#include <fstream>
+#include <map>
+#include <mutex>
+#include <optional>
 
 #include "DynamicArray.h"
+#include "NES/ArrayView.h"
+#include "NES/MappedFile.h"
+#include "NES/TileCache.h"
 
 namespace ninmuse
 {
@@ -99,6 +104,17 @@ namespace ninmuse
 		};
 		static_assert( static_cast< size_t >( eExtendedConsoleType::COUNT ) == 0x10 );
 
+		enum class eMirroringType : uint8_t
+		{
+			HORIZONTAL = 0,	// Vertical arrangement (CIRAM A10 = PPU A11), or mapper-controlled
+			VERTICAL,		// Horizontal arrangement (CIRAM A10 = PPU A10)
+			FOUR_SCREEN,	// Extra nametable RAM on the cartridge
+			SINGLE_SCREEN_LOWER,	// Mapper-controlled only: every nametable is the first 1 KB of CIRAM
+			SINGLE_SCREEN_UPPER,	// Mapper-controlled only: every nametable is the second 1 KB of CIRAM
+			COUNT,
+		};
+		static_assert( static_cast< size_t >( eMirroringType::COUNT ) == 5 );
+
 		// Typedefs
 		using tv_system_type_bits_t = uint8_t;
 
@@ -274,211 +290,143 @@ namespace ninmuse
 			return nullptr;
 		}
 
+		inline constexpr const char* MirroringTypeToString( const eMirroringType mirroringType ) noexcept
+		{
+			switch ( mirroringType )
+			{
+			case eMirroringType::HORIZONTAL:	return "Horizontal";
+			case eMirroringType::VERTICAL:		return "Vertical";
+			case eMirroringType::FOUR_SCREEN:	return "Four Screen";
+			case eMirroringType::SINGLE_SCREEN_LOWER:	return "Single Screen (Lower)";
+			case eMirroringType::SINGLE_SCREEN_UPPER:	return "Single Screen (Upper)";
+			default:
+				NM_ASSERT( false, "Invalid mirroring type!!" );
+				break;
+			}
+			return nullptr;
+		}
+
 		// Classes
-		class Cartridge final
+
+		// Everything the emulator needs from an iNES or NES 2.0 header, decoded into plain fields
+		struct CartridgeInfo final
 		{
-		public:
-			struct Header
+			static constexpr const size_t HEADER_SIZE = 16;
+			static constexpr const size_t PROGRAM_ROM_SIZE_UNIT = 16'384;
+			static constexpr const size_t CHARACTER_ROM_SIZE_UNIT = 8'192;
+			static constexpr const size_t RAM_SIZE_UNIT = 8'192;		// iNES PRG-RAM size unit, and the CHR-RAM size of iNES boards without CHR-ROM
+			static constexpr const size_t RAM_SHIFT_COUNT_BASE = 64;	// NES 2.0 RAM size is "64 << shift count" bytes
+
+			bool				IsValid = false;		// Starts with "NES<EOF>"
+			bool				IsNes2_0 = false;
+			bool				IsCorrected = false;	// Board description comes from the ROM database instead of the header
+			bool				HasTrainer = false;		// 512 bytes between the header and PRG-ROM
+			bool				HasBattery = false;
+			eMirroringType		MirroringType = eMirroringType::HORIZONTAL;
+			eConsoleType		ConsoleType = eConsoleType::NES_FAMICOM;
+			eCpuPpuTimingMode	CpuPpuTimingMode = eCpuPpuTimingMode::RP2C02;
+			uint8_t				SubmapperNumber = 0;
+			uint16_t			MapperNumber = 0;
+			size_t				ProgramRomSize = 0;
+			size_t				CharacterRomSize = 0;
+			size_t				ProgramRamSize = 0;		// Volatile
+			size_t				ProgramNvramSize = 0;	// Battery-backed
+			size_t				CharacterRamSize = 0;
+			size_t				CharacterNvramSize = 0;
+		};
+
+		// NES 2.0 ROM size. An MSB nibble of 0xF switches the LSB to the exponent-multiplier form: 2^E * (M * 2 + 1).
+		inline constexpr size_t GetNes2_0RomSize( const data_t sizeLow, const data_t sizeHigh, const size_t sizeUnit ) noexcept
+		{
+			if ( sizeHigh != 0x0F )
 			{
-			public:
-				static constexpr const size_t SIZE = 16;
-				static constexpr const size_t ID_INDEX = 0;
-				static constexpr const size_t ID_SIZE = 4;
-				static constexpr const size_t PRG_ROM_SIZE_INDEX = ID_INDEX + ID_SIZE;
-				static constexpr const size_t PRG_ROM_SIZE_SIZE = 1;
-				static constexpr const size_t CHARACTER_ROM_SIZE_INDEX = PRG_ROM_SIZE_INDEX + PRG_ROM_SIZE_SIZE;
-				static constexpr const size_t CHARACTER_ROM_SIZE_SIZE = 1;
-				static constexpr const size_t FLAGS06_INDEX = CHARACTER_ROM_SIZE_INDEX + CHARACTER_ROM_SIZE_SIZE;
-				static constexpr const size_t FLAGS06_SIZE = 1;
-				static constexpr const size_t FLAGS07_INDEX = FLAGS06_INDEX + FLAGS06_SIZE;
-				static constexpr const size_t FLAGS07_SIZE = 1;
-				static constexpr const size_t FLAGS08_INDEX = FLAGS07_INDEX + FLAGS07_SIZE;
-				static constexpr const size_t FLAGS08_SIZE = 1;
-				static constexpr const size_t FLAGS09_INDEX = FLAGS08_INDEX + FLAGS08_SIZE;
-				static constexpr const size_t FLAGS09_SIZE = 1;
-				static constexpr const size_t FLAGS10_INDEX = FLAGS09_INDEX + FLAGS09_SIZE;
-				static constexpr const size_t FLAGS10_SIZE = 1;
-				static constexpr const size_t FLAGS11_INDEX = FLAGS10_INDEX + FLAGS10_SIZE;
-				static constexpr const size_t FLAGS11_SIZE = 1;
-				static constexpr const size_t FLAGS12_INDEX = FLAGS11_INDEX + FLAGS11_SIZE;
-				static constexpr const size_t FLAGS12_SIZE = 1;
-				static constexpr const size_t FLAGS13_INDEX = FLAGS12_INDEX + FLAGS12_SIZE;
-				static constexpr const size_t FLAGS13_SIZE = 1;
-				static constexpr const size_t FLAGS14_INDEX = FLAGS13_INDEX + FLAGS13_SIZE;
-				static constexpr const size_t FLAGS14_SIZE = 1;
-				static constexpr const size_t FLAGS15_INDEX = FLAGS14_INDEX + FLAGS14_SIZE;
-				static constexpr const size_t FLAGS15_SIZE = 1;
-				static constexpr const uint8_t NES_2_0_ID = 0b10;
-				static constexpr const char VALID_ID[4] = { 0x4E, 0x45, 0x53, 0x1A };
-
-			public:
-				char Identification[4] = { 0, }; // Identification String. Must be "NES<EOF>".
-				union ProgramRomSize		//	PRG-ROM size LSB
-				{
-					uint8_t Value = 0;	  // Size of PRG ROM in 16 KB units
-					uint8_t ValueLow; // PRG-ROM size LSB
-				} ProgramRomSize;
-				union CharacterRomSize
-				{
-					uint8_t Value = 0;	// Size of CHR ROM in 8 KB units (value 0 means the board uses CHR RAM)
-					uint8_t ValueLow; 	// CHR-ROM size LSB
-				} CharacterRomSize;
-				union Flags06
-				{
-					char Value = 0;
-					struct NESBits
-					{
-						uint8_t MirroringType		: 1;	// Hard-wired nametable mirroring type
-															//	0: Horizontal (vertical arrangement) or mapper-controlled (CIRAM A10 = PPU A11)
-															//	1: Vertical(horizontal arrangement) (CIRAM A10 = PPU A10)
-						bool	Battery				: 1;	// "Battery" and other non-volatile memory
-															//	0: Not present
-															//	1: Present
-															//		Cartridge contains battery-backed PRG RAM ($6000-7FFF) or other persistent memory
-						bool	IsTrainerPresent	: 1;	// 512-byte Trainer
-															//	0: Not present
-															//	1: Present between Header and PRG - ROM data
-															//		512-byte trainer at $7000-$71FF (stored before PRG data)
-						bool	FourScreenMode		: 1;	// Hard-wired four-screen mode
-															// 	0: No
-															//	1: Yes
-						uint8_t MapperD00			: 1;	// Mapper Number D3..D0
-						uint8_t MapperD01			: 1;
-						uint8_t MapperD02			: 1;
-						uint8_t MapperD03			: 1;
-					} Bits;
-				} Flags06;
-				union Flags07
-				{
-					char Value = 0;
-					struct NESBits
-					{
-						eConsoleType	ConsoleType	: 2;	// Console type
-															//	0: Nintendo Entertainment System/Family Computer
-															//	1: Nintendo Vs.System
-															//	2: Nintendo Playchoice 10. (8 KB of Hint Screen data stored after CHR data)
-															//	3: Extended Console Type
-						uint32_t		NES2_0Id	: 2;	// NES 2.0 identifier. If equal to 2, flags 8-15 are in NES 2.0 format
-						uint32_t		MapperD04	: 1;	// Mapper Number D7..D4
-						uint32_t		MapperD05	: 1;
-						uint32_t		MapperD06	: 1;
-						uint32_t		MapperD07	: 1;
-					} Bits;
-				} Flags07;
-				union Flags08
-				{
-					char Value = 0;
-					struct NESBits
-					{
-						uint8_t PrgRamSize; // PRG RAM size
-					} NESBits;
-					struct NES2_0Bits
-					{
-						uint32_t MapperD08			: 1;
-						uint32_t MapperD09			: 1;
-						uint32_t MapperD10			: 1;
-						uint32_t MapperD11			: 1;
-						uint32_t SubmapperNumber	: 4;
-					} NES2_0Bits;
-				} Flags08;
-				union Flags09
-				{
-					char Value = 0;
-					struct NESBits
-					{
-						eTvSystemType	TvSystem : 1;	// 0: NTSC; 1: PAL
-						uint8_t			Reserved : 7;	// PRG RAM size
-					} NESBits;
-					struct NES2_0Bits
-					{
-						uint32_t PrgRomSizeHigh : 4;
-						uint32_t ChrRomSizeHigh : 4;
-					} NES2_0Bits;
-				} Flags09;
-				union Flags10
-				{
-					char Value = 0;
-					struct NESBits
-					{
-					public:
-						tv_system_type_bits_t	TvSystemBits	: 2;
-					private:
-						uint8_t					mPadding0		: 2;
-					public:
-						bool					PrgRam			: 1;
-						bool					HasBusConflict	: 1;
-					private:
-						uint8_t					mPadding1		: 2;
-					} NESBits;
-					struct NES2_0Bits
-					{
-						uint32_t PrgRamShiftCount			: 4;
-						uint32_t PrgNvramEepromShiftCount	: 4;
-					} NES2_0Bits;
-				} Flags10;
-				union Flags11
-				{
-					char Value = 0;
-					struct NES2_0Bits
-					{
-						// If the shift count is zero, there is no CHR-(NV)RAM.
-						// If the shift count is non-zero, the actual size is
-						// "64 << shift count" bytes, i.e. 8192 bytes for a shift count of 7.
-						uint32_t ChrRamShiftCount	: 4;	 // CHR-RAM size (volatile) shift count
-						uint32_t ChrNvramShiftCount : 4; // CHR-NVRAM size (non-volatile) shift count
-					} NES2_0Bits;
-				} Flags11;
-				union Flags12
-				{
-					char Value = 0;
-					struct NES2_0Bits
-					{
-					public:
-						eCpuPpuTimingMode	CpuPpuTimingMode	: 2;
-					private:
-						uint8_t				mPadding			: 6;
-					} NES2_0Bits;
-				} Flags12;
-				union Flags13
+				return ( ( static_cast< size_t >( sizeHigh ) << NUM_BITS_IN_BYTE ) | sizeLow ) * sizeUnit;
+			}
+
+			const size_t exponent = sizeLow >> 2;
+			const size_t multiplier = sizeLow & 0b11;
+			return exponent < 32 ? ( static_cast< size_t >( 1 ) << exponent ) * ( multiplier * 2 + 1 ) : 0;
+		}
+
+		inline constexpr size_t GetNes2_0RamSize( const data_t shiftCount ) noexcept
+		{
+			return shiftCount > 0 ? CartridgeInfo::RAM_SHIFT_COUNT_BASE << shiftCount : 0;
+		}
+
+		// [REF]: https://www.nesdev.org/wiki/INES
+		// [REF]: https://www.nesdev.org/wiki/NES_2.0
+		inline constexpr CartridgeInfo ParseCartridgeInfo( const data_t* headerData ) noexcept
+		{
+			constexpr const data_t IDENTIFICATION[] = { 0x4E, 0x45, 0x53, 0x1A };
+
+			CartridgeInfo info;
+			for ( size_t index = 0; index < ARRAYSIZE( IDENTIFICATION ); ++index )
+			{
+				if ( headerData[index] != IDENTIFICATION[index] )
 				{
-					char Value = 0;
-					struct NES2_0BitsVsSystem
-					{
-						ePpuType		PpuType			: 4;
-						eVsHardwareType	VsHardwareType	: 4;
-					} NES2_0BitsVsSystem;
-					struct NES2_0BitsExtendedConsoleType
-					{
-					public:
-						eExtendedConsoleType	ExtendedConsoleType : 4;
-					private:
-						uint8_t					mPadding			: 4;
-					} NES2_0BitsExtendedConsoleType;
-				} Flags13;
-				union Flags14
+					return info;
+				}
+			}
+
+			const data_t flags06 = headerData[6];
+			const data_t flags07 = headerData[7];
+
+			info.IsValid = true;
+			info.IsNes2_0 = ( flags07 & 0b0000'1100 ) == 0b0000'1000;
+			info.HasTrainer = ( flags06 & 0b0000'0100 ) != 0;
+			info.HasBattery = ( flags06 & 0b0000'0010 ) != 0;
+			info.MirroringType = ( flags06 & 0b0000'1000 ) != 0 ? eMirroringType::FOUR_SCREEN
+				: ( ( flags06 & 0b0000'0001 ) != 0 ? eMirroringType::VERTICAL : eMirroringType::HORIZONTAL );
+			info.ConsoleType = static_cast< eConsoleType >( flags07 & 0b0000'0011 );
+			info.MapperNumber = static_cast< uint16_t >( ( flags06 >> 4 ) | ( flags07 & 0b1111'0000 ) );
+
+			if ( info.IsNes2_0 == false )
+			{
+				info.CpuPpuTimingMode = ( headerData[9] & 0b0000'0001 ) != 0 ? eCpuPpuTimingMode::RP2C07 : eCpuPpuTimingMode::RP2C02;
+				info.ProgramRomSize = headerData[4] * CartridgeInfo::PROGRAM_ROM_SIZE_UNIT;
+				info.CharacterRomSize = headerData[5] * CartridgeInfo::CHARACTER_ROM_SIZE_UNIT;
+
+				// A PRG-RAM size of 0 infers 8 KB for compatibility
+				const size_t programRamSize = ( headerData[8] > 0 ? headerData[8] : 1 ) * CartridgeInfo::RAM_SIZE_UNIT;
+				if ( info.HasBattery )
 				{
-					char Value = 0;
-					struct NES2_0Bits
-					{
-					public:
-						uint8_t NumMiscellaneousRomsPresent : 2;
-					private:
-						uint8_t mPadding					: 6;
-					} NES2_0Bits;
-				} Flags14;
-				union Flags15
+					info.ProgramNvramSize = programRamSize;
+				}
+				else
 				{
-					char Value = 0;
-					struct NES2_0Bits
-					{
-					public:
-						uint8_t DefaultExpansionDevice	: 6;
-					private:
-						uint8_t mPadding				: 2;
-					} NES2_0Bits;
-				} Flags15;
-			};
+					info.ProgramRamSize = programRamSize;
+				}
+				info.CharacterRamSize = info.CharacterRomSize == 0 ? CartridgeInfo::RAM_SIZE_UNIT : 0;
+				return info;
+			}
+
+			const data_t flags08 = headerData[8];
+			const data_t flags09 = headerData[9];
+			const data_t flags10 = headerData[10];
+			const data_t flags11 = headerData[11];
+
+			info.MapperNumber |= static_cast< uint16_t >( ( flags08 & 0b0000'1111 ) << NUM_BITS_IN_BYTE );
+			info.SubmapperNumber = flags08 >> 4;
+			info.CpuPpuTimingMode = static_cast< eCpuPpuTimingMode >( headerData[12] & 0b0000'0011 );
+			info.ProgramRomSize = GetNes2_0RomSize( headerData[4], flags09 & 0b0000'1111, CartridgeInfo::PROGRAM_ROM_SIZE_UNIT );
+			info.CharacterRomSize = GetNes2_0RomSize( headerData[5], flags09 >> 4, CartridgeInfo::CHARACTER_ROM_SIZE_UNIT );
+			info.ProgramRamSize = GetNes2_0RamSize( flags10 & 0b0000'1111 );
+			info.ProgramNvramSize = GetNes2_0RamSize( flags10 >> 4 );
+			info.CharacterRamSize = GetNes2_0RamSize( flags11 & 0b0000'1111 );
+			info.CharacterNvramSize = GetNes2_0RamSize( flags11 >> 4 );
+
+			return info;
+		}
+
+		// Human readable dump for the console. Parsing never prints; callers opt in.
+		void PrintCartridgeInfo( const CartridgeInfo& info ) noexcept;
 
+		// Immutable contents of one .nes file: the mapped image and everything parsed out of it.
+		// It is shared by every Cartridge inserted from the same file, so ROM memory scales with
+		// the number of distinct games rather than the number of consoles.
+		class RomImage final
+		{
+		public:
 			struct Trainer
 			{
 				static constexpr const size_t DATA_SIZE = 512;
@@ -487,107 +435,106 @@ namespace ninmuse
 
 			struct ProgramRom
 			{
-				static constexpr const size_t PROGRAM_SIZE_UNIT = 16'384;
-				union Size
-				{
-					uint16_t Value = 0;
-					struct NESBits
-					{
-					public:
-						uint8_t Size		: 8;
-					private:
-						uint8_t mPadding	: 8;
-					} NESBits;
-					struct NES2_0Bits
-					{
-					public:
-						union SizeLow
-						{
-							uint8_t Value;
-							struct ExponentMultiplier
-							{
-								uint8_t Multiplier	: 2;
-								uint8_t Exponent	: 6;
-							} ExponentMultiplier;
-						} SizeLow;
-						uint8_t SizeHigh	: 4;
-					private:
-						uint8_t mPadding	: 4;
-					} NES2_0Bits;
-				};
-				DynamicArray<data_t>	Data;
+				ArrayView<const data_t>	Data = { nullptr, 0 };	// Points straight into the mapped ROM image
 			};
 
 			struct CharacterRom
 			{
-				static constexpr const size_t PROGRAM_SIZE_UNIT = 8'192;
-				union Size
-				{
-					uint16_t Value = 0;
-					struct NESBits
-					{
-					public:
-						uint8_t Size		: 8;
-					private:
-						uint8_t mPadding	: 8;
-					} NESBits;
-					struct NES2_0Bits
-					{
-					public:
-						union SizeLow
-						{
-							uint8_t Value;
-							struct ExponentMultiplier
-							{
-								uint8_t Multiplier	: 2;
-								uint8_t Exponent	: 6;
-							} ExponentMultiplier;
-						} SizeLow;
-						uint8_t SizeHigh	: 4;
-					private:
-						uint8_t mPadding	: 4;
-					} NES2_0Bits;
-				};
-				DynamicArray<data_t>	Data;
+				ArrayView<const data_t>	Data = { nullptr, 0 };	// Points straight into the mapped ROM image
 			};
 
+		public:
+			RomImage() = delete;
+			RomImage( const RomImage& ) = delete;
+			RomImage( RomImage&& ) = delete;
+			explicit RomImage( const std::filesystem::path& romFilePath ) noexcept;
+			~RomImage() = default;
+
+			RomImage& operator=( const RomImage& ) = delete;
+			RomImage& operator=( RomImage&& ) = delete;
+
+		public:
+			// Returns the image already open for romFilePath, or maps and parses it
+			static std::shared_ptr<const RomImage>	Open( const std::filesystem::path& romFilePath ) noexcept;
+
+			inline bool							IsValid() const noexcept { return mInfo.IsValid && mProgramRom.Data.IsEmpty() == false; }
+			inline const std::filesystem::path&	GetRomFilePath() const noexcept { return mRomFilePath; }
+			inline const MappedFile&			GetFile() const noexcept { return mRomFile; }
+			inline constexpr uint32_t			GetCrc32() const noexcept { return mCrc32; }	// Of everything after the header
+			inline constexpr const CartridgeInfo&
+												GetInfo() const noexcept { return mInfo; }
+			inline const std::optional<Trainer>&
+												GetTrainer() const noexcept { return mTrainer; }
+			inline constexpr const ProgramRom&	GetProgramRom() const noexcept { return mProgramRom; }
+			inline constexpr const CharacterRom&
+												GetCharacterRom() const noexcept { return mCharacterRom; }
+			inline constexpr eTvSystemType		GetTvSystem() const noexcept { return mInfo.CpuPpuTimingMode == eCpuPpuTimingMode::RP2C07 ? eTvSystemType::PAL : eTvSystemType::NTSC; }
+			// Decoded by the first caller, then shared by every cartridge using the image
+			const TileCache&					GetCharacterRomTileCache() const noexcept;
+
+		private:
+			void	read() noexcept;
+
+			// Every section is parsed in place from the mapped image, at an offset derived from the header
+			inline constexpr size_t	getTrainerOffset() const noexcept { return CartridgeInfo::HEADER_SIZE; }
+			inline constexpr size_t	getProgramRomOffset() const noexcept { return getTrainerOffset() + ( mInfo.HasTrainer ? Trainer::DATA_SIZE : 0 ); }
+			inline constexpr size_t	getCharacterRomOffset() const noexcept { return getProgramRomOffset() + mInfo.ProgramRomSize; }
+			const data_t*			getRomData( const size_t offset, const size_t size ) const noexcept;
+
+		private:
+			std::filesystem::path		mRomFilePath;
+			MappedFile					mRomFile;
+			uint32_t					mCrc32;
+			CartridgeInfo				mInfo;
+			std::optional<Trainer>		mTrainer;
+			ProgramRom					mProgramRom;
+			CharacterRom				mCharacterRom;
+			mutable std::once_flag		mCharacterRomTileCacheFlag;
+			mutable TileCache			mCharacterRomTileCache;		// Read-only once built
+		};
+
+		// What one console owns of a cartridge: a reference to the shared RomImage and the save file of its battery-backed RAM.
+		// The RAM itself is part of the console state (CartridgeRamState), so snapshots and clones carry it.
+		class Cartridge final
+		{
+		public:
+			using Trainer		= RomImage::Trainer;
+			using ProgramRom	= RomImage::ProgramRom;
+			using CharacterRom	= RomImage::CharacterRom;
+
 		public:
 			Cartridge() = delete;
 			Cartridge( const Cartridge& ) = delete;
 			Cartridge( Cartridge&& ) = delete;
-			Cartridge( const std::filesystem::path& romFilePath ) noexcept;
-			~Cartridge();
+			explicit Cartridge( std::shared_ptr<const RomImage> romImage ) noexcept;
+			// Battery-backed PRG-RAM lives in saveFilePath. Opt-in, so short-lived consoles never touch the disk.
+			Cartridge( std::shared_ptr<const RomImage> romImage, const std::filesystem::path& saveFilePath ) noexcept;
+			explicit Cartridge( const std::filesystem::path& romFilePath ) noexcept;
+			~Cartridge() = default;
 
 			Cartridge& operator=( const Cartridge& ) = delete;
 			Cartridge& operator=( Cartridge&& ) = delete;
 
 		public:
-			inline constexpr const ProgramRom&
-										GetProgramRom() const noexcept { return mProgramRom; }
+			static inline std::filesystem::path
+										GetDefaultSaveFilePath( const std::filesystem::path& romFilePath ) noexcept { return std::filesystem::path( romFilePath ).replace_extension( ".sav" ); }
 
-			void						Read() noexcept;
-			const Header&				ReadHeader() noexcept;
-			const Trainer&				ReadTrainer() noexcept;
-			const DynamicArray<data_t>&	ReadProgramRom() noexcept;
-			const DynamicArray<data_t>&	ReadCharacterRom() noexcept;
+			inline const std::shared_ptr<const RomImage>&
+										GetRomImage() const noexcept { return mRomImage; }
+			inline const ProgramRom&	GetProgramRom() const noexcept { return mRomImage->GetProgramRom(); }
+			inline const CharacterRom&	GetCharacterRom() const noexcept { return mRomImage->GetCharacterRom(); }
 
-		private:
-			inline bool isNes2_0Format() const noexcept { return mHeader != nullptr && mHeader->Flags07.Bits.NES2_0Id == Header::NES_2_0_ID; }
-			inline bool isTvSystemType( const eTvSystemType tvSystemType ) const noexcept { return mHeader != nullptr && mHeader->Flags09.NESBits.TvSystem == tvSystemType; }
-			inline bool isNtsc() const noexcept { return isTvSystemType( eTvSystemType::NTSC ); }
-			inline bool isPal() const noexcept { return isTvSystemType( eTvSystemType::PAL ); }
-			inline bool isExtendedConsoleType() const noexcept { return mHeader != nullptr && mHeader->Flags07.Bits.ConsoleType == eConsoleType::EXTENDED_CONSOLE_TYPE; }
-			inline bool isVsSystem() const noexcept { return mHeader != nullptr && mHeader->Flags07.Bits.ConsoleType == eConsoleType::NINTENDO_VS_SYSTEM; }
-			size_t getProgramRomSize() const noexcept;
-			size_t getCharacterRomSize() const noexcept;
+			inline bool					HasSaveFile() const noexcept { return mSaveFileOrNull != nullptr; }
+			// Fills the battery-backed part of the console's PRG-RAM; without a save file it is left as it is
+			void						ReadSaveData( data_t* outProgramRam ) const noexcept;
+			// Call at frame boundaries; copies the battery-backed PRG-RAM into the save file mapping and starts writing it back
+			void						FlushSaveData( const data_t* programRam, const bool waitForCompletion ) noexcept;
 
 		private:
-			std::filesystem::path		mRomFilePath;
-			std::ifstream				mRomFile;
-			std::unique_ptr<Header>		mHeader;
-			std::unique_ptr<Trainer>	mTrainer;
-			ProgramRom					mProgramRom;
-			CharacterRom				mCharacterRom;
+			std::shared_ptr<const RomImage>	mRomImage;
+
+			std::unique_ptr<WritableMappedFile>
+											mSaveFileOrNull;
 		};
 	}
 }
\ No newline at end of file
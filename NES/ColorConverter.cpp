@@ -0,0 +1,268 @@
+#include "stdafx.h"
+
+#include "NES/ColorConverter.h"
+#include "NES/DynamicArray.hpp"
+#include "NES/Ppu.h"
+#include "NES/SimdDispatch.h"
+
+namespace ninmuse
+{
+	namespace nes
+	{
+		namespace
+		{
+			constexpr const size_t		NUM_COLOR_CHANNELS		= 3;
+			constexpr const data_t		COLOR_INDEX_MASK		= static_cast<data_t>( ColorConverter::NUM_COLORS - 1 );
+			constexpr const data_t		EMPHASIS_MASK			= static_cast<data_t>( ColorConverter::NUM_EMPHASES - 1 );
+			constexpr const uint32_t	EMPHASIS_ATTENUATION	= 209;	// Out of 256: the 2C02 dims every channel that is not emphasized to about 82%
+
+			// 0xRRGGBB, the palette most emulators have shipped as their default
+			constexpr const uint32_t DEFAULT_PALETTE[ColorConverter::NUM_COLORS] =
+			{
+				0x7C7C7C, 0x0000FC, 0x0000BC, 0x4428BC, 0x940084, 0xA80020, 0xA81000, 0x881400,
+				0x503000, 0x007800, 0x006800, 0x005800, 0x004058, 0x000000, 0x000000, 0x000000,
+				0xBCBCBC, 0x0078F8, 0x0058F8, 0x6844FC, 0xD800CC, 0xE40058, 0xF83800, 0xE45C10,
+				0xAC7C00, 0x00B800, 0x00A800, 0x00A844, 0x008888, 0x000000, 0x000000, 0x000000,
+				0xF8F8F8, 0x3CBCFC, 0x6888FC, 0x9878F8, 0xF878F8, 0xF85898, 0xF87858, 0xFCA044,
+				0xF8B800, 0xB8F818, 0x58D854, 0x58F898, 0x00E8D8, 0x787878, 0x000000, 0x000000,
+				0xFCFCFC, 0xA4E4FC, 0xB8B8F8, 0xD8B8F8, 0xF8B8F8, 0xF8A4C0, 0xF0D0B0, 0xFCE0A8,
+				0xF8D878, 0xD8F878, 0xB8F8B8, 0xB8F8D8, 0x00FCFC, 0xF8D8F8, 0x000000, 0x000000,
+			};
+
+			// Emphasis bit n (PPUMASK bit 5 + n) is red, green, blue
+			inline constexpr uint32_t PackColor( const data_t* channels, const uint32_t emphasis ) noexcept
+			{
+				uint32_t color = 0xFF00'0000u;
+				for ( uint32_t channel = 0; channel < NUM_COLOR_CHANNELS; ++channel )
+				{
+					uint32_t value = channels[channel];
+					if ( ( emphasis & ~( 1u << channel ) ) != 0 )
+					{
+						value = value * EMPHASIS_ATTENUATION / 256;
+					}
+					color |= value << ( channel * NUM_BITS_IN_BYTE );
+				}
+
+				return color;
+			}
+
+			// Every kernel converts a whole frame; a line's colors are the emphasis variant it was drawn with
+			using ConvertFunction = void ( * )( const uint32_t* colors, const data_t* frame, data_t* outPixels ) noexcept;
+
+			struct ColorConverterKernel final
+			{
+				eSimdLevel		SimdLevel;
+				ConvertFunction	ConvertRgba;
+				ConvertFunction	ConvertRgb;
+			};
+
+			inline const uint32_t* GetLineColors( const uint32_t* colors, const data_t* frame, const size_t scanline ) noexcept
+			{
+				return colors + ( frame[Ppu::FRAMEBUFFER_SIZE + scanline] & EMPHASIS_MASK ) * ColorConverter::NUM_COLORS;
+			}
+
+			void ConvertRgbaScalar( const uint32_t* colors, const data_t* frame, data_t* outPixels ) noexcept
+			{
+				for ( size_t scanline = 0; scanline < Ppu::FRAME_HEIGHT; ++scanline )
+				{
+					const uint32_t* lineColors = GetLineColors( colors, frame, scanline );
+					const data_t* line = frame + scanline * Ppu::FRAME_WIDTH;
+					data_t* outLine = outPixels + scanline * Ppu::FRAME_WIDTH * sizeof( uint32_t );
+					for ( size_t x = 0; x < Ppu::FRAME_WIDTH; ++x )
+					{
+						memcpy( outLine + x * sizeof( uint32_t ), lineColors + ( line[x] & COLOR_INDEX_MASK ), sizeof( uint32_t ) );
+					}
+				}
+			}
+
+			void ConvertRgbScalar( const uint32_t* colors, const data_t* frame, data_t* outPixels ) noexcept
+			{
+				for ( size_t scanline = 0; scanline < Ppu::FRAME_HEIGHT; ++scanline )
+				{
+					const uint32_t* lineColors = GetLineColors( colors, frame, scanline );
+					const data_t* line = frame + scanline * Ppu::FRAME_WIDTH;
+					data_t* outLine = outPixels + scanline * Ppu::FRAME_WIDTH * NUM_COLOR_CHANNELS;
+					for ( size_t x = 0; x < Ppu::FRAME_WIDTH; ++x )
+					{
+						memcpy( outLine + x * NUM_COLOR_CHANNELS, lineColors + ( line[x] & COLOR_INDEX_MASK ), NUM_COLOR_CHANNELS );
+					}
+				}
+			}
+
+#if defined(NM_SIMD_X64)
+			// Eight indices widened to 32 bits, then one gather from the line's 64 colors
+			NM_TARGET_AVX2 inline __m256i GatherColorsAvx2( const uint32_t* lineColors, const data_t* pixels ) noexcept
+			{
+				const __m128i indices = _mm_and_si128( _mm_loadl_epi64( reinterpret_cast<const __m128i*>( pixels ) ), _mm_set1_epi8( COLOR_INDEX_MASK ) );
+				return _mm256_i32gather_epi32( reinterpret_cast<const int*>( lineColors ), _mm256_cvtepu8_epi32( indices ), sizeof( uint32_t ) );
+			}
+
+			NM_TARGET_AVX2 void ConvertRgbaAvx2( const uint32_t* colors, const data_t* frame, data_t* outPixels ) noexcept
+			{
+				for ( size_t scanline = 0; scanline < Ppu::FRAME_HEIGHT; ++scanline )
+				{
+					const uint32_t* lineColors = GetLineColors( colors, frame, scanline );
+					const data_t* line = frame + scanline * Ppu::FRAME_WIDTH;
+					data_t* outLine = outPixels + scanline * Ppu::FRAME_WIDTH * sizeof( uint32_t );
+					for ( size_t x = 0; x < Ppu::FRAME_WIDTH; x += 8 )
+					{
+						_mm256_storeu_si256( reinterpret_cast<__m256i*>( outLine + x * sizeof( uint32_t ) ), GatherColorsAvx2( lineColors, line + x ) );
+					}
+				}
+			}
+
+			NM_TARGET_AVX2 void ConvertRgbAvx2( const uint32_t* colors, const data_t* frame, data_t* outPixels ) noexcept
+			{
+				// Alpha is dropped within each lane, then the two 12-byte halves are moved together. Each store runs 8 bytes
+				// past its pixels into the next ones, which are written right after; only the last store of the frame is masked.
+				const __m256i dropAlpha = _mm256_setr_epi8( 0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1,
+															0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1 );
+				const __m256i joinLanes = _mm256_setr_epi32( 0, 1, 2, 4, 5, 6, 3, 7 );
+				const __m256i firstSixDwords = _mm256_setr_epi32( -1, -1, -1, -1, -1, -1, 0, 0 );
+				for ( size_t scanline = 0; scanline < Ppu::FRAME_HEIGHT; ++scanline )
+				{
+					const uint32_t* lineColors = GetLineColors( colors, frame, scanline );
+					const data_t* line = frame + scanline * Ppu::FRAME_WIDTH;
+					data_t* outLine = outPixels + scanline * Ppu::FRAME_WIDTH * NUM_COLOR_CHANNELS;
+					for ( size_t x = 0; x < Ppu::FRAME_WIDTH; x += 8 )
+					{
+						const __m256i rgb = _mm256_permutevar8x32_epi32( _mm256_shuffle_epi8( GatherColorsAvx2( lineColors, line + x ), dropAlpha ), joinLanes );
+						__m256i* out = reinterpret_cast<__m256i*>( outLine + x * NUM_COLOR_CHANNELS );
+						if ( scanline == Ppu::FRAME_HEIGHT - 1 && x == Ppu::FRAME_WIDTH - 8 )
+						{
+							_mm256_maskstore_epi32( reinterpret_cast<int*>( out ), firstSixDwords, rgb );
+						}
+						else
+						{
+							_mm256_storeu_si256( out, rgb );
+						}
+					}
+				}
+			}
+#endif	// defined(NM_SIMD_X64)
+
+			// Widest last. SSE2 has no gather, so it would be the scalar loop again.
+			constexpr const ColorConverterKernel COLOR_CONVERTER_KERNELS[] =
+			{
+				{ eSimdLevel::SCALAR,	ConvertRgbaScalar,	ConvertRgbScalar },
+#if defined(NM_SIMD_X64)
+				{ eSimdLevel::AVX2,		ConvertRgbaAvx2,	ConvertRgbAvx2 },
+#endif	// defined(NM_SIMD_X64)
+			};
+
+			// On every color under every emphasis, in every format
+			bool IsConvertingLikeReference( const ColorConverterKernel& reference, const ColorConverterKernel& kernel ) noexcept
+			{
+				ColorConverter converter;
+				DynamicArray<data_t> frame( Ppu::FRAME_SIZE );
+				frame.SetSize( Ppu::FRAME_SIZE );
+				for ( size_t offset = 0; offset < Ppu::FRAME_SIZE; ++offset )
+				{
+					frame[offset] = static_cast<data_t>( offset * 7 + offset / Ppu::FRAME_WIDTH );
+				}
+
+				for ( size_t format = 0; format < static_cast<size_t>( eColorFormat::COUNT ); ++format )
+				{
+					const size_t outputSize = ColorConverter::GetOutputSize( static_cast<eColorFormat>( format ) );
+					DynamicArray<data_t> expectedPixels( outputSize );
+					DynamicArray<data_t> pixels( outputSize );
+					expectedPixels.SetSize( outputSize );
+					pixels.SetSize( outputSize );
+
+					const bool isRgba = static_cast<eColorFormat>( format ) == eColorFormat::RGBA8;
+					( isRgba ? reference.ConvertRgba : reference.ConvertRgb )( converter.GetColors(), frame.GetData(), expectedPixels.GetData() );
+					( isRgba ? kernel.ConvertRgba : kernel.ConvertRgb )( converter.GetColors(), frame.GetData(), pixels.GetData() );
+					if ( memcmp( pixels.GetData(), expectedPixels.GetData(), outputSize ) != 0 )
+					{
+						return false;
+					}
+				}
+
+				return true;
+			}
+
+			const ColorConverterKernel& GetColorConverterKernel() noexcept
+			{
+				return SelectWidestKernel<COLOR_CONVERTER_KERNELS, IsConvertingLikeReference>();
+			}
+		}
+
+		size_t ColorConverter::GetOutputSize( const eColorFormat format ) noexcept
+		{
+			switch ( format )
+			{
+			case eColorFormat::RGBA8:
+				return Ppu::FRAMEBUFFER_SIZE * sizeof( uint32_t );
+			case eColorFormat::RGB8:
+				return Ppu::FRAMEBUFFER_SIZE * NUM_COLOR_CHANNELS;
+			default:
+				NM_ASSERT( false, "Invalid color format!!" );
+				return 0;
+			}
+		}
+
+		ColorConverter::ColorConverter() noexcept
+			: mColors()
+		{
+			data_t colors[PALETTE_FILE_SIZE];
+			for ( size_t color = 0; color < NUM_COLORS; ++color )
+			{
+				for ( size_t channel = 0; channel < NUM_COLOR_CHANNELS; ++channel )
+				{
+					colors[color * NUM_COLOR_CHANNELS + channel] = static_cast<data_t>( DEFAULT_PALETTE[color] >> ( ( NUM_COLOR_CHANNELS - 1 - channel ) * NUM_BITS_IN_BYTE ) );
+				}
+			}
+
+			const bool isSet = SetPalette( colors, sizeof( colors ) );
+			NM_ASSERT( isSet, "Failed to set the default palette!!" );
+		}
+
+		bool ColorConverter::SetPalette( const data_t* colors, const size_t size ) noexcept
+		{
+			if ( size != PALETTE_FILE_SIZE && size != EMPHASIS_PALETTE_FILE_SIZE )
+			{
+				return false;
+			}
+
+			for ( uint32_t emphasis = 0; emphasis < NUM_EMPHASES; ++emphasis )
+			{
+				for ( size_t color = 0; color < NUM_COLORS; ++color )
+				{
+					// Colors that came with the file are taken as they are
+					if ( size == EMPHASIS_PALETTE_FILE_SIZE )
+					{
+						mColors[emphasis * NUM_COLORS + color] = PackColor( colors + ( emphasis * NUM_COLORS + color ) * NUM_COLOR_CHANNELS, 0 );
+					}
+					else
+					{
+						mColors[emphasis * NUM_COLORS + color] = PackColor( colors + color * NUM_COLOR_CHANNELS, emphasis );
+					}
+				}
+			}
+
+			return true;
+		}
+
+		void ColorConverter::Convert( const data_t* frame, const eColorFormat format, data_t* outPixels ) const noexcept
+		{
+			const ColorConverterKernel& kernel = GetColorConverterKernel();
+			switch ( format )
+			{
+			case eColorFormat::RGBA8:
+				kernel.ConvertRgba( mColors, frame, outPixels );
+				break;
+			case eColorFormat::RGB8:
+				kernel.ConvertRgb( mColors, frame, outPixels );
+				break;
+			default:
+				NM_ASSERT( false, "Invalid color format!!" );
+				break;
+			}
+		}
+
+		eSimdLevel GetColorConverterSimdLevel() noexcept
+		{
+			return GetColorConverterKernel().SimdLevel;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "NES/Common.h"
+#include "NES/SimdDispatch.h"
+
+namespace ninmuse
+{
+	namespace nes
+	{
+		enum class eColorFormat : uint8_t
+		{
+			RGBA8,	// R, G, B, 255 in memory order
+			RGB8,
+			COUNT,
+		};
+
+		// Turns a frame of PPU color indices into RGB, late: only a frontend that shows the picture pays for it, while
+		// hashing, state comparison or ML observations take the indices as they are. The PPU already applied grayscale
+		// to the indices, as the hardware does; emphasis picks one of eight variants of the palette per line.
+		// Every pixel is one lookup in a table of all 512 colors, eight pixels per gather where AVX2 is available.
+		class ColorConverter final
+		{
+		public:
+			static constexpr const size_t	NUM_COLORS					= 64;
+			static constexpr const size_t	NUM_EMPHASES				= 8;
+			static constexpr const size_t	PALETTE_FILE_SIZE			= NUM_COLORS * 3;						// A .pal file: RGB triplets
+			static constexpr const size_t	EMPHASIS_PALETTE_FILE_SIZE	= NUM_EMPHASES * PALETTE_FILE_SIZE;	// With every emphasized variant, in emphasis bit order
+
+			static size_t					GetOutputSize( const eColorFormat format ) noexcept;
+
+		public:
+			// Starts with the built-in palette
+			ColorConverter() noexcept;
+
+		public:
+			// Replaces the palette with the contents of a .pal file. The emphasized colors of a 64-color palette are derived
+			// the way the 2C02 dims the channels that are not emphasized. Fails, keeping the palette, on any other size.
+			bool							SetPalette( const data_t* colors, const size_t size ) noexcept;
+
+			// frame is Ppu::FRAME_SIZE bytes, as Ppu::GetFramebuffer() or Nes::ReadFramebuffer() give it.
+			// outPixels takes GetOutputSize( format ) bytes.
+			void							Convert( const data_t* frame, const eColorFormat format, data_t* outPixels ) const noexcept;
+
+			// NUM_EMPHASES x NUM_COLORS colors, RGBA8 as read little-endian
+			inline const uint32_t*			GetColors() const noexcept { return mColors; }
+
+		private:
+			uint32_t						mColors[NUM_EMPHASES * NUM_COLORS];	// Emphasis major
+		};
+
+		// The widest kernel this CPU runs, picked on first use
+		eSimdLevel	GetColorConverterSimdLevel() noexcept;
+	}
+}
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "stdafx.h"
 
-#include "NES/Cartridge.h"
+#include "NES/Mapper.h"
+#include "NES/Ppu.h"
 #include "NES/Cpu.hpp"
 #include "NES/StaticArray.hpp"
 
@@ -11,8 +12,6 @@ namespace ninmuse
 		// Cycle by Address Mode
 		void Cpu6502::processSingleClock() noexcept
 		{
-			static size_t clock = 1;
-
 			bool fetchData = true;
 			bool saveData = false;
 
@@ -22,19 +21,19 @@ namespace ninmuse
 			bool needsToDecrementStackPointer = false;
 			bool needsToIncrementStackPointer = false;
 
-			const CycleJob& cycleJob = mCycleJobs.front();
+			const CycleJob& cycleJob = mState.CycleJobs.Front();
 
 			// address bus
 			switch ( cycleJob.AddressBusType )
 			{
 			case eAddressBusType::PROGRAM_COUNTER:
-				mAddressBus = mRegisters.ProgramCounter;
+				mState.AddressBus = mState.Registers.ProgramCounter;
 				break;
 			case eAddressBusType::ADDRESS:
-				mAddressBus = mExecutionInfo.Operand.Address;
+				mState.AddressBus = mState.ExecutionInfo.Operand.Address;
 				break;
 			case eAddressBusType::STACK_POINTER:
-				mAddressBus = CreateAddress( mRegisters.StackPointer, STACK_PAGE_ADDRESS_HI );
+				mState.AddressBus = CreateAddress( mState.Registers.StackPointer, STACK_PAGE_ADDRESS_HI );
 				break;
 			default:
 				break;
@@ -52,17 +51,17 @@ namespace ninmuse
 			case eInternalMode::SET_ADDRESS_BUS_ABSOLUTE_MODE:
 				break;
 			case eInternalMode::SET_PROGRAM_COUNTER:
-				mRegisters.ProgramCounter = mExecutionInfo.Operand.Address;
+				mState.Registers.ProgramCounter = mState.ExecutionInfo.Operand.Address;
 				break;
 			case eInternalMode::CHECK_STATUS:
 				needsToCheckBranching = true;
 				break;
 			case eInternalMode::DECREASE_STACK_POINTER:
-				--mRegisters.StackPointer;
+				--mState.Registers.StackPointer;
 				needsToDecrementStackPointer = true;
 				break;
 			case eInternalMode::INCREASE_STACK_POINTER:
-				++mRegisters.StackPointer;
+				++mState.Registers.StackPointer;
 				needsToIncrementStackPointer = true;
 				break;
 			case eInternalMode::PREVIOUS:
@@ -89,7 +88,7 @@ namespace ninmuse
 			if ( needsToCheckBranching )
 			{
 				bool isBranching = false;
-				switch ( mExecutionInfo.InstructionInfoOrNull->Mnemonic )
+				switch ( mState.ExecutionInfo.Decoded.GetMnemonic() )
 				{
 				case eMnemonic::BCC:
 					NM_ASSERT( false, "Unimplemented mnemonic!!" );
@@ -98,7 +97,7 @@ namespace ninmuse
 					NM_ASSERT( false, "Unimplemented mnemonic!!" );
 					break;
 				case eMnemonic::BEQ:
-					isBranching = mRegisters.Status.StatusBits.ZeroFlag;
+					isBranching = mState.Registers.Status.StatusBits.ZeroFlag;
 					break;
 				case eMnemonic::BIT:
 					NM_ASSERT( false, "Unimplemented mnemonic!!" );
@@ -126,8 +125,8 @@ namespace ninmuse
 				if ( isBranching == true )
 				{
 					NM_ASSERT( false, "Unimplemented case!!" );
-					const data_t lowAddress = GetAddressLow( mRegisters.ProgramCounter ) + mExecutionInfo.Operand.Data.Value;
-					if ( lowAddress < mExecutionInfo.Operand.Data.Value )
+					const data_t lowAddress = GetAddressLow( mState.Registers.ProgramCounter ) + mState.ExecutionInfo.Operand.Data.Value;
+					if ( lowAddress < mState.ExecutionInfo.Operand.Data.Value )
 					{
 						__debugbreak();
 					}
@@ -144,10 +143,14 @@ namespace ninmuse
 			case eExternalMode::FETCH_OPCODE:
 			{
 				fetchData = true;
-				mDataBus = ReadRom( mAddressBus );
-				if ( skipFetch == false )
+				mState.DataBus = ReadRom( mState.AddressBus );
+				if ( skipFetch == false && isInterruptPending() )
+				{
+					beginInterrupt();
+				}
+				else if ( skipFetch == false )
 				{
-					mDataToDecode = mDataBus;
+					mState.DataToDecode = mState.DataBus;
 					CycleJob nextCycleJob =
 					{
 						.AddressBusType = eAddressBusType::PROGRAM_COUNTER,
@@ -155,52 +158,52 @@ namespace ninmuse
 						.ExternalOperation = eExternalMode::FETCH_OPCODE,
 						.InternalOperation = eInternalMode::DECODE
 					};
-					mCycleJobs.push( nextCycleJob );
+					mState.CycleJobs.Push( nextCycleJob );
 				}
 			}
 			break;
 			case eExternalMode::FETCH_DATA_FROM_ROM:
 			{
 				fetchData = true;
-				mDataBus = ReadRom( mAddressBus );
-				if ( getRequiredOperandNumBytes( mExecutionInfo.InstructionInfoOrNull->AddressMode ) > 0 )
+				mState.DataBus = ReadRom( mState.AddressBus );
+				if ( mState.ExecutionInfo.Decoded.OperandNumBytes > 0 )
 				{
-					mExecutionInfo.Operand.Data.Value = mDataBus;
+					mState.ExecutionInfo.Operand.Data.Value = mState.DataBus;
 				}
 			}
 			break;
 			case eExternalMode::FETCH_DATA_FROM_RAM:
 			{
 				fetchData = true;
-				mDataBus = Read( mAddressBus );
+				mState.DataBus = ReadBus( mState.AddressBus );
 			}
 			break;
 			case eExternalMode::FETCH_LOW_ADDRESS_FROM_ROM:
 			{
 				fetchData = true;
-				mDataBus = ReadRom( mAddressBus );
-				mExecutionInfo.Operand.Bytes[0] = mDataBus;
+				mState.DataBus = ReadRom( mState.AddressBus );
+				mState.ExecutionInfo.Operand.Bytes[0] = mState.DataBus;
 			}
 			break;
 			case eExternalMode::FETCH_LOW_ADDRESS_FROM_RAM:
 			{
 				fetchData = true;
-				mDataBus = Read( mAddressBus );
-				mExecutionInfo.Operand.Bytes[0] = mDataBus;
+				mState.DataBus = ReadBus( mState.AddressBus );
+				mState.ExecutionInfo.Operand.Bytes[0] = mState.DataBus;
 			}
 			break;
 			case eExternalMode::FETCH_HIGH_ADDRESS_FROM_ROM:
 			{
 				fetchData = true;
-				mDataBus = ReadRom( mAddressBus );
-				mExecutionInfo.Operand.Bytes[1] = mDataBus;
+				mState.DataBus = ReadRom( mState.AddressBus );
+				mState.ExecutionInfo.Operand.Bytes[1] = mState.DataBus;
 			}
 			break;
 			case eExternalMode::FETCH_HIGH_ADDRESS_FROM_RAM:
 			{
 				fetchData = true;
-				mDataBus = Read( mAddressBus );
-				mExecutionInfo.Operand.Bytes[1] = mDataBus;
+				mState.DataBus = ReadBus( mState.AddressBus );
+				mState.ExecutionInfo.Operand.Bytes[1] = mState.DataBus;
 			}
 			break;
 			case eExternalMode::JRS_NONE:
@@ -210,16 +213,39 @@ namespace ninmuse
 			{
 				fetchData = false;
 				saveData = true;
-				mDataBus = GetAddressHigh( mRegisters.ProgramCounter );
-				Write( mAddressBus, mDataBus );
+				mState.DataBus = GetAddressHigh( mState.Registers.ProgramCounter );
+				WriteBus( mState.AddressBus, mState.DataBus );
 			}
 			break;
 			case eExternalMode::SAVE_PROGRAM_COUNTER_LOW_TO_RAM:
 			{
 				fetchData = false;
 				saveData = true;
-				mDataBus = GetAddressLow( mRegisters.ProgramCounter );
-				Write( mAddressBus, mDataBus );
+				mState.DataBus = GetAddressLow( mState.Registers.ProgramCounter );
+				WriteBus( mState.AddressBus, mState.DataBus );
+			}
+			break;
+			case eExternalMode::SAVE_STATUS_TO_RAM_FOR_INTERRUPT:
+			{
+				fetchData = false;
+				saveData = true;
+				// B is only set in the copy BRK and PHP push
+				decltype( mState.Registers.Status ) status = mState.Registers.Status;
+				status.StatusBits.BreakCommandFlag = false;
+				status.StatusBits.Padding = true;
+				mState.DataBus = status.Value;
+				WriteBus( mState.AddressBus, mState.DataBus );
+				mState.Registers.Status.StatusBits.InterruptDisableFlag = true;
+				mState.Registers.ProgramCounter = mState.ExecutionInfo.Operand.Address;
+			}
+			break;
+			case eExternalMode::FETCH_STATUS_FROM_RAM:
+			{
+				fetchData = true;
+				mState.DataBus = ReadBus( mState.AddressBus );
+				// B and bit 5 are not flags the CPU keeps
+				static constexpr const data_t PUSHED_ONLY_BITS = 0x30;
+				mState.Registers.Status.Value = static_cast< data_t >( ( mState.DataBus & ~PUSHED_ONLY_BITS ) | ( mState.Registers.Status.Value & PUSHED_ONLY_BITS ) );
 			}
 			break;
 			case eExternalMode::RTS_NONE:
@@ -234,28 +260,28 @@ namespace ninmuse
 
 			if ( cycleJob.IncrementProgramCounter )
 			{
-				++mRegisters.ProgramCounter;
+				++mState.Registers.ProgramCounter;
 			}
 
-			std::cout << std::setw( 8 ) << std::left << clock;
-			std::cout << std::setw( 16 ) << std::left << std::hex << mAddressBus;
+			std::cout << std::setw( 8 ) << std::left << mState.Clock;
+			std::cout << std::setw( 16 ) << std::left << std::hex << mState.AddressBus;
 			std::cout << std::setw( 16 ) << std::left << std::boolalpha << cycleJob.IncrementProgramCounter;
-			std::cout << std::setw( 16 ) << std::left << std::hex << static_cast< uint32_t >( mDataBus );
+			std::cout << std::setw( 16 ) << std::left << std::hex << static_cast< uint32_t >( mState.DataBus );
 			if ( fetchData )
 			{
-				std::cout << "Fetch " << std::setw( 18 ) << std::left << static_cast< uint32_t >( mDataBus );
+				std::cout << "Fetch " << std::setw( 18 ) << std::left << static_cast< uint32_t >( mState.DataBus );
 			}
 			else if ( saveData )
 			{
-				std::cout << "Save " << std::setw( 19 ) << std::left << static_cast< uint32_t >( mDataBus );
+				std::cout << "Save " << std::setw( 19 ) << std::left << static_cast< uint32_t >( mState.DataBus );
 			}
 			if ( needsToDecode )
 			{
-				std::cout << "Decoding " << std::hex << static_cast< uint32_t >( mDataToDecode );
+				std::cout << "Decoding " << std::hex << static_cast< uint32_t >( mState.DataToDecode );
 			}
 			else if ( needsToExecute )
 			{
-				std::cout << "Executing " << mExecutionInfo.InstructionInfoOrNull->Name << " " << convertAddressModeToString( mExecutionInfo.InstructionInfoOrNull->AddressMode );
+				std::cout << "Executing " << getMnemonicName( mState.ExecutionInfo.Decoded.GetMnemonic() ) << " " << convertAddressModeToString( mState.ExecutionInfo.Decoded.GetAddressMode() );
 			}
 			else if ( needsToDecrementStackPointer )
 			{
@@ -267,66 +293,66 @@ namespace ninmuse
 			}
 			std::cout << std::endl;
 
-			mCycleJobs.pop();
+			mState.CycleJobs.Pop();
 #if 0
-			address_t		nextAddressBus = mAddressBus;
-			eInternalMode	nextInternalMode = mCurrentInternalMode;
-			eExternalMode	nextExternalMode = mCurrentExternalMode;
+			address_t		nextAddressBus = mState.AddressBus;
+			eInternalMode	nextInternalMode = mState.CurrentInternalMode;
+			eExternalMode	nextExternalMode = mState.CurrentExternalMode;
 			bool			nextReadRam = false;
 
 			// Fetch
-			mDataBus = mReadRam ? Read( mAddressBus ) : ReadRom( mAddressBus );
+			mState.DataBus = mState.ReadRam ? Read( mState.AddressBus ) : ReadRom( mState.AddressBus );
 			bool needsToIncrementProgramCounter = false;
 			bool setProgramCounterToAddressBus = true;
 			bool setStackPointerToAddressBus = false;
 
 			// should I decode something?
 			bool skipFetch = false;
-			const data_t decodedData = mDataToDecode;
-			switch ( mCurrentExternalMode )
+			const data_t decodedData = mState.DataToDecode;
+			switch ( mState.CurrentExternalMode )
 			{
 			case eExternalMode::DECODE:
 			{
 				// read instruction
-				const data_t opcode = mDataToDecode;
-				mExecutionInfo.InstructionInfoOrNull = INSTRUCTION_TABLE[opcode];
-				NM_ASSERT( mExecutionInfo.InstructionInfoOrNull != nullptr, "Invalid opcode!!" );
+				const data_t opcode = mState.DataToDecode;
+				mState.ExecutionInfo.Decoded = DECODE_TABLE[opcode];
+				NM_ASSERT( mState.ExecutionInfo.Decoded.IsValid(), "Invalid opcode!!" );
 
-				switch ( mExecutionInfo.InstructionInfoOrNull->AddressMode )
+				switch ( mState.ExecutionInfo.Decoded.GetAddressMode() )
 				{
 				case eAddressMode::ACCUMULATOR:
 					skipFetch = true;
-					mCurrentInternalMode = eInternalMode::NEXT;
+					mState.CurrentInternalMode = eInternalMode::NEXT;
 					nextInternalMode = eInternalMode::FETCH_OPCODE;
 					nextExternalMode = eExternalMode::EXECUTE;
 					break;
 				case eAddressMode::IMMEDIATE:
-					mCurrentInternalMode = eInternalMode::FETCH_DATA_FROM_ROM;
+					mState.CurrentInternalMode = eInternalMode::FETCH_DATA_FROM_ROM;
 					nextExternalMode = eExternalMode::EXECUTE;
-					mExecutionInfo.Operand.Data.Value = mDataBus;
+					mState.ExecutionInfo.Operand.Data.Value = mState.DataBus;
 					break;
 				case eAddressMode::ABSOLUTE:
-					if ( mExecutionInfo.InstructionInfoOrNull != &Instruction::Jsr::ABSOLUTE )
+					if ( mState.ExecutionInfo.Decoded.GetMnemonic() != eMnemonic::JSR )
 					{
-						mCurrentInternalMode = eInternalMode::FETCH_LOW_ADDRESS_FROM_ROM;
+						mState.CurrentInternalMode = eInternalMode::FETCH_LOW_ADDRESS_FROM_ROM;
 						nextInternalMode = eInternalMode::FETCH_HIGH_ADDRESS_FROM_ROM;
 						nextExternalMode = eExternalMode::NONE;
 					}
 					else
 					{
-						mCurrentInternalMode = eInternalMode::FETCH_LOW_ADDRESS_FROM_ROM;
+						mState.CurrentInternalMode = eInternalMode::FETCH_LOW_ADDRESS_FROM_ROM;
 						nextInternalMode = eInternalMode::JRS_NONE;
 						nextExternalMode = eExternalMode::NONE;
 						setProgramCounterToAddressBus = false;
 						setStackPointerToAddressBus = true;
-						nextAddressBus = CreateAddress( mRegisters.StackPointer, STACK_PAGE_ADDRESS_HI );
+						nextAddressBus = CreateAddress( mState.Registers.StackPointer, STACK_PAGE_ADDRESS_HI );
 					}
 					break;
 				case eAddressMode::ZERO_PAGE:
 					NM_ASSERT( false, "Unimplemented address mode!!" );
 					break;
 				case eAddressMode::IMPLIED:
-					if ( mExecutionInfo.InstructionInfoOrNull->Mnemonic == eMnemonic::RTS )
+					if ( mState.ExecutionInfo.Decoded.GetMnemonic() == eMnemonic::RTS )
 					{
 						skipFetch = true;
 						needsToIncrementProgramCounter = true;
@@ -341,7 +367,7 @@ namespace ninmuse
 					}
 					break;
 				case eAddressMode::RELATIVE:
-					mCurrentInternalMode = eInternalMode::FETCH_DATA_FROM_ROM;
+					mState.CurrentInternalMode = eInternalMode::FETCH_DATA_FROM_ROM;
 					nextExternalMode = eExternalMode::EXECUTE;
 					break;
 				case eAddressMode::ABSOLUTE_INDIRECT:
@@ -377,21 +403,21 @@ namespace ninmuse
 				execute();
 				break;
 			case eExternalMode::DECREASE_STACK_POINTER:
-				--mRegisters.StackPointer;
-				if ( mCurrentInternalMode == eInternalMode::JRS_SAVE_ADDRESS_HIGH_TO_STACK )
+				--mState.Registers.StackPointer;
+				if ( mState.CurrentInternalMode == eInternalMode::JRS_SAVE_ADDRESS_HIGH_TO_STACK )
 				{
 					nextInternalMode = eInternalMode::JRS_SAVE_ADDRESS_LOW_TO_STACK;
 					nextExternalMode = eExternalMode::DECREASE_STACK_POINTER;
 				}
-				else if ( mCurrentInternalMode == eInternalMode::JRS_SAVE_ADDRESS_LOW_TO_STACK )
+				else if ( mState.CurrentInternalMode == eInternalMode::JRS_SAVE_ADDRESS_LOW_TO_STACK )
 				{
 					nextInternalMode = eInternalMode::FETCH_HIGH_ADDRESS_FROM_ROM;
 					nextExternalMode = eExternalMode::NONE;
 				}
 				break;
 			case eExternalMode::INCREASE_STACK_POINTER:
-				++mRegisters.StackPointer;
-				if ( mCurrentInternalMode == eInternalMode::FETCH_LOW_ADDRESS_FROM_RAM )
+				++mState.Registers.StackPointer;
+				if ( mState.CurrentInternalMode == eInternalMode::FETCH_LOW_ADDRESS_FROM_RAM )
 				{
 					needsToIncrementProgramCounter = false;
 					setProgramCounterToAddressBus = false;
@@ -413,7 +439,7 @@ namespace ninmuse
 				break;
 			case eExternalMode::NONE:
 			{
-				switch ( mExecutionInfo.InstructionInfoOrNull->AddressMode )
+				switch ( mState.ExecutionInfo.Decoded.GetAddressMode() )
 				{
 				case eAddressMode::ACCUMULATOR:
 					NM_ASSERT( false, "Unimplemented address mode!!" );
@@ -422,9 +448,9 @@ namespace ninmuse
 					NM_ASSERT( false, "Unimplemented address mode!!" );
 					break;
 				case eAddressMode::ABSOLUTE:
-					if ( mCurrentInternalMode == eInternalMode::FETCH_HIGH_ADDRESS_FROM_ROM )
+					if ( mState.CurrentInternalMode == eInternalMode::FETCH_HIGH_ADDRESS_FROM_ROM )
 					{
-						if ( mExecutionInfo.InstructionInfoOrNull->Mnemonic == eMnemonic::JSR )
+						if ( mState.ExecutionInfo.Decoded.GetMnemonic() == eMnemonic::JSR )
 						{
 							nextInternalMode = eInternalMode::FETCH_OPCODE;
 							nextExternalMode = eExternalMode::EXECUTE;
@@ -436,12 +462,12 @@ namespace ninmuse
 							nextReadRam = true;
 						}
 					}
-					else if ( mCurrentInternalMode == eInternalMode::FETCH_DATA_FROM_RAM )
+					else if ( mState.CurrentInternalMode == eInternalMode::FETCH_DATA_FROM_RAM )
 					{
 						nextInternalMode = eInternalMode::FETCH_OPCODE;
 						nextExternalMode = eExternalMode::EXECUTE;
 					}
-					else if ( mCurrentInternalMode == eInternalMode::JRS_NONE )
+					else if ( mState.CurrentInternalMode == eInternalMode::JRS_NONE )
 					{
 						nextInternalMode = eInternalMode::JRS_SAVE_ADDRESS_HIGH_TO_STACK;
 						nextExternalMode = eExternalMode::DECREASE_STACK_POINTER;
@@ -494,18 +520,18 @@ namespace ninmuse
 			if ( skipFetch == false )
 			{
 				needsToIncrementProgramCounter = nextInternalMode != eInternalMode::FETCH_DATA_FROM_RAM;
-				switch ( mCurrentInternalMode )
+				switch ( mState.CurrentInternalMode )
 				{
 				case eInternalMode::FETCH_OPCODE:
-					mDataToDecode = mDataBus;
+					mState.DataToDecode = mState.DataBus;
 					nextExternalMode = eExternalMode::DECODE;
 					break;
 				case eInternalMode::FETCH_DATA_FROM_ROM:
-					mExecutionInfo.Operand.Data.Value = mDataBus;
+					mState.ExecutionInfo.Operand.Data.Value = mState.DataBus;
 					break;
 				case eInternalMode::FETCH_DATA_FROM_RAM:
-					if ( mExecutionInfo.InstructionInfoOrNull->Mnemonic == eMnemonic::STA
-						|| mExecutionInfo.InstructionInfoOrNull->Mnemonic == eMnemonic::LDA )
+					if ( mState.ExecutionInfo.Decoded.GetMnemonic() == eMnemonic::STA
+						|| mState.ExecutionInfo.Decoded.GetMnemonic() == eMnemonic::LDA )
 					{
 						nextInternalMode = eInternalMode::FETCH_OPCODE;
 					}
@@ -515,24 +541,24 @@ namespace ninmuse
 					}
 					break;
 				case eInternalMode::FETCH_LOW_ADDRESS_FROM_ROM:
-					mExecutionInfo.Operand.Bytes[0] = mDataBus;
-					if ( mExecutionInfo.InstructionInfoOrNull->Mnemonic == eMnemonic::JSR )
+					mState.ExecutionInfo.Operand.Bytes[0] = mState.DataBus;
+					if ( mState.ExecutionInfo.Decoded.GetMnemonic() == eMnemonic::JSR )
 					{
-						mDataToDecode = mDataBus;
+						mState.DataToDecode = mState.DataBus;
 					}
 					break;
 				case eInternalMode::FETCH_LOW_ADDRESS_FROM_RAM:
-					mExecutionInfo.Operand.Bytes[0] = mDataBus;
-					if ( mExecutionInfo.InstructionInfoOrNull->Mnemonic == eMnemonic::RTS )
+					mState.ExecutionInfo.Operand.Bytes[0] = mState.DataBus;
+					if ( mState.ExecutionInfo.Decoded.GetMnemonic() == eMnemonic::RTS )
 					{
 						needsToIncrementProgramCounter = false;
 					}
 					break;
 				case eInternalMode::FETCH_HIGH_ADDRESS_FROM_ROM:
-					mExecutionInfo.Operand.Bytes[1] = mDataBus;
-					if ( mExecutionInfo.InstructionInfoOrNull->Mnemonic == eMnemonic::JSR )
+					mState.ExecutionInfo.Operand.Bytes[1] = mState.DataBus;
+					if ( mState.ExecutionInfo.Decoded.GetMnemonic() == eMnemonic::JSR )
 					{
-						mRegisters.ProgramCounter = CreateAddress( mDataToDecode, mDataBus );
+						mState.Registers.ProgramCounter = CreateAddress( mState.DataToDecode, mState.DataBus );
 						needsToIncrementProgramCounter = false;
 						setProgramCounterToAddressBus = true;
 						setStackPointerToAddressBus = false;
@@ -550,15 +576,15 @@ namespace ninmuse
 					needsToIncrementProgramCounter = false;
 					setProgramCounterToAddressBus = false;
 					setStackPointerToAddressBus = true;
-					mDataBus = GetAddressHigh( mRegisters.ProgramCounter );
-					Write( CreateAddress( mRegisters.StackPointer, STACK_PAGE_ADDRESS_HI ), mDataBus );
+					mState.DataBus = GetAddressHigh( mState.Registers.ProgramCounter );
+					Write( CreateAddress( mState.Registers.StackPointer, STACK_PAGE_ADDRESS_HI ), mState.DataBus );
 					break;
 				case eInternalMode::JRS_SAVE_ADDRESS_LOW_TO_STACK:
 					needsToIncrementProgramCounter = false;
 					setProgramCounterToAddressBus = true;
 					setStackPointerToAddressBus = false;
-					mDataBus = GetAddressLow( mRegisters.ProgramCounter );
-					Write( CreateAddress( mRegisters.StackPointer, STACK_PAGE_ADDRESS_HI ), mDataBus );
+					mState.DataBus = GetAddressLow( mState.Registers.ProgramCounter );
+					Write( CreateAddress( mState.Registers.StackPointer, STACK_PAGE_ADDRESS_HI ), mState.DataBus );
 					break;
 				case eInternalMode::RTS_NONE:
 					needsToIncrementProgramCounter = false;
@@ -575,7 +601,7 @@ namespace ninmuse
 				//switch ( mCurrentReadMode )
 				//{
 				//case eReadMode::FETCH_OPCODE:
-				//	mDataToDecode = mDataBus;
+				//	mState.DataToDecode = mState.DataBus;
 				//	nextExternalMode = eInternalMode::DECODE;
 				//	break;
 				//case eReadMode::DATA:
@@ -595,91 +621,91 @@ namespace ninmuse
 
 			if ( needsToIncrementProgramCounter )
 			{
-				++mRegisters.ProgramCounter;
+				++mState.Registers.ProgramCounter;
 			}
 			if ( nextInternalMode == eInternalMode::FETCH_DATA_FROM_RAM )
 			{
 				setProgramCounterToAddressBus = false;
 				setStackPointerToAddressBus = false;
-				nextAddressBus = mExecutionInfo.Operand.Address;
+				nextAddressBus = mState.ExecutionInfo.Operand.Address;
 				nextReadRam = true;
 			}
 
 			if ( setProgramCounterToAddressBus )
 			{
-				nextAddressBus = mRegisters.ProgramCounter;
+				nextAddressBus = mState.Registers.ProgramCounter;
 			}
 			else if ( setStackPointerToAddressBus )
 			{
 				nextReadRam = true;
-				nextAddressBus = CreateAddress( mRegisters.StackPointer, STACK_PAGE_ADDRESS_HI );
+				nextAddressBus = CreateAddress( mState.Registers.StackPointer, STACK_PAGE_ADDRESS_HI );
 			}
 
-			std::cout << std::setw( 8 ) << std::left << clock;
-			std::cout << std::setw( 16 ) << std::left << std::hex << mAddressBus;
+			std::cout << std::setw( 8 ) << std::left << mState.Clock;
+			std::cout << std::setw( 16 ) << std::left << std::hex << mState.AddressBus;
 			std::cout << std::setw( 16 ) << std::left << std::boolalpha << needsToIncrementProgramCounter;
-			std::cout << std::setw( 16 ) << std::left << std::hex << static_cast< uint32_t >( mDataBus );
-			if ( mCurrentInternalMode < eInternalMode::FETCH_HIGH_ADDRESS_FROM_RAM )
+			std::cout << std::setw( 16 ) << std::left << std::hex << static_cast< uint32_t >( mState.DataBus );
+			if ( mState.CurrentInternalMode < eInternalMode::FETCH_HIGH_ADDRESS_FROM_RAM )
 			{
-				std::cout << "Fetch " << std::setw( 18 ) << std::left << static_cast< uint32_t >( mDataBus );
+				std::cout << "Fetch " << std::setw( 18 ) << std::left << static_cast< uint32_t >( mState.DataBus );
 			}
-			else if ( mCurrentInternalMode == eInternalMode::JRS_SAVE_ADDRESS_HIGH_TO_STACK ||
-				mCurrentInternalMode == eInternalMode::JRS_SAVE_ADDRESS_LOW_TO_STACK )
+			else if ( mState.CurrentInternalMode == eInternalMode::JRS_SAVE_ADDRESS_HIGH_TO_STACK ||
+				mState.CurrentInternalMode == eInternalMode::JRS_SAVE_ADDRESS_LOW_TO_STACK )
 			{
-				std::cout << "Save " << std::setw( 18 ) << std::left << static_cast< uint32_t >( mDataBus );
+				std::cout << "Save " << std::setw( 18 ) << std::left << static_cast< uint32_t >( mState.DataBus );
 			}
-			if ( mCurrentExternalMode == eExternalMode::DECODE )
+			if ( mState.CurrentExternalMode == eExternalMode::DECODE )
 			{
 				std::cout << "Decoding " << std::hex << static_cast< uint32_t >( decodedData );
 			}
-			else if ( mCurrentExternalMode == eExternalMode::EXECUTE )
+			else if ( mState.CurrentExternalMode == eExternalMode::EXECUTE )
 			{
-				std::cout << "Executing " << mExecutionInfo.InstructionInfoOrNull->Name;
+				std::cout << "Executing " << getMnemonicName( mState.ExecutionInfo.Decoded.GetMnemonic() );
 			}
 			std::cout << std::endl;
 
-			mAddressBus = nextAddressBus;
-			mCurrentInternalMode = nextInternalMode;
-			mCurrentExternalMode = nextExternalMode;
-			mReadRam = nextReadRam;
+			mState.AddressBus = nextAddressBus;
+			mState.CurrentInternalMode = nextInternalMode;
+			mState.CurrentExternalMode = nextExternalMode;
+			mState.ReadRam = nextReadRam;
 #endif
 			/*
-			bool needsExecuting = mExecutionInfo.IsReady == true;
+			bool needsExecuting = mState.ExecutionInfo.IsReady == true;
 			const bool needsDecoding = mDataToDecodeOrNull != nullptr && mCurrentReadMode == eReadMode::FETCH_OPCODE && needsExecuting == false;
 
 			// Clock
-			std::cout << std::setw( 8 ) << std::left << clock;
+			std::cout << std::setw( 8 ) << std::left << mState.Clock;
 
 			// Fetch
-			if ( mReadRam == false )
+			if ( mState.ReadRam == false )
 			{
-				mAddressBus = mRegisters.ProgramCounter;
+				mState.AddressBus = mState.Registers.ProgramCounter;
 			}
-			const data_t& data = mReadRam ? Read( mAddressBus ) : ReadRom( mAddressBus );
-			const bool readFromRam = mReadRam;
-			mReadRam = false;
+			const data_t& data = mState.ReadRam ? Read( mState.AddressBus ) : ReadRom( mState.AddressBus );
+			const bool readFromRam = mState.ReadRam;
+			mState.ReadRam = false;
 
-			std::cout << std::setw( 16 ) << std::left << std::hex << mAddressBus;
+			std::cout << std::setw( 16 ) << std::left << std::hex << mState.AddressBus;
 
 			// Decode
 			if ( needsDecoding )
 			{
 				// read instruction
-				const data_t opcode = mDataBus;
-				mExecutionInfo.InstructionInfoOrNull = INSTRUCTION_TABLE[opcode];
-				NM_ASSERT( mExecutionInfo.InstructionInfoOrNull != nullptr, "Invalid opcode!!" );
+				const data_t opcode = mState.DataBus;
+				mState.ExecutionInfo.Decoded = DECODE_TABLE[opcode];
+				NM_ASSERT( mState.ExecutionInfo.Decoded.IsValid(), "Invalid opcode!!" );
 
-				mDecodeCounter = 0;
+				mState.DecodeCounter = 0;
 
-				if ( getRequiredOperandNumBytes( mExecutionInfo.InstructionInfoOrNull->AddressMode ) > 0 )
+				if ( mState.ExecutionInfo.Decoded.OperandNumBytes > 0 )
 				{
 					mCurrentReadMode = eReadMode::DATA;
 				}
 
-				if ( mExecutionInfo.InstructionInfoOrNull == &Instruction::Jsr::ABSOLUTE )
+				if ( mState.ExecutionInfo.Decoded.GetMnemonic() == eMnemonic::JSR )
 				{
-					mReadRam = true;
-					mExecutionInfo.Operand.Address = CreateAddress( data, 0x01 );
+					mState.ReadRam = true;
+					mState.ExecutionInfo.Operand.Address = CreateAddress( data, 0x01 );
 				}
 
 				mDataToDecodeOrNull = nullptr;
@@ -687,18 +713,18 @@ namespace ninmuse
 			else if ( mCurrentReadMode == eReadMode::DATA )
 			{
 				// read operand
-				const data_t operand = mDataBus;
-				mExecutionInfo.Operand.Bytes[0] = operand;
-				if ( getRequiredOperandNumBytes( mExecutionInfo.InstructionInfoOrNull->AddressMode ) > 1 )
+				const data_t operand = mState.DataBus;
+				mState.ExecutionInfo.Operand.Bytes[0] = operand;
+				if ( mState.ExecutionInfo.Decoded.OperandNumBytes > 1 )
 				{
-					mExecutionInfo.Operand.Bytes[1] = data;
+					mState.ExecutionInfo.Operand.Bytes[1] = data;
 				}
-				++mDecodeCounter;
+				++mState.DecodeCounter;
 			}
 
-			if ( mExecutionInfo.InstructionInfoOrNull != nullptr && mDecodeCounter == getRequiredOperandNumBytes( mExecutionInfo.InstructionInfoOrNull->AddressMode ) - 1)
+			if ( mState.ExecutionInfo.Decoded.IsValid() && mState.DecodeCounter == mState.ExecutionInfo.Decoded.OperandNumBytes - 1)
 			{
-				switch ( mExecutionInfo.InstructionInfoOrNull->AddressMode )
+				switch ( mState.ExecutionInfo.Decoded.GetAddressMode() )
 				{
 				case eAddressMode::ACCUMULATOR:
 					break;
@@ -725,7 +751,7 @@ namespace ninmuse
 				case eAddressMode::ZERO_PAGE_INDEXED_INDIRECT:
 					[[fallthrough]];
 				case eAddressMode::ZERO_PAGE_INDIRECT_INDEXED_WITH_Y:
-					switch ( mExecutionInfo.InstructionInfoOrNull->Mnemonic )
+					switch ( mState.ExecutionInfo.Decoded.GetMnemonic() )
 					{
 					case eMnemonic::JSR:
 						break;
@@ -734,7 +760,7 @@ namespace ninmuse
 					case eMnemonic::STX:
 						[[fallthrough]];
 					case eMnemonic::STY:
-						mReadRam = true;
+						mState.ReadRam = true;
 						break;
 					case eMnemonic::COUNT:
 					default:
@@ -747,25 +773,25 @@ namespace ninmuse
 				default:
 					break;
 				}
-				mExecutionInfo.IsReady = true;
+				mState.ExecutionInfo.IsReady = true;
 				mCurrentReadMode = eReadMode::FETCH_OPCODE;
 				needsExecuting = needsDecoding == false;
 			}
 
-			const bool increaseProgramCounter = readFromRam == false && ( needsDecoding == false || ( mExecutionInfo.InstructionInfoOrNull != nullptr && mDecodeCounter == 0 ) || needsExecuting == true );
+			const bool increaseProgramCounter = readFromRam == false && ( needsDecoding == false || ( mState.ExecutionInfo.Decoded.IsValid() && mState.DecodeCounter == 0 ) || needsExecuting == true );
 			if ( increaseProgramCounter )
-				++mRegisters.ProgramCounter;
+				++mState.Registers.ProgramCounter;
 
 			std::cout << std::setw( 16 ) << std::left << std::boolalpha << increaseProgramCounter;
 			std::cout << std::setw( 16 ) << std::left << std::hex << static_cast<uint32_t>( data );
 			std::cout << "Fetch " << std::setw( 18 ) << std::left << static_cast< uint32_t >( data );
 			if ( needsDecoding )
 			{
-				std::cout << "Decoding " << std::hex << static_cast<uint32_t>( mDataBus );
+				std::cout << "Decoding " << std::hex << static_cast<uint32_t>( mState.DataBus );
 			}
 			else if ( needsExecuting )
 			{
-				std::cout << "Executing " << mExecutionInfo.InstructionInfoOrNull->Name;
+				std::cout << "Executing " << getMnemonicName( mState.ExecutionInfo.Decoded.GetMnemonic() );
 			}
 			std::cout << std::endl;
 
@@ -775,7 +801,7 @@ namespace ninmuse
 				const bool isExecutionComplete = execute();
 				if ( isExecutionComplete )
 				{
-					mExecutionInfo.Reset();
+					mState.ExecutionInfo.Reset();
 				}
 			}
 
@@ -783,33 +809,104 @@ namespace ninmuse
 			{
 				mDataToDecodeOrNull = &data;
 			}
-			mDataBus = data;
+			mState.DataBus = data;
 			*/
-			++clock;
+			++mState.Clock;
 		}
 
 		data_t Cpu6502::ReadRom( const address_t& address ) const noexcept
 		{
-			const DynamicArray<data_t>& programRomData = mRomOrNull->GetProgramRom().Data;
-			NM_ASSERT( address < programRomData.GetSize(), "Invalid address!!");
-			const data_t data = programRomData[address];
+			NM_ASSERT( address >= Mapper::PROGRAM_RAM_ADDRESS, "Invalid address!!");
+			const data_t data = mMapperOrNull->ReadProgram( address );
 			return data;
 		}
 
+		data_t Cpu6502::ReadBus( const address_t& address ) noexcept
+		{
+			if ( address >= Mapper::PROGRAM_RAM_ADDRESS )
+			{
+				return ReadRom( address );
+			}
+
+			if ( address >= PpuRegisterMap::Control && address < PpuRegisterMap::RegistersEnd && mPpuOrNull != nullptr )
+			{
+				mPpuOrNull->CatchUp();
+				return mPpuOrNull->ReadRegister( address );
+			}
+
+			return Read( address );
+		}
+
+		void Cpu6502::WriteBus( const address_t& address, const data_t& data ) noexcept
+		{
+			if ( address >= Mapper::PROGRAM_RAM_ADDRESS )
+			{
+				// Mapper registers switch the CHR banks and mirroring the PPU renders with, and move the IRQ
+				const bool isMapperRegister = address >= Mapper::PROGRAM_ROM_ADDRESS && mPpuOrNull != nullptr;
+				if ( isMapperRegister )
+				{
+					mPpuOrNull->CatchUp();
+				}
+				mMapperOrNull->WriteProgram( address, data );
+				if ( isMapperRegister )
+				{
+					mPpuOrNull->OnMapperRegisterWritten( address, data );
+				}
+				return;
+			}
+
+			if ( mPpuOrNull != nullptr )
+			{
+				if ( address >= PpuRegisterMap::Control && address < PpuRegisterMap::RegistersEnd )
+				{
+					mPpuOrNull->CatchUp();
+					mPpuOrNull->WriteRegister( address, data );
+					return;
+				}
+
+				if ( address == PpuRegisterMap::OamDma )
+				{
+					// The page is copied as the CPU would read it, one byte at a time
+					data_t page[PpuState::OAM_SIZE];
+					const address_t pageAddress = static_cast< address_t >( data << 8 );
+					for ( address_t offset = 0; offset < PpuState::OAM_SIZE; ++offset )
+					{
+						page[offset] = ReadBus( pageAddress + offset );
+					}
+					mPpuOrNull->CatchUp();
+					mPpuOrNull->WriteOam( page );
+					return;
+				}
+			}
+
+			Write( address, data );
+		}
+
 		void Cpu6502::Run() noexcept
 		{
-			const Cartridge::ProgramRom& programRom = mRomOrNull->GetProgramRom();
-			const data_t addressLow = programRom.Data[0xFFFC];
-			const data_t addressHigh = programRom.Data[0xFFFD];
+			PowerUp();
+			while ( true )
+			{
+				Step();
+			}
+		}
+
+		void Cpu6502::PowerUp() noexcept
+		{
+			const data_t addressLow = ReadRom( 0xFFFC );
+			const data_t addressHigh = ReadRom( 0xFFFD );
 
-			mRegisters.ProgramCounter = CreateAddress( addressLow, addressHigh );
-			mAddressBus = mRegisters.ProgramCounter;
+			mState.Registers.ProgramCounter = CreateAddress( addressLow, addressHigh );
+			mState.AddressBus = mState.Registers.ProgramCounter;
+			// Reset masks IRQs and runs the three stack pushes of an interrupt as reads
+			mState.Registers.Status.StatusBits.InterruptDisableFlag = true;
+			mState.Registers.StackPointer = static_cast< data_t >( mState.Registers.StackPointer - 3 );
 
 			char buffer[64] = { 0, };
-			const data_t* mem = &mRomOrNull->GetProgramRom().Data.GetData()[mAddressBus];
+			const data_t* mem = mMapperOrNull->GetProgramData( mState.AddressBus );
 			//const size_t disassembleCount = 256;
 			const size_t disassembleCount = 0;
-			address_t address = mAddressBus;
+			address_t address = mState.AddressBus;
 			for ( size_t i = 0; i < disassembleCount; ++i )
 			{
 				const data_t* prevMem = mem;
@@ -819,7 +916,7 @@ namespace ninmuse
 				address += static_cast<address_t>( diff );
 			}
 
-			mCycleJobs.push( CycleJob{ .AddressBusType = eAddressBusType::PROGRAM_COUNTER, .IncrementProgramCounter = true, .ExternalOperation = eExternalMode::FETCH_OPCODE } );
+			mState.CycleJobs.Push( CycleJob{ .AddressBusType = eAddressBusType::PROGRAM_COUNTER, .IncrementProgramCounter = true, .ExternalOperation = eExternalMode::FETCH_OPCODE } );
 
 			std::cout << std::setw( 8 ) << std::left << "Clocks";
 			std::cout << std::setw( 16 ) << std::left << "Program Counter";
@@ -828,10 +925,6 @@ namespace ninmuse
 			std::cout << std::setw( 24 ) << std::left << "External Operation";
 			std::cout << std::setw( 24 ) << std::left << "Internal Operation";
 			std::cout << std::endl;
-			while ( true )
-			{
-				processSingleClock();
-			}
 		}
 
 		constexpr const char* Cpu6502::convertAddressModeToString( const eAddressMode addressMode ) noexcept
@@ -914,22 +1007,144 @@ namespace ninmuse
 			return 0;
 		}
 
+		constexpr bool Cpu6502::isStore( const eMnemonic mnemonic ) noexcept
+		{
+			return mnemonic == eMnemonic::STA || mnemonic == eMnemonic::STX || mnemonic == eMnemonic::STY;
+		}
+
+		constexpr bool Cpu6502::isReadModifyWrite( const eMnemonic mnemonic ) noexcept
+		{
+			return mnemonic == eMnemonic::ASL || mnemonic == eMnemonic::LSR
+				|| mnemonic == eMnemonic::ROL || mnemonic == eMnemonic::ROR
+				|| mnemonic == eMnemonic::INC || mnemonic == eMnemonic::DEC;
+		}
+
+		// [REF]: https://www.nesdev.org/6502_cpu.txt
+		constexpr uint8_t Cpu6502::getBaseCycles( const eMnemonic mnemonic, const eAddressMode addressMode ) noexcept
+		{
+
+			switch ( addressMode )
+			{
+			case eAddressMode::ACCUMULATOR:
+				[[fallthrough]];
+			case eAddressMode::IMMEDIATE:
+				[[fallthrough]];
+			case eAddressMode::RELATIVE:
+				return 2;
+			case eAddressMode::IMPLIED:
+				switch ( mnemonic )
+				{
+				case eMnemonic::BRK:
+					return 7;
+				case eMnemonic::RTI:
+					[[fallthrough]];
+				case eMnemonic::RTS:
+					return 6;
+				case eMnemonic::PHA:
+					[[fallthrough]];
+				case eMnemonic::PHP:
+					return 3;
+				case eMnemonic::PLA:
+					[[fallthrough]];
+				case eMnemonic::PLP:
+					return 4;
+				default:
+					return 2;
+				}
+			case eAddressMode::ZERO_PAGE:
+				return isReadModifyWrite( mnemonic ) ? 5 : 3;
+			case eAddressMode::ZERO_PAGE_INDEXED_WITH_X:
+				[[fallthrough]];
+			case eAddressMode::ZERO_PAGE_INDEXED_WITH_Y:
+				return isReadModifyWrite( mnemonic ) ? 6 : 4;
+			case eAddressMode::ABSOLUTE:
+				if ( mnemonic == eMnemonic::JMP )
+				{
+					return 3;
+				}
+				return ( mnemonic == eMnemonic::JSR || isReadModifyWrite( mnemonic ) ) ? 6 : 4;
+			case eAddressMode::ABSOLUTE_INDIRECT:
+				return 5;
+			case eAddressMode::ABSOLUTE_INDEXED_WITH_X:
+				[[fallthrough]];
+			case eAddressMode::ABSOLUTE_INDEXED_WITH_Y:
+				return isReadModifyWrite( mnemonic ) ? 7 : ( isStore( mnemonic ) ? 5 : 4 );
+			case eAddressMode::ZERO_PAGE_INDEXED_INDIRECT:
+				return 6;
+			case eAddressMode::ZERO_PAGE_INDIRECT_INDEXED_WITH_Y:
+				return isStore( mnemonic ) ? 6 : 5;
+			case eAddressMode::COUNT:
+				[[fallthrough]];
+			default:
+				assert( false );
+				break;
+			}
+
+			return 0;
+		}
+
+		// Reads through an indexed address pay one more cycle when the index carries into the high byte.
+		// Branches pay it when the taken target is on another page (on top of the cycle for being taken).
+		constexpr bool Cpu6502::hasPageCrossPenalty( const eMnemonic mnemonic, const eAddressMode addressMode ) noexcept
+		{
+			switch ( addressMode )
+			{
+			case eAddressMode::RELATIVE:
+				return true;
+			case eAddressMode::ABSOLUTE_INDEXED_WITH_X:
+				[[fallthrough]];
+			case eAddressMode::ABSOLUTE_INDEXED_WITH_Y:
+				[[fallthrough]];
+			case eAddressMode::ZERO_PAGE_INDIRECT_INDEXED_WITH_Y:
+				return isStore( mnemonic ) == false && isReadModifyWrite( mnemonic ) == false;
+			default:
+				return false;
+			}
+		}
+
+		constexpr Cpu6502::DecodeTable Cpu6502::buildDecodeTable() noexcept
+		{
+			DecodeTable table = {};
+			for ( size_t opcode = 0; opcode < ARRAYSIZE( INSTRUCTION_TABLE ); ++opcode )
+			{
+				const InstructionInfo* const instructionOrNull = INSTRUCTION_TABLE[opcode];
+				if ( instructionOrNull == nullptr )
+				{
+					continue;
+				}
+
+				const eMnemonic mnemonic = instructionOrNull->Mnemonic;
+				const eAddressMode addressMode = instructionOrNull->AddressMode;
+
+				DecodeEntry& entry = table.Entries[opcode];
+				entry.Mnemonic = static_cast< uint16_t >( mnemonic );
+				entry.AddressMode = static_cast< uint16_t >( addressMode );
+				entry.OperandNumBytes = static_cast< uint16_t >( getRequiredOperandNumBytes( addressMode ) );
+				entry.BaseCycles = getBaseCycles( mnemonic, addressMode );
+				entry.HasPageCrossPenalty = hasPageCrossPenalty( mnemonic, addressMode );
+			}
+
+			return table;
+		}
+
+		constinit const Cpu6502::DecodeTable Cpu6502::DECODE_TABLE = Cpu6502::buildDecodeTable();
+
 		void Cpu6502::decode( bool& inoutSkipFetch ) noexcept
 		{
-			const data_t opcode = mDataToDecode;
-			mExecutionInfo.InstructionInfoOrNull = INSTRUCTION_TABLE[opcode];
-			NM_ASSERT( mExecutionInfo.InstructionInfoOrNull != nullptr, "Invalid opcode!!" );
+			const data_t opcode = mState.DataToDecode;
+			mState.ExecutionInfo.Decoded = DECODE_TABLE[opcode];
+			NM_ASSERT( mState.ExecutionInfo.Decoded.IsValid(), "Invalid opcode!!" );
 
-			switch ( mExecutionInfo.InstructionInfoOrNull->AddressMode )
+			switch ( mState.ExecutionInfo.Decoded.GetAddressMode() )
 			{
 			case eAddressMode::ACCUMULATOR:
 			{
 				inoutSkipFetch = true;
 
-				CycleJob& currentCycleJob = mCycleJobs.front();
+				CycleJob& currentCycleJob = mState.CycleJobs.Front();
 				currentCycleJob.IncrementProgramCounter = false;
 
-				mCycleJobs.push( CycleJob{ .AddressBusType = eAddressBusType::PROGRAM_COUNTER,
+				mState.CycleJobs.Push( CycleJob{ .AddressBusType = eAddressBusType::PROGRAM_COUNTER,
 												.IncrementProgramCounter = true,
 												.ExternalOperation = eExternalMode::FETCH_OPCODE,
 												.InternalOperation = eInternalMode::EXECUTE } );
@@ -937,11 +1152,11 @@ namespace ninmuse
 			break;
 			case eAddressMode::IMMEDIATE:
 			{
-				CycleJob& currentCycleJob = mCycleJobs.front();
+				CycleJob& currentCycleJob = mState.CycleJobs.Front();
 				currentCycleJob.IncrementProgramCounter = true;
 				currentCycleJob.ExternalOperation = eExternalMode::FETCH_DATA_FROM_ROM;
 
-				mCycleJobs.push( CycleJob{ .AddressBusType = eAddressBusType::PROGRAM_COUNTER,
+				mState.CycleJobs.Push( CycleJob{ .AddressBusType = eAddressBusType::PROGRAM_COUNTER,
 												.IncrementProgramCounter = true,
 												.ExternalOperation = eExternalMode::FETCH_OPCODE,
 												.InternalOperation = eInternalMode::EXECUTE } );
@@ -949,44 +1164,44 @@ namespace ninmuse
 			break;
 			case eAddressMode::ABSOLUTE:
 			{
-				CycleJob& currentCycleJob = mCycleJobs.front();
+				CycleJob& currentCycleJob = mState.CycleJobs.Front();
 				currentCycleJob.IncrementProgramCounter = true;
 				currentCycleJob.ExternalOperation = eExternalMode::FETCH_LOW_ADDRESS_FROM_ROM;
 
-				if ( mExecutionInfo.InstructionInfoOrNull->Mnemonic == eMnemonic::JSR )
+				if ( mState.ExecutionInfo.Decoded.GetMnemonic() == eMnemonic::JSR )
 				{
-					mCycleJobs.push( CycleJob{ .AddressBusType = eAddressBusType::STACK_POINTER,
+					mState.CycleJobs.Push( CycleJob{ .AddressBusType = eAddressBusType::STACK_POINTER,
 													.IncrementProgramCounter = false,
 													.ExternalOperation = eExternalMode::FETCH_DATA_FROM_RAM,
 													.InternalOperation = eInternalMode::SET_ADDRESS_BUS_ABSOLUTE_MODE } );
-					mCycleJobs.push( CycleJob{ .AddressBusType = eAddressBusType::STACK_POINTER,
+					mState.CycleJobs.Push( CycleJob{ .AddressBusType = eAddressBusType::STACK_POINTER,
 													.IncrementProgramCounter = false,
 													.ExternalOperation = eExternalMode::SAVE_PROGRAM_COUNTER_HIGH_TO_RAM,
 													.InternalOperation = eInternalMode::DECREASE_STACK_POINTER } );
-					mCycleJobs.push( CycleJob{ .AddressBusType = eAddressBusType::STACK_POINTER,
+					mState.CycleJobs.Push( CycleJob{ .AddressBusType = eAddressBusType::STACK_POINTER,
 													.IncrementProgramCounter = false,
 													.ExternalOperation = eExternalMode::SAVE_PROGRAM_COUNTER_LOW_TO_RAM,
 													.InternalOperation = eInternalMode::DECREASE_STACK_POINTER } );
-					mCycleJobs.push( CycleJob{ .AddressBusType = eAddressBusType::PROGRAM_COUNTER,
+					mState.CycleJobs.Push( CycleJob{ .AddressBusType = eAddressBusType::PROGRAM_COUNTER,
 													.IncrementProgramCounter = false,
 													.ExternalOperation = eExternalMode::FETCH_HIGH_ADDRESS_FROM_ROM,
 													.InternalOperation = eInternalMode::SET_ADDRESS_BUS_ABSOLUTE_MODE } );
-					mCycleJobs.push( CycleJob{ .AddressBusType = eAddressBusType::ADDRESS,
+					mState.CycleJobs.Push( CycleJob{ .AddressBusType = eAddressBusType::ADDRESS,
 													.IncrementProgramCounter = true,
 													.ExternalOperation = eExternalMode::FETCH_OPCODE,
 													.InternalOperation = eInternalMode::EXECUTE } );
 				}
 				else
 				{
-					mCycleJobs.push( CycleJob{ .AddressBusType = eAddressBusType::PROGRAM_COUNTER,
+					mState.CycleJobs.Push( CycleJob{ .AddressBusType = eAddressBusType::PROGRAM_COUNTER,
 													.IncrementProgramCounter = true,
 													.ExternalOperation = eExternalMode::FETCH_HIGH_ADDRESS_FROM_ROM,
 													.InternalOperation = eInternalMode::SET_ADDRESS_BUS_ABSOLUTE_MODE } );
-					mCycleJobs.push( CycleJob{ .AddressBusType = eAddressBusType::ADDRESS,
+					mState.CycleJobs.Push( CycleJob{ .AddressBusType = eAddressBusType::ADDRESS,
 													.IncrementProgramCounter = false,
 													.ExternalOperation = eExternalMode::FETCH_DATA_FROM_RAM,
 													.InternalOperation = eInternalMode::NONE } );
-					mCycleJobs.push( CycleJob{ .AddressBusType = eAddressBusType::PROGRAM_COUNTER,
+					mState.CycleJobs.Push( CycleJob{ .AddressBusType = eAddressBusType::PROGRAM_COUNTER,
 													.IncrementProgramCounter = true,
 													.ExternalOperation = eExternalMode::FETCH_OPCODE,
 													.InternalOperation = eInternalMode::EXECUTE } );
@@ -999,35 +1214,59 @@ namespace ninmuse
 			case eAddressMode::IMPLIED:
 			{
 				inoutSkipFetch = true;
-				CycleJob& currentCycleJob = mCycleJobs.front();
+				CycleJob& currentCycleJob = mState.CycleJobs.Front();
 				currentCycleJob.IncrementProgramCounter = false;
 
-				if ( mExecutionInfo.InstructionInfoOrNull->Mnemonic == eMnemonic::RTS )
+				if ( mState.ExecutionInfo.Decoded.GetMnemonic() == eMnemonic::RTI )
 				{
-					mCycleJobs.push( CycleJob{ .AddressBusType = eAddressBusType::STACK_POINTER,
+					mState.CycleJobs.Push( CycleJob{ .AddressBusType = eAddressBusType::STACK_POINTER,
 													.IncrementProgramCounter = false,
 													.ExternalOperation = eExternalMode::FETCH_DATA_FROM_RAM,
 													.InternalOperation = eInternalMode::INCREASE_STACK_POINTER } );
-					mCycleJobs.push( CycleJob{ .AddressBusType = eAddressBusType::STACK_POINTER,
+					mState.CycleJobs.Push( CycleJob{ .AddressBusType = eAddressBusType::STACK_POINTER,
+													.IncrementProgramCounter = false,
+													.ExternalOperation = eExternalMode::FETCH_STATUS_FROM_RAM,
+													.InternalOperation = eInternalMode::INCREASE_STACK_POINTER } );
+					mState.CycleJobs.Push( CycleJob{ .AddressBusType = eAddressBusType::STACK_POINTER,
 													.IncrementProgramCounter = false,
 													.ExternalOperation = eExternalMode::FETCH_LOW_ADDRESS_FROM_RAM,
 													.InternalOperation = eInternalMode::INCREASE_STACK_POINTER } );
-					mCycleJobs.push( CycleJob{ .AddressBusType = eAddressBusType::STACK_POINTER,
+					mState.CycleJobs.Push( CycleJob{ .AddressBusType = eAddressBusType::STACK_POINTER,
 													.IncrementProgramCounter = false,
 													.ExternalOperation = eExternalMode::FETCH_HIGH_ADDRESS_FROM_RAM,
 													.InternalOperation = eInternalMode::SET_ADDRESS_BUS_ABSOLUTE_MODE } );
-					mCycleJobs.push( CycleJob{ .AddressBusType = eAddressBusType::ADDRESS,
+					// Unlike RTS, the pulled address is the next opcode itself
+					mState.CycleJobs.Push( CycleJob{ .AddressBusType = eAddressBusType::ADDRESS,
+													.IncrementProgramCounter = true,
+													.ExternalOperation = eExternalMode::FETCH_OPCODE,
+													.InternalOperation = eInternalMode::SET_PROGRAM_COUNTER } );
+				}
+				else if ( mState.ExecutionInfo.Decoded.GetMnemonic() == eMnemonic::RTS )
+				{
+					mState.CycleJobs.Push( CycleJob{ .AddressBusType = eAddressBusType::STACK_POINTER,
+													.IncrementProgramCounter = false,
+													.ExternalOperation = eExternalMode::FETCH_DATA_FROM_RAM,
+													.InternalOperation = eInternalMode::INCREASE_STACK_POINTER } );
+					mState.CycleJobs.Push( CycleJob{ .AddressBusType = eAddressBusType::STACK_POINTER,
+													.IncrementProgramCounter = false,
+													.ExternalOperation = eExternalMode::FETCH_LOW_ADDRESS_FROM_RAM,
+													.InternalOperation = eInternalMode::INCREASE_STACK_POINTER } );
+					mState.CycleJobs.Push( CycleJob{ .AddressBusType = eAddressBusType::STACK_POINTER,
+													.IncrementProgramCounter = false,
+													.ExternalOperation = eExternalMode::FETCH_HIGH_ADDRESS_FROM_RAM,
+													.InternalOperation = eInternalMode::SET_ADDRESS_BUS_ABSOLUTE_MODE } );
+					mState.CycleJobs.Push( CycleJob{ .AddressBusType = eAddressBusType::ADDRESS,
 													.IncrementProgramCounter = true,
 													.ExternalOperation = eExternalMode::FETCH_DATA_FROM_ROM,
 													.InternalOperation = eInternalMode::SET_PROGRAM_COUNTER } );
-					mCycleJobs.push( CycleJob{ .AddressBusType = eAddressBusType::PROGRAM_COUNTER,
+					mState.CycleJobs.Push( CycleJob{ .AddressBusType = eAddressBusType::PROGRAM_COUNTER,
 													.IncrementProgramCounter = true,
 													.ExternalOperation = eExternalMode::FETCH_OPCODE,
 													.InternalOperation = eInternalMode::EXECUTE } );
 				}
 				else
 				{
-					mCycleJobs.push( CycleJob{ .AddressBusType = eAddressBusType::PROGRAM_COUNTER,
+					mState.CycleJobs.Push( CycleJob{ .AddressBusType = eAddressBusType::PROGRAM_COUNTER,
 													.IncrementProgramCounter = true,
 													.ExternalOperation = eExternalMode::FETCH_OPCODE,
 													.InternalOperation = eInternalMode::EXECUTE } );
@@ -1036,11 +1275,11 @@ namespace ninmuse
 			break;
 			case eAddressMode::RELATIVE:
 			{
-				CycleJob& currentCycleJob = mCycleJobs.front();
+				CycleJob& currentCycleJob = mState.CycleJobs.Front();
 				currentCycleJob.IncrementProgramCounter = true;
 				currentCycleJob.ExternalOperation = eExternalMode::FETCH_LOW_ADDRESS_FROM_ROM;
 
-				mCycleJobs.push( CycleJob{ .AddressBusType = eAddressBusType::PROGRAM_COUNTER,
+				mState.CycleJobs.Push( CycleJob{ .AddressBusType = eAddressBusType::PROGRAM_COUNTER,
 												.IncrementProgramCounter = true,
 												.ExternalOperation = eExternalMode::FETCH_OPCODE,
 												.InternalOperation = eInternalMode::CHECK_STATUS } );
@@ -1075,19 +1314,60 @@ namespace ninmuse
 			}
 		}
 
+		// [REF]: https://www.nesdev.org/wiki/CPU_interrupts
+		void Cpu6502::beginInterrupt() noexcept
+		{
+			// The opcode just fetched is dropped, and fetched again after RTI
+			CycleJob& currentCycleJob = mState.CycleJobs.Front();
+			currentCycleJob.IncrementProgramCounter = false;
+
+			const bool isNmi = mState.IsNmiPending;
+			mState.IsNmiPending = false;
+			mState.ExecutionInfo.Operand.Address = isNmi ? NMI_VECTOR_ADDRESS : IRQ_VECTOR_ADDRESS;
+
+			// A dummy read that leaves the operand, and so the vector address, alone
+			mState.CycleJobs.Push( CycleJob{ .AddressBusType = eAddressBusType::PROGRAM_COUNTER,
+											.IncrementProgramCounter = false,
+											.ExternalOperation = eExternalMode::FETCH_DATA_FROM_RAM,
+											.InternalOperation = eInternalMode::NONE } );
+			mState.CycleJobs.Push( CycleJob{ .AddressBusType = eAddressBusType::STACK_POINTER,
+											.IncrementProgramCounter = false,
+											.ExternalOperation = eExternalMode::SAVE_PROGRAM_COUNTER_HIGH_TO_RAM,
+											.InternalOperation = eInternalMode::DECREASE_STACK_POINTER } );
+			mState.CycleJobs.Push( CycleJob{ .AddressBusType = eAddressBusType::STACK_POINTER,
+											.IncrementProgramCounter = false,
+											.ExternalOperation = eExternalMode::SAVE_PROGRAM_COUNTER_LOW_TO_RAM,
+											.InternalOperation = eInternalMode::DECREASE_STACK_POINTER } );
+			mState.CycleJobs.Push( CycleJob{ .AddressBusType = eAddressBusType::STACK_POINTER,
+											.IncrementProgramCounter = false,
+											.ExternalOperation = eExternalMode::SAVE_STATUS_TO_RAM_FOR_INTERRUPT,
+											.InternalOperation = eInternalMode::DECREASE_STACK_POINTER } );
+			mState.CycleJobs.Push( CycleJob{ .AddressBusType = eAddressBusType::PROGRAM_COUNTER,
+											.IncrementProgramCounter = true,
+											.ExternalOperation = eExternalMode::FETCH_LOW_ADDRESS_FROM_ROM,
+											.InternalOperation = eInternalMode::NONE } );
+			mState.CycleJobs.Push( CycleJob{ .AddressBusType = eAddressBusType::PROGRAM_COUNTER,
+											.IncrementProgramCounter = true,
+											.ExternalOperation = eExternalMode::FETCH_HIGH_ADDRESS_FROM_ROM,
+											.InternalOperation = eInternalMode::NONE } );
+			mState.CycleJobs.Push( CycleJob{ .AddressBusType = eAddressBusType::ADDRESS,
+											.IncrementProgramCounter = true,
+											.ExternalOperation = eExternalMode::FETCH_OPCODE,
+											.InternalOperation = eInternalMode::SET_PROGRAM_COUNTER } );
+		}
+
 		constexpr const data_t* Cpu6502::disassemble( char* out_buffer64, const data_t* mem ) noexcept
 		{
 			// read instruction
 			const data_t opcode = mem[0];
-			const InstructionInfo* const p_instruction = INSTRUCTION_TABLE[opcode];
-			if ( p_instruction == NULL ) {
+			const DecodeEntry instruction = DECODE_TABLE[opcode];
+			if ( instruction.IsValid() == false ) {
 				return mem;
 			}
 
-			const InstructionInfo instruction = *p_instruction;
-			const char* const mnemonic = instruction.Name;
-			const char* const AddressMode = convertAddressModeToString( instruction.AddressMode );
-			const size_t operand_bytes = getRequiredOperandNumBytes( instruction.AddressMode );
+			const char* const mnemonic = getMnemonicName( instruction.GetMnemonic() );
+			const char* const AddressMode = convertAddressModeToString( instruction.GetAddressMode() );
+			const size_t operand_bytes = instruction.OperandNumBytes;
 			const data_t operand_hi_byte = operand_bytes > 1 ? mem[2] : 0;
 			const data_t operand_lo_byte = operand_bytes > 0 ? mem[1] : 0;
 
@@ -1111,14 +1391,14 @@ namespace ninmuse
 
 		constexpr bool Cpu6502::execute() noexcept
 		{
-			const InstructionInfo& instruction = *mExecutionInfo.InstructionInfoOrNull;
+			const DecodeEntry& instruction = mState.ExecutionInfo.Decoded;
 
-			const size_t numOperands = getRequiredOperandNumBytes( instruction.AddressMode );
+			const size_t numOperands = instruction.OperandNumBytes;
 			data_t operand = 0;
 			address_t address = 0;
 			if ( numOperands > 0 )
 			{
-				switch ( instruction.AddressMode )
+				switch ( instruction.GetAddressMode() )
 				{
 				case eAddressMode::ACCUMULATOR:
 					[[fallthrough]];
@@ -1126,16 +1406,16 @@ namespace ninmuse
 					NM_ASSERT( false, "Logic error!!" );
 					break;
 				case eAddressMode::IMMEDIATE:
-					operand = mExecutionInfo.Operand.Data.Value;
+					operand = mState.ExecutionInfo.Operand.Data.Value;
 					break;
 				case eAddressMode::ABSOLUTE:
-					address = mExecutionInfo.Operand.Address;
+					address = mState.ExecutionInfo.Operand.Address;
 					break;
 				case eAddressMode::ZERO_PAGE:
 					NM_ASSERT( false, "Unimplemented mnemonic!!" );
 					break;
 				case eAddressMode::RELATIVE:
-					operand = mExecutionInfo.Operand.Data.Value;
+					operand = mState.ExecutionInfo.Operand.Data.Value;
 					break;
 				case eAddressMode::ABSOLUTE_INDIRECT:
 					NM_ASSERT( false, "Unimplemented mnemonic!!" );
@@ -1167,23 +1447,23 @@ namespace ninmuse
 			}
 
 			bool result = true;
-			switch ( instruction.Mnemonic )
+			switch ( instruction.GetMnemonic() )
 			{
 			case eMnemonic::ADC:
 			{
-				const data_t prevAccumulator = mRegisters.Accumulator;
-				mRegisters.Accumulator += operand;
-				mRegisters.Status.StatusBits.CarryFlag = prevAccumulator > mRegisters.Accumulator;
-				mRegisters.Status.StatusBits.ZeroFlag = mRegisters.Accumulator;
-				mRegisters.Status.StatusBits.OverflowFlag = ( prevAccumulator ^ mRegisters.Accumulator ) | 0b1000'0000;
-				mRegisters.Status.StatusBits.NegativeFlag = mRegisters.Accumulator | 0b1000'0000;
+				const data_t prevAccumulator = mState.Registers.Accumulator;
+				mState.Registers.Accumulator += operand;
+				mState.Registers.Status.StatusBits.CarryFlag = prevAccumulator > mState.Registers.Accumulator;
+				mState.Registers.Status.StatusBits.ZeroFlag = mState.Registers.Accumulator;
+				mState.Registers.Status.StatusBits.OverflowFlag = ( prevAccumulator ^ mState.Registers.Accumulator ) | 0b1000'0000;
+				mState.Registers.Status.StatusBits.NegativeFlag = mState.Registers.Accumulator | 0b1000'0000;
 				NM_ASSERT( false, "Unimplemented mnemonic!!" );
 			}
 				break;
 			case eMnemonic::AND:
-				mRegisters.Accumulator &= operand;
-				mRegisters.Status.StatusBits.ZeroFlag = mRegisters.Accumulator;
-				mRegisters.Status.StatusBits.NegativeFlag = mRegisters.Accumulator | 0b1000'0000;
+				mState.Registers.Accumulator &= operand;
+				mState.Registers.Status.StatusBits.ZeroFlag = mState.Registers.Accumulator;
+				mState.Registers.Status.StatusBits.NegativeFlag = mState.Registers.Accumulator | 0b1000'0000;
 				break;
 			case eMnemonic::ASL:
 				NM_ASSERT( false, "Unimplemented mnemonic!!" );
@@ -1195,7 +1475,7 @@ namespace ninmuse
 				NM_ASSERT( false, "Unimplemented mnemonic!!" );
 				break;
 			case eMnemonic::BEQ:
-				mRegisters.ProgramCounter += operand * mRegisters.Status.StatusBits.ZeroFlag;
+				mState.Registers.ProgramCounter += operand * mState.Registers.Status.StatusBits.ZeroFlag;
 				break;
 			case eMnemonic::BIT:
 				NM_ASSERT( false, "Unimplemented mnemonic!!" );
@@ -1222,10 +1502,10 @@ namespace ninmuse
 				NM_ASSERT( false, "Unimplemented mnemonic!!" );
 				break;
 			case eMnemonic::CLD:
-				mRegisters.Status.StatusBits.DecimalModeFlag = false;
+				mState.Registers.Status.StatusBits.DecimalModeFlag = false;
 				break;
 			case eMnemonic::CLI:
-				mRegisters.Status.StatusBits.InterruptDisableFlag = false;
+				mState.Registers.Status.StatusBits.InterruptDisableFlag = false;
 				break;
 			case eMnemonic::CLV:
 				NM_ASSERT( false, "Unimplemented mnemonic!!" );
@@ -1264,27 +1544,27 @@ namespace ninmuse
 				NM_ASSERT( false, "Unimplemented mnemonic!!" );
 				break;
 			case eMnemonic::JSR:
-				mRegisters.ProgramCounter = mExecutionInfo.Operand.Address;
+				mState.Registers.ProgramCounter = mState.ExecutionInfo.Operand.Address;
 				break;
 			case eMnemonic::LDA:
-				mRegisters.Accumulator = operand;
-				mRegisters.Status.StatusBits.ZeroFlag = mRegisters.Accumulator;
-				mRegisters.Status.StatusBits.NegativeFlag = mRegisters.Accumulator | 0b1000'0000;
+				mState.Registers.Accumulator = operand;
+				mState.Registers.Status.StatusBits.ZeroFlag = mState.Registers.Accumulator;
+				mState.Registers.Status.StatusBits.NegativeFlag = mState.Registers.Accumulator | 0b1000'0000;
 				break;
 			case eMnemonic::LDX:
-				mRegisters.IndexX = operand;
-				mRegisters.Status.StatusBits.ZeroFlag = mRegisters.IndexX;
-				mRegisters.Status.StatusBits.NegativeFlag = mRegisters.IndexX | 0b1000'0000;
+				mState.Registers.IndexX = operand;
+				mState.Registers.Status.StatusBits.ZeroFlag = mState.Registers.IndexX;
+				mState.Registers.Status.StatusBits.NegativeFlag = mState.Registers.IndexX | 0b1000'0000;
 				break;
 			case eMnemonic::LDY:
-				mRegisters.IndexY = operand;
-				mRegisters.Status.StatusBits.ZeroFlag = mRegisters.IndexY;
-				mRegisters.Status.StatusBits.NegativeFlag = mRegisters.IndexY | 0b1000'0000;
+				mState.Registers.IndexY = operand;
+				mState.Registers.Status.StatusBits.ZeroFlag = mState.Registers.IndexY;
+				mState.Registers.Status.StatusBits.NegativeFlag = mState.Registers.IndexY | 0b1000'0000;
 				break;
 			case eMnemonic::LSR:
-				if ( instruction.AddressMode == eAddressMode::ACCUMULATOR )
+				if ( instruction.GetAddressMode() == eAddressMode::ACCUMULATOR )
 				{
-					mRegisters.Accumulator >>= 1;
+					mState.Registers.Accumulator >>= 1;
 				}
 				else
 				{
@@ -1295,9 +1575,9 @@ namespace ninmuse
 				NM_ASSERT( false, "Unimplemented mnemonic!!" );
 				break;
 			case eMnemonic::ORA:
-				mRegisters.Accumulator |= operand;
-				mRegisters.Status.StatusBits.ZeroFlag = mRegisters.Accumulator;
-				mRegisters.Status.StatusBits.NegativeFlag = mRegisters.Accumulator | 0b1000'0000;
+				mState.Registers.Accumulator |= operand;
+				mState.Registers.Status.StatusBits.ZeroFlag = mState.Registers.Accumulator;
+				mState.Registers.Status.StatusBits.NegativeFlag = mState.Registers.Accumulator | 0b1000'0000;
 				break;
 			case eMnemonic::PHA:
 				NM_ASSERT( false, "Unimplemented mnemonic!!" );
@@ -1318,8 +1598,7 @@ namespace ninmuse
 				NM_ASSERT( false, "Unimplemented mnemonic!!" );
 				break;
 			case eMnemonic::RTI:
-				NM_ASSERT( false, "Unimplemented mnemonic!!" );
-				break;
+				[[fallthrough]];
 			case eMnemonic::RTS:
 				break;
 			case eMnemonic::SBC:
@@ -1329,47 +1608,47 @@ namespace ninmuse
 				NM_ASSERT( false, "Unimplemented mnemonic!!" );
 				break;
 			case eMnemonic::SED:
-				mRegisters.Status.StatusBits.DecimalModeFlag = true;
+				mState.Registers.Status.StatusBits.DecimalModeFlag = true;
 				break;
 			case eMnemonic::SEI:
-				mRegisters.Status.StatusBits.InterruptDisableFlag = true;
+				mState.Registers.Status.StatusBits.InterruptDisableFlag = true;
 				break;
 			case eMnemonic::STA:
-				Write( address, mRegisters.Accumulator );
+				Write( address, mState.Registers.Accumulator );
 				break;
 			case eMnemonic::STX:
-				Write( address, mRegisters.IndexX );
+				Write( address, mState.Registers.IndexX );
 				break;
 			case eMnemonic::STY:
-				Write( address, mRegisters.IndexY );
+				Write( address, mState.Registers.IndexY );
 				break;
 			case eMnemonic::TAX:
-				mRegisters.IndexX = mRegisters.Accumulator;
-				mRegisters.Status.StatusBits.ZeroFlag = mRegisters.IndexX;
-				mRegisters.Status.StatusBits.NegativeFlag = mRegisters.IndexX | 0b1000'0000;
+				mState.Registers.IndexX = mState.Registers.Accumulator;
+				mState.Registers.Status.StatusBits.ZeroFlag = mState.Registers.IndexX;
+				mState.Registers.Status.StatusBits.NegativeFlag = mState.Registers.IndexX | 0b1000'0000;
 				break;
 			case eMnemonic::TAY:
-				mRegisters.IndexY = mRegisters.Accumulator;
-				mRegisters.Status.StatusBits.ZeroFlag = mRegisters.IndexY;
-				mRegisters.Status.StatusBits.NegativeFlag = mRegisters.IndexY | 0b1000'0000;
+				mState.Registers.IndexY = mState.Registers.Accumulator;
+				mState.Registers.Status.StatusBits.ZeroFlag = mState.Registers.IndexY;
+				mState.Registers.Status.StatusBits.NegativeFlag = mState.Registers.IndexY | 0b1000'0000;
 				break;
 			case eMnemonic::TSX:
-				mRegisters.IndexX = mRegisters.StackPointer;
-				mRegisters.Status.StatusBits.ZeroFlag = mRegisters.IndexX;
-				mRegisters.Status.StatusBits.NegativeFlag = mRegisters.IndexX | 0b1000'0000;
+				mState.Registers.IndexX = mState.Registers.StackPointer;
+				mState.Registers.Status.StatusBits.ZeroFlag = mState.Registers.IndexX;
+				mState.Registers.Status.StatusBits.NegativeFlag = mState.Registers.IndexX | 0b1000'0000;
 				break;
 			case eMnemonic::TXA:
-				mRegisters.StackPointer = mRegisters.Accumulator;
-				mRegisters.Status.StatusBits.ZeroFlag = mRegisters.Accumulator;
-				mRegisters.Status.StatusBits.NegativeFlag = mRegisters.Accumulator | 0b1000'0000;
+				mState.Registers.StackPointer = mState.Registers.Accumulator;
+				mState.Registers.Status.StatusBits.ZeroFlag = mState.Registers.Accumulator;
+				mState.Registers.Status.StatusBits.NegativeFlag = mState.Registers.Accumulator | 0b1000'0000;
 				break;
 			case eMnemonic::TXS:
-				mRegisters.StackPointer = mRegisters.IndexX;
+				mState.Registers.StackPointer = mState.Registers.IndexX;
 				break;
 			case eMnemonic::TYA:
-				mRegisters.Accumulator = mRegisters.IndexY;
-				mRegisters.Status.StatusBits.ZeroFlag = mRegisters.Accumulator;
-				mRegisters.Status.StatusBits.NegativeFlag = mRegisters.Accumulator | 0b1000'0000;
+				mState.Registers.Accumulator = mState.Registers.IndexY;
+				mState.Registers.Status.StatusBits.ZeroFlag = mState.Registers.Accumulator;
+				mState.Registers.Status.StatusBits.NegativeFlag = mState.Registers.Accumulator | 0b1000'0000;
 				break;
 			case eMnemonic::COUNT:
 				[[fallthrough]];
@@ -1,19 +1,18 @@
 #pragma once
 
-#include <queue>
-
 #include "Common.h"
 
 #include "NES/Memory.h"
+#include "NES/StaticQueue.h"
 
 namespace ninmuse
 {
-	template <Data TData, Address TAddress>
+	template <Data TData, Address TAddress, Array<TData> TArray = DynamicArray<TData>>
 	class ICpu
 	{
 	public:
 		ICpu() = delete;
-		inline constexpr ICpu( IRam<TData>& ram ) noexcept : mRam( ram ) {}
+		inline constexpr ICpu( IRam<TData, TArray>& ram ) noexcept : mRam( ram ) {}
 		ICpu( const ICpu& ) = delete;
 		explicit ICpu( ICpu&& ) noexcept = default;
 		virtual ~ICpu() = default;
@@ -26,28 +25,26 @@ namespace ninmuse
 		constexpr void			Write( const TAddress& address, const TData& data ) noexcept;
 
 	private:
-		IRam<TData>&	mRam;
+		IRam<TData, TArray>&	mRam;
 	};
 
 	namespace nes
 	{
-		class Cpu6502 : public ICpu<data_t, address_t>
+		class Mapper;
+		class Ppu;
+
+		class Cpu6502 : public ICpu<data_t, address_t, ArrayView<data_t>>
 		{
+		public:
+			struct State;
+
 		public:
 			Cpu6502() = delete;
-			inline Cpu6502( IRam<data_t>& ram, const Cartridge* cartridgeOrNull ) noexcept
-				: ICpu<data_t, address_t>( ram )
-				, mRomOrNull( cartridgeOrNull )
-				, mRegisters()
-				, mCurrentInternalMode( eExternalMode::FETCH_OPCODE )
-				, mCurrentExternalMode( eInternalMode::PREVIOUS )
-				, mReadRam( false )
-				, mAddressBus()
-				, mDataBus()
-				, mDataToDecode()
-				, mDecodeCounter( 0 )
-				, mExecutionInfo{ .InstructionInfoOrNull = nullptr, .IsReady = false }
-				, mJumpSubroutineClock( 0 )
+			inline Cpu6502( IRam<data_t, ArrayView<data_t>>& ram, Mapper* mapperOrNull, State& state ) noexcept
+				: ICpu<data_t, address_t, ArrayView<data_t>>( ram )
+				, mMapperOrNull( mapperOrNull )
+				, mPpuOrNull( nullptr )
+				, mState( state )
 			{}
 			Cpu6502( const Cpu6502& ) = delete;
 			explicit Cpu6502( Cpu6502&& ) noexcept = default;
@@ -139,38 +136,68 @@ namespace ninmuse
 
 			struct Pins {};
 
+			// Human readable description of one opcode. Only used to generate DECODE_TABLE.
 			struct InstructionInfo final
 			{
-				const char*		Name;
 				eAddressMode	AddressMode;
 				data_t			Opcode;
 				eMnemonic		Mnemonic;
 			};
 
+			// What the CPU needs to know about an opcode, packed into 16 bits.
+			// Illegal opcodes keep the default entry, whose mnemonic is eMnemonic::COUNT.
+			struct DecodeEntry final
+			{
+				uint16_t	Mnemonic			: 6 = static_cast< uint16_t >( eMnemonic::COUNT );
+				uint16_t	AddressMode			: 4 = static_cast< uint16_t >( eAddressMode::NONE );
+				uint16_t	OperandNumBytes		: 2 = 0;
+				uint16_t	BaseCycles			: 3 = 0;
+				uint16_t	HasPageCrossPenalty	: 1 = 0;
+
+				inline constexpr bool			IsValid() const noexcept { return Mnemonic != static_cast< uint16_t >( eMnemonic::COUNT ); }
+				inline constexpr eMnemonic		GetMnemonic() const noexcept { return static_cast< eMnemonic >( Mnemonic ); }
+				inline constexpr eAddressMode	GetAddressMode() const noexcept { return static_cast< eAddressMode >( AddressMode ); }
+			};
+
 			struct ExecutionInfo final
 			{
-				const InstructionInfo*	InstructionInfoOrNull;
+				DecodeEntry				Decoded = {};
 				union Operand
 				{
 					address_t Address;
 					struct Data
 					{
-					public:
 						data_t	Value;
-					private:
 						data_t	Padding;
 					} Data;
 					data_t	Bytes[2];
-				} Operand;
-				bool					IsReady;
+				} Operand = {};
+				bool					IsReady = false;
 
-				inline constexpr void	Reset() noexcept { InstructionInfoOrNull = nullptr; IsReady = false; }
+				inline constexpr void	Reset() noexcept { Decoded = {}; IsReady = false; }
 			};
 
 		public:
-			inline constexpr void	SetRom( const Cartridge& cartridge ) noexcept { mRomOrNull = &cartridge; }
+			inline constexpr void	SetMapper( Mapper& mapper ) noexcept { mMapperOrNull = &mapper; }
+			inline constexpr void	RemoveMapper() noexcept { mMapperOrNull = nullptr; }
+			inline constexpr void	SetPpu( Ppu& ppu ) noexcept { mPpuOrNull = &ppu; }
 
 			data_t	ReadRom( const address_t& address ) const noexcept;
+			// Cartridge space goes to the mapper, $2000-$3FFF and $4014 to the PPU, everything else to the console RAM
+			data_t	ReadBus( const address_t& address ) noexcept;
+			void	WriteBus( const address_t& address, const data_t& data ) noexcept;
+			// Runs one CPU cycle; Run() calls it forever, a console interleaving other chips calls it directly
+			inline void	Step() noexcept { processSingleClock(); }
+			void	PowerUp() noexcept;
+
+			// Interrupt pins, low when asserted as on the chip. The console drives them from the mapper and the PPU; the CPU
+			// checks them at the next opcode fetch and takes an NMI once per falling edge, an IRQ while low and not masked.
+			inline constexpr void	SetInterruptRequestBar( const bool isHigh ) noexcept { mState.InterruptRequestBar = isHigh; }
+			inline constexpr void	SetNonMaskableInterruptBar( const bool isHigh ) noexcept
+			{
+				mState.IsNmiPending |= mState.NonMaskableInterruptBar && isHigh == false;
+				mState.NonMaskableInterruptBar = isHigh;
+			}
 			void	Run() noexcept;
 
 		protected:
@@ -181,56 +208,48 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo ABSOLUTE =
 					{
-						.Name = "lda",
 						.AddressMode = eAddressMode::ABSOLUTE,
 						.Opcode = 0xAD,
 						.Mnemonic = eMnemonic::LDA,
 					};
 					static constexpr const InstructionInfo ABSOLUTE_INDEXED_WITH_X =
 					{
-						.Name = "lda",
 						.AddressMode = eAddressMode::ABSOLUTE_INDEXED_WITH_X,
 						.Opcode = 0xBD,
 						.Mnemonic = eMnemonic::LDA,
 					};
 					static constexpr const InstructionInfo ABSOLUTE_INDEXED_WITH_Y =
 					{
-						.Name = "lda",
 						.AddressMode = eAddressMode::ABSOLUTE_INDEXED_WITH_Y,
 						.Opcode = 0xB9,
 						.Mnemonic = eMnemonic::LDA,
 					};
 					static constexpr const InstructionInfo IMMEDIATE =
 					{
-						.Name = "lda",
 						.AddressMode = eAddressMode::IMMEDIATE,
 						.Opcode = 0xA9,
 						.Mnemonic = eMnemonic::LDA,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE =
 					{
-						.Name = "lda",
 						.AddressMode = eAddressMode::ZERO_PAGE,
 						.Opcode = 0xA5,
 						.Mnemonic = eMnemonic::LDA,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE_INDEXED_INDIRECT =
 					{
-						.Name = "lda",
 						.AddressMode = eAddressMode::ZERO_PAGE_INDEXED_INDIRECT,
 						.Opcode = 0xA1,
 						.Mnemonic = eMnemonic::LDA,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE_INDEXED_WITH_X =
 					{
-						.Name = "lda",
 						.AddressMode = eAddressMode::ZERO_PAGE_INDEXED_WITH_X,
 						.Opcode = 0xB5,
 						.Mnemonic = eMnemonic::LDA,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE_INDIRECT_INDEXED_WITH_Y =
 					{
-						.Name = "lda",
 						.AddressMode = eAddressMode::ZERO_PAGE_INDIRECT_INDEXED_WITH_Y,
 						.Opcode = 0xB1,
 						.Mnemonic = eMnemonic::LDA,
@@ -240,35 +259,30 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo ABSOLUTE =
 					{
-						.Name = "ldx",
 						.AddressMode = eAddressMode::ABSOLUTE,
 						.Opcode = 0xAE,
 						.Mnemonic = eMnemonic::LDX,
 					};
 					static constexpr const InstructionInfo ABSOLUTE_INDEXED_WITH_Y =
 					{
-						.Name = "ldx",
 						.AddressMode = eAddressMode::ABSOLUTE_INDEXED_WITH_Y,
 						.Opcode = 0xBE,
 						.Mnemonic = eMnemonic::LDX,
 					};
 					static constexpr const InstructionInfo IMMEDIATE =
 					{
-						.Name = "ldx",
 						.AddressMode = eAddressMode::IMMEDIATE,
 						.Opcode = 0xA2,
 						.Mnemonic = eMnemonic::LDX,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE =
 					{
-						.Name = "ldx",
 						.AddressMode = eAddressMode::ZERO_PAGE,
 						.Opcode = 0xA6,
 						.Mnemonic = eMnemonic::LDX,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE_INDEXED_WITH_Y =
 					{
-						.Name = "ldx",
 						.AddressMode = eAddressMode::ZERO_PAGE_INDEXED_WITH_Y,
 						.Opcode = 0xB6,
 						.Mnemonic = eMnemonic::LDX,
@@ -278,35 +292,30 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo ABSOLUTE =
 					{
-						.Name = "ldy",
 						.AddressMode = eAddressMode::ABSOLUTE,
 						.Opcode = 0xAC,
 						.Mnemonic = eMnemonic::LDY,
 					};
 					static constexpr const InstructionInfo ABSOLUTE_INDEXED_WITH_X =
 					{
-						.Name = "ldy",
 						.AddressMode = eAddressMode::ABSOLUTE_INDEXED_WITH_X,
 						.Opcode = 0xBC,
 						.Mnemonic = eMnemonic::LDY,
 					};
 					static constexpr const InstructionInfo IMMEDIATE =
 					{
-						.Name = "ldy",
 						.AddressMode = eAddressMode::IMMEDIATE,
 						.Opcode = 0xA0,
 						.Mnemonic = eMnemonic::LDY,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE =
 					{
-						.Name = "ldy",
 						.AddressMode = eAddressMode::ZERO_PAGE,
 						.Opcode = 0xA4,
 						.Mnemonic = eMnemonic::LDY,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE_INDEXED_WITH_X =
 					{
-						.Name = "ldy",
 						.AddressMode = eAddressMode::ZERO_PAGE_INDEXED_WITH_X,
 						.Opcode = 0xB4,
 						.Mnemonic = eMnemonic::LDY,
@@ -316,49 +325,42 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo ABSOLUTE =
 					{
-						.Name = "sta",
 						.AddressMode = eAddressMode::ABSOLUTE,
 						.Opcode = 0x8D,
 						.Mnemonic = eMnemonic::STA,
 					};
 					static constexpr const InstructionInfo ABSOLUTE_INDEXED_WITH_X =
 					{
-						.Name = "sta",
 						.AddressMode = eAddressMode::ABSOLUTE_INDEXED_WITH_X,
 						.Opcode = 0x9D,
 						.Mnemonic = eMnemonic::STA,
 					};
 					static constexpr const InstructionInfo ABSOLUTE_INDEXED_WITH_Y =
 					{
-						.Name = "sta",
 						.AddressMode = eAddressMode::ABSOLUTE_INDEXED_WITH_Y,
 						.Opcode = 0x99,
 						.Mnemonic = eMnemonic::STA,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE =
 					{
-						.Name = "sta",
 						.AddressMode = eAddressMode::ZERO_PAGE,
 						.Opcode = 0x85,
 						.Mnemonic = eMnemonic::STA,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE_INDEXED_INDIRECT =
 					{
-						.Name = "sta",
 						.AddressMode = eAddressMode::ZERO_PAGE_INDEXED_INDIRECT,
 						.Opcode = 0x81,
 						.Mnemonic = eMnemonic::STA,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE_INDEXED_WITH_X =
 					{
-						.Name = "sta",
 						.AddressMode = eAddressMode::ZERO_PAGE_INDEXED_WITH_X,
 						.Opcode = 0x95,
 						.Mnemonic = eMnemonic::STA,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE_INDIRECT_INDEXED_WITH_Y =
 					{
-						.Name = "sta",
 						.AddressMode = eAddressMode::ZERO_PAGE_INDIRECT_INDEXED_WITH_Y,
 						.Opcode = 0x91,
 						.Mnemonic = eMnemonic::STA,
@@ -368,21 +370,18 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo ABSOLUTE =
 					{
-						.Name = "stx",
 						.AddressMode = eAddressMode::ABSOLUTE,
 						.Opcode = 0x8E,
 						.Mnemonic = eMnemonic::STX,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE =
 					{
-						.Name = "stx",
 						.AddressMode = eAddressMode::ZERO_PAGE,
 						.Opcode = 0x86,
 						.Mnemonic = eMnemonic::STX,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE_INDEXED_WITH_Y =
 					{
-						.Name = "stx",
 						.AddressMode = eAddressMode::ZERO_PAGE_INDEXED_WITH_Y,
 						.Opcode = 0x96,
 						.Mnemonic = eMnemonic::STX,
@@ -392,21 +391,18 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo ABSOLUTE =
 					{
-						.Name = "sty",
 						.AddressMode = eAddressMode::ABSOLUTE,
 						.Opcode = 0x8C,
 						.Mnemonic = eMnemonic::STY,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE =
 					{
-						.Name = "sty",
 						.AddressMode = eAddressMode::ZERO_PAGE,
 						.Opcode = 0x84,
 						.Mnemonic = eMnemonic::STY,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE_INDEXED_WITH_X =
 					{
-						.Name = "sty",
 						.AddressMode = eAddressMode::ZERO_PAGE_INDEXED_WITH_X,
 						.Opcode = 0x94,
 						.Mnemonic = eMnemonic::STY,
@@ -416,56 +412,48 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo ABSOLUTE =
 					{
-						.Name = "adc",
 						.AddressMode = eAddressMode::ABSOLUTE,
 						.Opcode = 0x6D,
 						.Mnemonic = eMnemonic::ADC,
 					};
 					static constexpr const InstructionInfo ABSOLUTE_INDEXED_WITH_X =
 					{
-						.Name = "adc",
 						.AddressMode = eAddressMode::ABSOLUTE_INDEXED_WITH_X,
 						.Opcode = 0x7D,
 						.Mnemonic = eMnemonic::ADC,
 					};
 					static constexpr const InstructionInfo ABSOLUTE_INDEXED_WITH_Y =
 					{
-						.Name = "adc",
 						.AddressMode = eAddressMode::ABSOLUTE_INDEXED_WITH_Y,
 						.Opcode = 0x79,
 						.Mnemonic = eMnemonic::ADC,
 					};
 					static constexpr const InstructionInfo IMMEDIATE =
 					{
-						.Name = "adc",
 						.AddressMode = eAddressMode::IMMEDIATE,
 						.Opcode = 0x69,
 						.Mnemonic = eMnemonic::ADC,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE =
 					{
-						.Name = "adc",
 						.AddressMode = eAddressMode::ZERO_PAGE,
 						.Opcode = 0x65,
 						.Mnemonic = eMnemonic::ADC,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE_INDEXED_INDIRECT =
 					{
-						.Name = "adc",
 						.AddressMode = eAddressMode::ZERO_PAGE_INDEXED_INDIRECT,
 						.Opcode = 0x61,
 						.Mnemonic = eMnemonic::ADC,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE_INDEXED_WITH_X =
 					{
-						.Name = "adc",
 						.AddressMode = eAddressMode::ZERO_PAGE_INDEXED_WITH_X,
 						.Opcode = 0x75,
 						.Mnemonic = eMnemonic::ADC,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE_INDIRECT_INDEXED_WITH_Y =
 					{
-						.Name = "adc",
 						.AddressMode = eAddressMode::ZERO_PAGE_INDIRECT_INDEXED_WITH_Y,
 						.Opcode = 0x71,
 						.Mnemonic = eMnemonic::ADC,
@@ -475,56 +463,48 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo ABSOLUTE =
 					{
-						.Name = "sbc",
 						.AddressMode = eAddressMode::ABSOLUTE,
 						.Opcode = 0xED,
 						.Mnemonic = eMnemonic::SBC,
 					};
 					static constexpr const InstructionInfo ABSOLUTE_INDEXED_WITH_X =
 					{
-						.Name = "sbc",
 						.AddressMode = eAddressMode::ABSOLUTE_INDEXED_WITH_X,
 						.Opcode = 0xFD,
 						.Mnemonic = eMnemonic::SBC,
 					};
 					static constexpr const InstructionInfo ABSOLUTE_INDEXED_WITH_Y =
 					{
-						.Name = "sbc",
 						.AddressMode = eAddressMode::ABSOLUTE_INDEXED_WITH_Y,
 						.Opcode = 0xF9,
 						.Mnemonic = eMnemonic::SBC,
 					};
 					static constexpr const InstructionInfo IMMEDIATE =
 					{
-						.Name = "sbc",
 						.AddressMode = eAddressMode::IMMEDIATE,
 						.Opcode = 0xE9,
 						.Mnemonic = eMnemonic::SBC,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE =
 					{
-						.Name = "sbc",
 						.AddressMode = eAddressMode::ZERO_PAGE,
 						.Opcode = 0xE5,
 						.Mnemonic = eMnemonic::SBC,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE_INDEXED_INDIRECT =
 					{
-						.Name = "sbc",
 						.AddressMode = eAddressMode::ZERO_PAGE_INDEXED_INDIRECT,
 						.Opcode = 0xE1,
 						.Mnemonic = eMnemonic::SBC,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE_INDEXED_WITH_X =
 					{
-						.Name = "sbc",
 						.AddressMode = eAddressMode::ZERO_PAGE_INDEXED_WITH_X,
 						.Opcode = 0xF5,
 						.Mnemonic = eMnemonic::SBC,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE_INDIRECT_INDEXED_WITH_Y =
 					{
-						.Name = "sbc",
 						.AddressMode = eAddressMode::ZERO_PAGE_INDIRECT_INDEXED_WITH_Y,
 						.Opcode = 0xF1,
 						.Mnemonic = eMnemonic::SBC,
@@ -534,28 +514,24 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo ABSOLUTE =
 					{
-						.Name = "inc",
 						.AddressMode = eAddressMode::ABSOLUTE,
 						.Opcode = 0xEE,
 						.Mnemonic = eMnemonic::INC,
 					};
 					static constexpr const InstructionInfo ABSOLUTE_INDEXED_WITH_X =
 					{
-						.Name = "inc",
 						.AddressMode = eAddressMode::ABSOLUTE_INDEXED_WITH_X,
 						.Opcode = 0xFE,
 						.Mnemonic = eMnemonic::INC,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE =
 					{
-						.Name = "inc",
 						.AddressMode = eAddressMode::ZERO_PAGE,
 						.Opcode = 0xE6,
 						.Mnemonic = eMnemonic::INC,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE_INDEXED_WITH_X =
 					{
-						.Name = "inc",
 						.AddressMode = eAddressMode::ZERO_PAGE_INDEXED_WITH_X,
 						.Opcode = 0xF6,
 						.Mnemonic = eMnemonic::INC,
@@ -565,7 +541,6 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo IMPLIED =
 					{
-						.Name = "inx",
 						.AddressMode = eAddressMode::IMPLIED,
 						.Opcode = 0xE8,
 						.Mnemonic = eMnemonic::INX,
@@ -575,7 +550,6 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo IMPLIED =
 					{
-						.Name = "iny",
 						.AddressMode = eAddressMode::IMPLIED,
 						.Opcode = 0xC8,
 						.Mnemonic = eMnemonic::INY,
@@ -585,28 +559,24 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo ABSOLUTE =
 					{
-						.Name = "dec",
 						.AddressMode = eAddressMode::ABSOLUTE,
 						.Opcode = 0xCE,
 						.Mnemonic = eMnemonic::DEC,
 					};
 					static constexpr const InstructionInfo ABSOLUTE_INDEXED_WITH_X =
 					{
-						.Name = "dec",
 						.AddressMode = eAddressMode::ABSOLUTE_INDEXED_WITH_X,
 						.Opcode = 0xDE,
 						.Mnemonic = eMnemonic::DEC,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE =
 					{
-						.Name = "dec",
 						.AddressMode = eAddressMode::ZERO_PAGE,
 						.Opcode = 0xC6,
 						.Mnemonic = eMnemonic::DEC,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE_INDEXED_WITH_X =
 					{
-						.Name = "dec",
 						.AddressMode = eAddressMode::ZERO_PAGE_INDEXED_WITH_X,
 						.Opcode = 0xD6,
 						.Mnemonic = eMnemonic::DEC,
@@ -616,7 +586,6 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo IMPLIED =
 					{
-						.Name = "dex",
 						.AddressMode = eAddressMode::IMPLIED,
 						.Opcode = 0xCA,
 						.Mnemonic = eMnemonic::DEX,
@@ -626,7 +595,6 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo IMPLIED =
 					{
-						.Name = "dey",
 						.AddressMode = eAddressMode::IMPLIED,
 						.Opcode = 0x88,
 						.Mnemonic = eMnemonic::DEY,
@@ -636,35 +604,30 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo ABSOLUTE =
 					{
-						.Name = "asl",
 						.AddressMode = eAddressMode::ABSOLUTE,
 						.Opcode = 0x0E,
 						.Mnemonic = eMnemonic::ASL,
 					};
 					static constexpr const InstructionInfo ABSOLUTE_INDEXED_WITH_X =
 					{
-						.Name = "asl",
 						.AddressMode = eAddressMode::ABSOLUTE_INDEXED_WITH_X,
 						.Opcode = 0x1E,
 						.Mnemonic = eMnemonic::ASL,
 					};
 					static constexpr const InstructionInfo ACCUMULATOR =
 					{
-						.Name = "asl",
 						.AddressMode = eAddressMode::ACCUMULATOR,
 						.Opcode = 0x0A,
 						.Mnemonic = eMnemonic::ASL,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE =
 					{
-						.Name = "asl",
 						.AddressMode = eAddressMode::ZERO_PAGE,
 						.Opcode = 0x06,
 						.Mnemonic = eMnemonic::ASL,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE_INDEXED_WITH_X =
 					{
-						.Name = "asl",
 						.AddressMode = eAddressMode::ZERO_PAGE_INDEXED_WITH_X,
 						.Opcode = 0x16,
 						.Mnemonic = eMnemonic::ASL,
@@ -674,35 +637,30 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo ABSOLUTE =
 					{
-						.Name = "lsr",
 						.AddressMode = eAddressMode::ABSOLUTE,
 						.Opcode = 0x4E,
 						.Mnemonic = eMnemonic::LSR,
 					};
 					static constexpr const InstructionInfo ABSOLUTE_INDEXED_WITH_X =
 					{
-						.Name = "lsr",
 						.AddressMode = eAddressMode::ABSOLUTE_INDEXED_WITH_X,
 						.Opcode = 0x5E,
 						.Mnemonic = eMnemonic::LSR,
 					};
 					static constexpr const InstructionInfo ACCUMULATOR =
 					{
-						.Name = "lsr",
 						.AddressMode = eAddressMode::ACCUMULATOR,
 						.Opcode = 0x4A,
 						.Mnemonic = eMnemonic::LSR,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE =
 					{
-						.Name = "lsr",
 						.AddressMode = eAddressMode::ZERO_PAGE,
 						.Opcode = 0x46,
 						.Mnemonic = eMnemonic::LSR,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE_INDEXED_WITH_X =
 					{
-						.Name = "lsr",
 						.AddressMode = eAddressMode::ZERO_PAGE_INDEXED_WITH_X,
 						.Opcode = 0x56,
 						.Mnemonic = eMnemonic::LSR,
@@ -712,35 +670,30 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo ABSOLUTE =
 					{
-						.Name = "rol",
 						.AddressMode = eAddressMode::ABSOLUTE,
 						.Opcode = 0x2E,
 						.Mnemonic = eMnemonic::ROL,
 					};
 					static constexpr const InstructionInfo ABSOLUTE_INDEXED_WITH_X =
 					{
-						.Name = "rol",
 						.AddressMode = eAddressMode::ABSOLUTE_INDEXED_WITH_X,
 						.Opcode = 0x3E,
 						.Mnemonic = eMnemonic::ROL,
 					};
 					static constexpr const InstructionInfo ACCUMULATOR =
 					{
-						.Name = "rol",
 						.AddressMode = eAddressMode::ACCUMULATOR,
 						.Opcode = 0x2A,
 						.Mnemonic = eMnemonic::ROL,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE =
 					{
-						.Name = "rol",
 						.AddressMode = eAddressMode::ZERO_PAGE,
 						.Opcode = 0x26,
 						.Mnemonic = eMnemonic::ROL,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE_INDEXED_WITH_X =
 					{
-						.Name = "rol",
 						.AddressMode = eAddressMode::ZERO_PAGE_INDEXED_WITH_X,
 						.Opcode = 0x36,
 						.Mnemonic = eMnemonic::ROL,
@@ -750,35 +703,30 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo ABSOLUTE =
 					{
-						.Name = "ror",
 						.AddressMode = eAddressMode::ABSOLUTE,
 						.Opcode = 0x6E,
 						.Mnemonic = eMnemonic::ROR,
 					};
 					static constexpr const InstructionInfo ABSOLUTE_INDEXED_WITH_X =
 					{
-						.Name = "ror",
 						.AddressMode = eAddressMode::ABSOLUTE_INDEXED_WITH_X,
 						.Opcode = 0x7E,
 						.Mnemonic = eMnemonic::ROR,
 					};
 					static constexpr const InstructionInfo ACCUMULATOR =
 					{
-						.Name = "ror",
 						.AddressMode = eAddressMode::ACCUMULATOR,
 						.Opcode = 0x6A,
 						.Mnemonic = eMnemonic::ROR,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE =
 					{
-						.Name = "ror",
 						.AddressMode = eAddressMode::ZERO_PAGE,
 						.Opcode = 0x66,
 						.Mnemonic = eMnemonic::ROR,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE_INDEXED_WITH_X =
 					{
-						.Name = "ror",
 						.AddressMode = eAddressMode::ZERO_PAGE_INDEXED_WITH_X,
 						.Opcode = 0x76,
 						.Mnemonic = eMnemonic::ROR,
@@ -788,56 +736,48 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo ABSOLUTE =
 					{
-						.Name = "and",
 						.AddressMode = eAddressMode::ABSOLUTE,
 						.Opcode = 0x2D,
 						.Mnemonic = eMnemonic::AND,
 					};
 					static constexpr const InstructionInfo ABSOLUTE_INDEXED_WITH_X =
 					{
-						.Name = "and",
 						.AddressMode = eAddressMode::ABSOLUTE_INDEXED_WITH_X,
 						.Opcode = 0x3D,
 						.Mnemonic = eMnemonic::AND,
 					};
 					static constexpr const InstructionInfo ABSOLUTE_INDEXED_WITH_Y =
 					{
-						.Name = "and",
 						.AddressMode = eAddressMode::ABSOLUTE_INDEXED_WITH_Y,
 						.Opcode = 0x39,
 						.Mnemonic = eMnemonic::AND,
 					};
 					static constexpr const InstructionInfo IMMEDIATE =
 					{
-						.Name = "and",
 						.AddressMode = eAddressMode::IMMEDIATE,
 						.Opcode = 0x29,
 						.Mnemonic = eMnemonic::AND,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE =
 					{
-						.Name = "and",
 						.AddressMode = eAddressMode::ZERO_PAGE,
 						.Opcode = 0x25,
 						.Mnemonic = eMnemonic::AND,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE_INDEXED_INDIRECT =
 					{
-						.Name = "and",
 						.AddressMode = eAddressMode::ZERO_PAGE_INDEXED_INDIRECT,
 						.Opcode = 0x21,
 						.Mnemonic = eMnemonic::AND,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE_INDEXED_WITH_X =
 					{
-						.Name = "and",
 						.AddressMode = eAddressMode::ZERO_PAGE_INDEXED_WITH_X,
 						.Opcode = 0x35,
 						.Mnemonic = eMnemonic::AND,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE_INDIRECT_INDEXED_WITH_Y =
 					{
-						.Name = "and",
 						.AddressMode = eAddressMode::ZERO_PAGE_INDIRECT_INDEXED_WITH_Y,
 						.Opcode = 0x31,
 						.Mnemonic = eMnemonic::AND,
@@ -847,56 +787,48 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo ABSOLUTE =
 					{
-						.Name = "ora",
 						.AddressMode = eAddressMode::ABSOLUTE,
 						.Opcode = 0x0D,
 						.Mnemonic = eMnemonic::ORA,
 					};
 					static constexpr const InstructionInfo ABSOLUTE_INDEXED_WITH_X =
 					{
-						.Name = "ora",
 						.AddressMode = eAddressMode::ABSOLUTE_INDEXED_WITH_X,
 						.Opcode = 0x1D,
 						.Mnemonic = eMnemonic::ORA,
 					};
 					static constexpr const InstructionInfo ABSOLUTE_INDEXED_WITH_Y =
 					{
-						.Name = "ora",
 						.AddressMode = eAddressMode::ABSOLUTE_INDEXED_WITH_Y,
 						.Opcode = 0x19,
 						.Mnemonic = eMnemonic::ORA,
 					};
 					static constexpr const InstructionInfo IMMEDIATE =
 					{
-						.Name = "ora",
 						.AddressMode = eAddressMode::IMMEDIATE,
 						.Opcode = 0x09,
 						.Mnemonic = eMnemonic::ORA,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE =
 					{
-						.Name = "ora",
 						.AddressMode = eAddressMode::ZERO_PAGE,
 						.Opcode = 0x05,
 						.Mnemonic = eMnemonic::ORA,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE_INDEXED_INDIRECT =
 					{
-						.Name = "ora",
 						.AddressMode = eAddressMode::ZERO_PAGE_INDEXED_INDIRECT,
 						.Opcode = 0x01,
 						.Mnemonic = eMnemonic::ORA,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE_INDEXED_WITH_X =
 					{
-						.Name = "ora",
 						.AddressMode = eAddressMode::ZERO_PAGE_INDEXED_WITH_X,
 						.Opcode = 0x15,
 						.Mnemonic = eMnemonic::ORA,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE_INDIRECT_INDEXED_WITH_Y =
 					{
-						.Name = "ora",
 						.AddressMode = eAddressMode::ZERO_PAGE_INDIRECT_INDEXED_WITH_Y,
 						.Opcode = 0x11,
 						.Mnemonic = eMnemonic::ORA,
@@ -906,56 +838,48 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo ABSOLUTE =
 					{
-						.Name = "eor",
 						.AddressMode = eAddressMode::ABSOLUTE,
 						.Opcode = 0x4D,
 						.Mnemonic = eMnemonic::EOR,
 					};
 					static constexpr const InstructionInfo ABSOLUTE_INDEXED_WITH_X =
 					{
-						.Name = "eor",
 						.AddressMode = eAddressMode::ABSOLUTE_INDEXED_WITH_X,
 						.Opcode = 0x5D,
 						.Mnemonic = eMnemonic::EOR,
 					};
 					static constexpr const InstructionInfo ABSOLUTE_INDEXED_WITH_Y =
 					{
-						.Name = "eor",
 						.AddressMode = eAddressMode::ABSOLUTE_INDEXED_WITH_Y,
 						.Opcode = 0x59,
 						.Mnemonic = eMnemonic::EOR,
 					};
 					static constexpr const InstructionInfo IMMEDIATE =
 					{
-						.Name = "eor",
 						.AddressMode = eAddressMode::IMMEDIATE,
 						.Opcode = 0x49,
 						.Mnemonic = eMnemonic::EOR,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE =
 					{
-						.Name = "eor",
 						.AddressMode = eAddressMode::ZERO_PAGE,
 						.Opcode = 0x45,
 						.Mnemonic = eMnemonic::EOR,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE_INDEXED_INDIRECT =
 					{
-						.Name = "eor",
 						.AddressMode = eAddressMode::ZERO_PAGE_INDEXED_INDIRECT,
 						.Opcode = 0x41,
 						.Mnemonic = eMnemonic::EOR,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE_INDEXED_WITH_X =
 					{
-						.Name = "eor",
 						.AddressMode = eAddressMode::ZERO_PAGE_INDEXED_WITH_X,
 						.Opcode = 0x55,
 						.Mnemonic = eMnemonic::EOR,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE_INDIRECT_INDEXED_WITH_Y =
 					{
-						.Name = "eor",
 						.AddressMode = eAddressMode::ZERO_PAGE_INDIRECT_INDEXED_WITH_Y,
 						.Opcode = 0x51,
 						.Mnemonic = eMnemonic::EOR,
@@ -965,56 +889,48 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo ABSOLUTE =
 					{
-						.Name = "cmp",
 						.AddressMode = eAddressMode::ABSOLUTE,
 						.Opcode = 0xCD,
 						.Mnemonic = eMnemonic::CMP,
 					};
 					static constexpr const InstructionInfo ABSOLUTE_INDEXED_WITH_X =
 					{
-						.Name = "cmp",
 						.AddressMode = eAddressMode::ABSOLUTE_INDEXED_WITH_X,
 						.Opcode = 0xDD,
 						.Mnemonic = eMnemonic::CMP,
 					};
 					static constexpr const InstructionInfo ABSOLUTE_INDEXED_WITH_Y =
 					{
-						.Name = "cmp",
 						.AddressMode = eAddressMode::ABSOLUTE_INDEXED_WITH_Y,
 						.Opcode = 0xD9,
 						.Mnemonic = eMnemonic::CMP,
 					};
 					static constexpr const InstructionInfo IMMEDIATE =
 					{
-						.Name = "cmp",
 						.AddressMode = eAddressMode::IMMEDIATE,
 						.Opcode = 0xC9,
 						.Mnemonic = eMnemonic::CMP,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE =
 					{
-						.Name = "cmp",
 						.AddressMode = eAddressMode::ZERO_PAGE,
 						.Opcode = 0xC5,
 						.Mnemonic = eMnemonic::CMP,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE_INDEXED_INDIRECT =
 					{
-						.Name = "cmp",
 						.AddressMode = eAddressMode::ZERO_PAGE_INDEXED_INDIRECT,
 						.Opcode = 0xC1,
 						.Mnemonic = eMnemonic::CMP,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE_INDEXED_WITH_X =
 					{
-						.Name = "cmp",
 						.AddressMode = eAddressMode::ZERO_PAGE_INDEXED_WITH_X,
 						.Opcode = 0xD5,
 						.Mnemonic = eMnemonic::CMP,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE_INDIRECT_INDEXED_WITH_Y =
 					{
-						.Name = "cmp",
 						.AddressMode = eAddressMode::ZERO_PAGE_INDIRECT_INDEXED_WITH_Y,
 						.Opcode = 0xD1,
 						.Mnemonic = eMnemonic::CMP,
@@ -1024,21 +940,18 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo ABSOLUTE =
 					{
-						.Name = "cpx",
 						.AddressMode = eAddressMode::ABSOLUTE,
 						.Opcode = 0xEC,
 						.Mnemonic = eMnemonic::CPX,
 					};
 					static constexpr const InstructionInfo IMMEDIATE =
 					{
-						.Name = "cpx",
 						.AddressMode = eAddressMode::IMMEDIATE,
 						.Opcode = 0xE0,
 						.Mnemonic = eMnemonic::CPX,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE =
 					{
-						.Name = "cpx",
 						.AddressMode = eAddressMode::ZERO_PAGE,
 						.Opcode = 0xE4,
 						.Mnemonic = eMnemonic::CPX,
@@ -1048,21 +961,18 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo ABSOLUTE =
 					{
-						.Name = "cpy",
 						.AddressMode = eAddressMode::ABSOLUTE,
 						.Opcode = 0xCC,
 						.Mnemonic = eMnemonic::CPY,
 					};
 					static constexpr const InstructionInfo IMMEDIATE =
 					{
-						.Name = "cpy",
 						.AddressMode = eAddressMode::IMMEDIATE,
 						.Opcode = 0xC0,
 						.Mnemonic = eMnemonic::CPY,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE =
 					{
-						.Name = "cpy",
 						.AddressMode = eAddressMode::ZERO_PAGE,
 						.Opcode = 0xC4,
 						.Mnemonic = eMnemonic::CPY,
@@ -1072,21 +982,18 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo ABSOLUTE =
 					{
-						.Name = "bit",
 						.AddressMode = eAddressMode::ABSOLUTE,
 						.Opcode = 0x2C,
 						.Mnemonic = eMnemonic::BIT,
 					};
 					static constexpr const InstructionInfo IMMEDIATE =
 					{
-						.Name = "bit",
 						.AddressMode = eAddressMode::IMMEDIATE,
 						.Opcode = 0x89,
 						.Mnemonic = eMnemonic::BIT,
 					};
 					static constexpr const InstructionInfo ZERO_PAGE =
 					{
-						.Name = "bit",
 						.AddressMode = eAddressMode::ZERO_PAGE,
 						.Opcode = 0x24,
 						.Mnemonic = eMnemonic::BIT,
@@ -1096,7 +1003,6 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo RELATIVE =
 					{
-						.Name = "bcc",
 						.AddressMode = eAddressMode::RELATIVE,
 						.Opcode = 0x90,
 						.Mnemonic = eMnemonic::BCC,
@@ -1106,7 +1012,6 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo RELATIVE =
 					{
-						.Name = "bcs",
 						.AddressMode = eAddressMode::RELATIVE,
 						.Opcode = 0xB0,
 						.Mnemonic = eMnemonic::BCS,
@@ -1115,7 +1020,6 @@ namespace ninmuse
 				struct Bne
 				{
 					static constexpr const InstructionInfo RELATIVE = {
-						.Name = "bne",
 						.AddressMode = eAddressMode::RELATIVE,
 						.Opcode = 0xD0,
 						.Mnemonic = eMnemonic::BNE,
@@ -1125,7 +1029,6 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo RELATIVE =
 					{
-						.Name = "beq",
 						.AddressMode = eAddressMode::RELATIVE,
 						.Opcode = 0xF0,
 						.Mnemonic = eMnemonic::BEQ,
@@ -1135,7 +1038,6 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo RELATIVE =
 					{
-						.Name = "bpl",
 						.AddressMode = eAddressMode::RELATIVE,
 						.Opcode = 0x10,
 						.Mnemonic = eMnemonic::BPL,
@@ -1145,7 +1047,6 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo RELATIVE =
 					{
-						.Name = "bmi",
 						.AddressMode = eAddressMode::RELATIVE,
 						.Opcode = 0x30,
 						.Mnemonic = eMnemonic::BMI,
@@ -1155,7 +1056,6 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo RELATIVE =
 					{
-						.Name = "bvc",
 						.AddressMode = eAddressMode::RELATIVE,
 						.Opcode = 0x50,
 						.Mnemonic = eMnemonic::BVC,
@@ -1165,7 +1065,6 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo RELATIVE =
 					{
-						.Name = "bvs",
 						.AddressMode = eAddressMode::RELATIVE,
 						.Opcode = 0x70,
 						.Mnemonic = eMnemonic::BVS,
@@ -1175,7 +1074,6 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo IMPLIED =
 					{
-						.Name = "tax",
 						.AddressMode = eAddressMode::IMPLIED,
 						.Opcode = 0xAA,
 						.Mnemonic = eMnemonic::TAX,
@@ -1185,7 +1083,6 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo IMPLIED =
 					{
-						.Name = "txa",
 						.AddressMode = eAddressMode::IMPLIED,
 						.Opcode = 0x8A,
 						.Mnemonic = eMnemonic::TXA,
@@ -1195,7 +1092,6 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo IMPLIED =
 					{
-						.Name = "tay",
 						.AddressMode = eAddressMode::IMPLIED,
 						.Opcode = 0xA8,
 						.Mnemonic = eMnemonic::TAY,
@@ -1205,7 +1101,6 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo IMPLIED =
 					{
-						.Name = "tya",
 						.AddressMode = eAddressMode::IMPLIED,
 						.Opcode = 0x98,
 						.Mnemonic = eMnemonic::TYA,
@@ -1215,7 +1110,6 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo IMPLIED =
 					{
-						.Name = "tsx",
 						.AddressMode = eAddressMode::IMPLIED,
 						.Opcode = 0xBA,
 						.Mnemonic = eMnemonic::TSX,
@@ -1225,7 +1119,6 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo IMPLIED =
 					{
-						.Name = "txs",
 						.AddressMode = eAddressMode::IMPLIED,
 						.Opcode = 0x9A,
 						.Mnemonic = eMnemonic::TXS,
@@ -1235,7 +1128,6 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo IMPLIED =
 					{
-						.Name = "pha",
 						.AddressMode = eAddressMode::IMPLIED,
 						.Opcode = 0x48,
 						.Mnemonic = eMnemonic::PHA,
@@ -1245,7 +1137,6 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo IMPLIED =
 					{
-						.Name = "pla",
 						.AddressMode = eAddressMode::IMPLIED,
 						.Opcode = 0x68,
 						.Mnemonic = eMnemonic::PLA,
@@ -1255,7 +1146,6 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo IMPLIED =
 					{
-						.Name = "php",
 						.AddressMode = eAddressMode::IMPLIED,
 						.Opcode = 0x08,
 						.Mnemonic = eMnemonic::PHP,
@@ -1265,7 +1155,6 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo IMPLIED =
 					{
-						.Name = "plp",
 						.AddressMode = eAddressMode::IMPLIED,
 						.Opcode = 0x28,
 						.Mnemonic = eMnemonic::PLP,
@@ -1275,14 +1164,12 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo ABSOLUTE =
 					{
-						.Name = "jmp",
 						.AddressMode = eAddressMode::ABSOLUTE,
 						.Opcode = 0x4C,
 						.Mnemonic = eMnemonic::JMP,
 					};
 					static constexpr const InstructionInfo ABSOLUTE_INDIRECT =
 					{
-						.Name = "jmp",
 						.AddressMode = eAddressMode::ABSOLUTE_INDIRECT,
 						.Opcode = 0x6C,
 						.Mnemonic = eMnemonic::JMP,
@@ -1292,7 +1179,6 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo ABSOLUTE =
 					{
-						.Name = "jsr",
 						.AddressMode = eAddressMode::ABSOLUTE,
 						.Opcode = 0x20,
 						.Mnemonic = eMnemonic::JSR,
@@ -1302,7 +1188,6 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo IMPLIED =
 					{
-						.Name = "rts",
 						.AddressMode = eAddressMode::IMPLIED,
 						.Opcode = 0x60,
 						.Mnemonic = eMnemonic::RTS,
@@ -1312,7 +1197,6 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo IMPLIED =
 					{
-						.Name = "rti",
 						.AddressMode = eAddressMode::IMPLIED,
 						.Opcode = 0x40,
 						.Mnemonic = eMnemonic::RTI,
@@ -1322,7 +1206,6 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo IMPLIED =
 					{
-						.Name = "clc",
 						.AddressMode = eAddressMode::IMPLIED,
 						.Opcode = 0x18,
 						.Mnemonic = eMnemonic::CLC,
@@ -1332,7 +1215,6 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo IMPLIED =
 					{
-						.Name = "sec",
 						.AddressMode = eAddressMode::IMPLIED,
 						.Opcode = 0x38,
 						.Mnemonic = eMnemonic::SEC,
@@ -1342,7 +1224,6 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo IMPLIED =
 					{
-						.Name = "cld",
 						.AddressMode = eAddressMode::IMPLIED,
 						.Opcode = 0xD8,
 						.Mnemonic = eMnemonic::CLD,
@@ -1352,7 +1233,6 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo IMPLIED =
 					{
-						.Name = "sed",
 						.AddressMode = eAddressMode::IMPLIED,
 						.Opcode = 0xF8,
 						.Mnemonic = eMnemonic::SED,
@@ -1362,7 +1242,6 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo IMPLIED =
 					{
-						.Name = "cli",
 						.AddressMode = eAddressMode::IMPLIED,
 						.Opcode = 0x58,
 						.Mnemonic = eMnemonic::CLI,
@@ -1372,7 +1251,6 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo IMPLIED =
 					{
-						.Name = "sei",
 						.AddressMode = eAddressMode::IMPLIED,
 						.Opcode = 0x78,
 						.Mnemonic = eMnemonic::SEI,
@@ -1382,7 +1260,6 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo IMPLIED =
 					{
-						.Name = "clv",
 						.AddressMode = eAddressMode::IMPLIED,
 						.Opcode = 0xB8,
 						.Mnemonic = eMnemonic::CLV,
@@ -1392,7 +1269,6 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo IMPLIED =
 					{
-						.Name = "brk",
 						.AddressMode = eAddressMode::IMPLIED,
 						.Opcode = 0x00,
 						.Mnemonic = eMnemonic::BRK,
@@ -1402,7 +1278,6 @@ namespace ninmuse
 				{
 					static constexpr const InstructionInfo IMPLIED =
 					{
-						.Name = "nop",
 						.AddressMode = eAddressMode::IMPLIED,
 						.Opcode = 0xEA,
 						.Mnemonic = eMnemonic::NOP,
@@ -1422,15 +1297,12 @@ namespace ninmuse
 					data_t	Value;
 					struct StatusBits
 					{
-					public:
 						bool CarryFlag				: 1;
 						bool ZeroFlag				: 1;
 						bool InterruptDisableFlag	: 1;
 						bool DecimalModeFlag		: 1;
 						bool BreakCommandFlag		: 1;
-					private:
 						bool Padding				: 1;
-					public:
 						bool OverflowFlag			: 1;
 						bool NegativeFlag			: 1;
 					} StatusBits;
@@ -1450,6 +1322,8 @@ namespace ninmuse
 				JRS_NONE,
 				SAVE_PROGRAM_COUNTER_HIGH_TO_RAM,
 				SAVE_PROGRAM_COUNTER_LOW_TO_RAM,
+				SAVE_STATUS_TO_RAM_FOR_INTERRUPT,	// Also masks IRQs and points the program counter at the vector
+				FETCH_STATUS_FROM_RAM,
 				RTS_NONE,
 				NEXT,
 			};
@@ -1477,13 +1351,46 @@ namespace ninmuse
 
 			struct CycleJob
 			{
-				const eAddressBusType	AddressBusType;
+				eAddressBusType			AddressBusType = eAddressBusType::PROGRAM_COUNTER;
 				bool					IncrementProgramCounter = true;
 				eExternalMode			ExternalOperation = eExternalMode::FETCH_OPCODE;
 				eInternalMode			InternalOperation = eInternalMode::NONE;
 			};
 
+		public:
+			// Every mutable field of the CPU. It is owned by the console state, not by Cpu6502,
+			// so the console can be snapshotted and cloned as one trivially copyable block.
+			// The first cache line holds everything processSingleClock() touches; the second is cold.
+			struct alignas( CACHE_LINE_SIZE ) State final
+			{
+				static constexpr const size_t MAX_PENDING_CYCLE_JOBS = 8;
+
+				// Hot
+				Cpu6502::Registers		Registers = {};
+				address_t				AddressBus = 0;
+				data_t					DataBus = 0;
+				data_t					DataToDecode = 0;
+				StaticQueue<CycleJob, MAX_PENDING_CYCLE_JOBS>
+										CycleJobs;
+				Cpu6502::ExecutionInfo	ExecutionInfo;
+				bool					InterruptRequestBar = true;		// IRQ pin, low while any source asserts it
+				bool					NonMaskableInterruptBar = true;	// NMI pin; only its falling edge counts
+				bool					IsNmiPending = false;			// A falling edge not serviced yet
+
+				// Cold
+				alignas( CACHE_LINE_SIZE ) uint64_t
+										Clock = 1;	// Only used for tracing
+			};
+
 		protected:
+			struct DecodeTable final
+			{
+				DecodeEntry	Entries[256];
+
+				inline constexpr const DecodeEntry&	operator[]( const data_t opcode ) const noexcept { return Entries[opcode]; }
+			};
+
+			// Source of DECODE_TABLE. Only read at compile time, so the scattered InstructionInfos never reach the decoder.
 			static constexpr const InstructionInfo* const INSTRUCTION_TABLE[] =
 			{
 				&Instruction::Brk::IMPLIED, // 0x00
@@ -1744,44 +1651,80 @@ namespace ninmuse
 				nullptr, // 0xFF
 			};
 
+			static_assert( ARRAYSIZE( INSTRUCTION_TABLE ) == ARRAYSIZE( DecodeTable::Entries ) );
+
+			// Dense table indexed by opcode: 512 bytes, eight cache lines. Built at compile time from INSTRUCTION_TABLE.
+			static const DecodeTable DECODE_TABLE;
+
 			static constexpr const data_t STACK_PAGE_ADDRESS_HI = 0x01;
+			static constexpr const address_t NMI_VECTOR_ADDRESS = 0xFFFA;
+			static constexpr const address_t IRQ_VECTOR_ADDRESS = 0xFFFE;
 
 			static constexpr const size_t		BUFFER_SIZE = 64;
 			static constexpr const char* const	EMPTY_BYTE = "..";
 			static constexpr const char* const	HEX_CHAR_TABLE = "0123456789ABCDEF";
 
+			// Cold side table for tracing and disassembly, indexed by eMnemonic
+			static constexpr const char* const	MNEMONIC_NAMES[] =
+			{
+				"adc", "and", "asl", "bcc", "bcs", "beq", "bit", "bmi", "bne", "bpl", "brk", "bvc", "bvs", "clc",
+				"cld", "cli", "clv", "cmp", "cpx", "cpy", "dec", "dex", "dey", "eor", "inc", "inx", "iny", "jmp",
+				"jsr", "lda", "ldx", "ldy", "lsr", "nop", "ora", "pha", "php", "pla", "plp", "rol", "ror", "rti",
+				"rts", "sbc", "sec", "sed", "sei", "sta", "stx", "sty", "tax", "tay", "tsx", "txa", "txs", "tya",
+			};
+			static_assert( ARRAYSIZE( MNEMONIC_NAMES ) == static_cast< size_t >( eMnemonic::COUNT ) );
+
 		protected:
 			static constexpr const char*	convertAddressModeToString( const eAddressMode addressMode ) noexcept;
+			static inline constexpr const char*
+											getMnemonicName( const eMnemonic mnemonic ) noexcept { return MNEMONIC_NAMES[static_cast< size_t >( mnemonic )]; }
 			static constexpr size_t			getRequiredOperandNumBytes( const eAddressMode addressMode ) noexcept;
+			static constexpr bool			isStore( const eMnemonic mnemonic ) noexcept;
+			static constexpr bool			isReadModifyWrite( const eMnemonic mnemonic ) noexcept;
+			static constexpr uint8_t		getBaseCycles( const eMnemonic mnemonic, const eAddressMode addressMode ) noexcept;
+			static constexpr bool			hasPageCrossPenalty( const eMnemonic mnemonic, const eAddressMode addressMode ) noexcept;
+			static constexpr DecodeTable	buildDecodeTable() noexcept;
 
 		protected:
 			void			decode( bool& inoutSkipFetch ) noexcept;
+			inline bool		isInterruptPending() const noexcept { return mState.IsNmiPending || ( mState.InterruptRequestBar == false && mState.Registers.Status.StatusBits.InterruptDisableFlag == false ); }
+			void			beginInterrupt() noexcept;
 			constexpr const data_t* disassemble( char* out_buffer64, const data_t* mem ) noexcept;
 			constexpr bool			execute() noexcept;
 			void					processSingleClock() noexcept;
 
 		protected:
-			const Cartridge*	mRomOrNull;
-			Registers			mRegisters;
+			Mapper*				mMapperOrNull;
+			Ppu*				mPpuOrNull;
+			State&				mState;
 
-			eExternalMode			mCurrentInternalMode;
-			eInternalMode		mCurrentExternalMode;
-			bool				mReadRam;
-			address_t			mAddressBus;
-			data_t				mDataBus;
-			data_t				mDataToDecode;
-			size_t				mDecodeCounter;
-			ExecutionInfo		mExecutionInfo;
 
-			size_t				mJumpSubroutineClock;
-			std::queue<CycleJob>	mCycleJobs;
+		private:
+			// State layout
+			static_assert( std::is_trivially_copyable_v<State> );
+			static_assert( std::is_standard_layout_v<State> );
+			static_assert( sizeof( DecodeEntry ) == 2 );
+			static_assert( sizeof( DecodeTable ) == 8 * CACHE_LINE_SIZE );
+			static_assert( static_cast< size_t >( eMnemonic::COUNT ) < ( 1 << 6 ) && static_cast< size_t >( eAddressMode::COUNT ) < ( 1 << 4 ) );
+			static_assert( sizeof( Registers ) == 8 );
+			static_assert( sizeof( CycleJob ) == 4 );
+			static_assert( sizeof( ExecutionInfo ) == 6 );
+			static_assert( offsetof( State, Registers ) == 0 );
+			static_assert( offsetof( State, AddressBus ) == 8 );
+			static_assert( offsetof( State, DataBus ) == 10 );
+			static_assert( offsetof( State, DataToDecode ) == 11 );
+			static_assert( offsetof( State, CycleJobs ) == 12 );
+			static_assert( offsetof( State, ExecutionInfo ) == 46 );
+			static_assert( offsetof( State, IsNmiPending ) + sizeof( bool ) <= CACHE_LINE_SIZE, "Hot CPU state must fit in one cache line!!" );
+			static_assert( offsetof( State, Clock ) == CACHE_LINE_SIZE );
+			static_assert( sizeof( State ) == 2 * CACHE_LINE_SIZE );
 		};
 
 		class CpuNes : public Cpu6502
 		{
 		public:
 			CpuNes() = delete;
-			inline CpuNes( NesRam& ram, const Cartridge* cartridgeOrNull ) noexcept : Cpu6502( ram, cartridgeOrNull ) {}
+			inline CpuNes( NesRam& ram, Mapper* mapperOrNull, State& state ) noexcept : Cpu6502( ram, mapperOrNull, state ) {}
 			CpuNes( const CpuNes& ) = delete;
 			explicit CpuNes( CpuNes&& ) noexcept = default;
 			virtual ~CpuNes() = default;
@@ -0,0 +1,151 @@
+#include "stdafx.h"
+
+#include "NES/DeferredRenderer.h"
+#include "NES/DynamicArray.hpp"
+
+namespace ninmuse
+{
+	namespace nes
+	{
+		DeferredRenderer::DeferredRenderer( const std::shared_ptr<const RomImage>& romImage, const CartridgeRamState& cartridgeRam ) noexcept
+			: mRomImage( romImage )
+			, mCartridgeRam( cartridgeRam )	// The copy starts from the console's CHR-RAM and then follows the logged writes
+			, mMapperState()
+			, mMapper( *mRomImage, mMapperState, mCartridgeRam )
+			, mPpuState()
+			, mArena( Ppu::GetRequiredArenaSize() )
+			, mPpu( mPpuState, mArena )
+			, mFrameLogs()
+			, mFinishedFramebuffer()
+			, mMutex()
+			, mCondition()
+			, mNumSubmittedFrames( 0 )
+			, mNumFinishedFrames( 0 )
+			, mWorker()
+		{
+			mPpu.SetMapper( mMapper );
+			mFinishedFramebuffer.SetSize( Ppu::FRAME_SIZE );
+			mWorker = std::jthread( [this]( std::stop_token stopToken ) noexcept { renderFrames( stopToken ); } );
+		}
+
+		DeferredRenderer::~DeferredRenderer() noexcept
+		{
+			mWorker.request_stop();
+			mCondition.notify_all();
+		}
+
+		PpuFrameLog& DeferredRenderer::BeginFrame( const PpuState& ppuState, const MapperState& mapperState ) noexcept
+		{
+			std::unique_lock<std::mutex> lock( mMutex );
+			mCondition.wait( lock, [this]() noexcept { return mNumSubmittedFrames - mNumFinishedFrames < NUM_FRAME_LOGS; } );
+
+			PpuFrameLog& log = mFrameLogs[mNumSubmittedFrames % NUM_FRAME_LOGS];
+			memcpy( &log.StartState, &ppuState, sizeof( PpuState ) );
+			memcpy( &log.StartMapperState, &mapperState, sizeof( MapperState ) );
+			log.EndClock = ppuState.Clock;
+			log.Events.Clear();
+			log.OamPages.Clear();
+			return log;
+		}
+
+		void DeferredRenderer::EndFrame( const uint64_t endClock ) noexcept
+		{
+			{
+				const std::lock_guard<std::mutex> lock( mMutex );
+				mFrameLogs[mNumSubmittedFrames % NUM_FRAME_LOGS].EndClock = endClock;
+				++mNumSubmittedFrames;
+			}
+			mCondition.notify_all();
+		}
+
+		void DeferredRenderer::Flush() noexcept
+		{
+			std::unique_lock<std::mutex> lock( mMutex );
+			mCondition.wait( lock, [this]() noexcept { return mNumFinishedFrames == mNumSubmittedFrames; } );
+		}
+
+		void DeferredRenderer::LoadCharacterRam( const CartridgeRamState& cartridgeRam ) noexcept
+		{
+			// The worker reads the copy until it has drawn every frame it was given
+			Flush();
+			memcpy( mCartridgeRam.CharacterRam, cartridgeRam.CharacterRam, sizeof( mCartridgeRam.CharacterRam ) );
+			mMapper.InvalidateCharacterRam();
+		}
+
+		uint64_t DeferredRenderer::ReadFramebuffer( data_t* outFramebuffer ) const noexcept
+		{
+			const std::lock_guard<std::mutex> lock( mMutex );
+			memcpy( outFramebuffer, mFinishedFramebuffer.GetData(), Ppu::FRAME_SIZE );
+			return mNumFinishedFrames;
+		}
+
+		void DeferredRenderer::renderFrames( std::stop_token stopToken ) noexcept
+		{
+			while ( true )
+			{
+				const PpuFrameLog* log = nullptr;
+				{
+					std::unique_lock<std::mutex> lock( mMutex );
+					if ( mCondition.wait( lock, stopToken, [this]() noexcept { return mNumFinishedFrames < mNumSubmittedFrames; } ) == false )
+					{
+						return;
+					}
+					log = &mFrameLogs[mNumFinishedFrames % NUM_FRAME_LOGS];
+				}
+
+				// The emulation thread only touches the other log until this frame is marked finished
+				replay( *log );
+
+				{
+					const std::lock_guard<std::mutex> lock( mMutex );
+					memcpy( mFinishedFramebuffer.GetData(), mPpu.GetFramebuffer(), Ppu::FRAME_SIZE );
+					++mNumFinishedFrames;
+				}
+				mCondition.notify_all();
+			}
+		}
+
+		void DeferredRenderer::replay( const PpuFrameLog& log ) noexcept
+		{
+			// Start from exactly where the emulation thread started the frame, then redo its accesses at the same PPU clocks.
+			// Normally that is where the last frame left off; only a loaded state changes the nametables or OAM under the caches.
+			const bool isStateReplaced = memcmp( mPpuState.NametableRam, log.StartState.NametableRam, sizeof( mPpuState.NametableRam ) ) != 0
+				|| memcmp( mPpuState.Oam, log.StartState.Oam, sizeof( mPpuState.Oam ) ) != 0;
+			memcpy( &mPpuState, &log.StartState, sizeof( PpuState ) );
+			memcpy( &mMapperState, &log.StartMapperState, sizeof( MapperState ) );
+			mMapper.Update();
+			if ( isStateReplaced )
+			{
+				mPpu.Update();
+			}
+
+			for ( size_t eventIndex = 0; eventIndex < log.Events.GetSize(); ++eventIndex )
+			{
+				const PpuEvent& event = log.Events[eventIndex];
+				NM_ASSERT( event.Clock >= mPpuState.Clock, "Events are out of order!!" );
+				mPpu.Run<ePpuAccuracy::SCANLINE>( event.Clock - mPpuState.Clock );
+
+				switch ( event.Type )
+				{
+				case ePpuEventType::REGISTER_READ:
+					mPpu.ReadRegister( event.Address );
+					break;
+				case ePpuEventType::REGISTER_WRITE:
+					mPpu.WriteRegister( event.Address, event.Data );
+					break;
+				case ePpuEventType::OAM_DMA:
+					mPpu.WriteOam( log.OamPages.GetData() + event.Address );
+					break;
+				case ePpuEventType::MAPPER_WRITE:
+					mMapper.WriteProgram( event.Address, event.Data );
+					break;
+				default:
+					NM_ASSERT( false, "Invalid PPU event!!" );
+					break;
+				}
+			}
+
+			mPpu.Run<ePpuAccuracy::SCANLINE>( log.EndClock - mPpuState.Clock );
+		}
+	}
+}
\ No newline at end of file
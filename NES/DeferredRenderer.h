@@ -0,0 +1,101 @@
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "NES/Cartridge.h"
+#include "NES/DynamicArray.h"
+#include "NES/Mapper.h"
+#include "NES/Ppu.h"
+
+namespace ninmuse
+{
+	namespace nes
+	{
+		enum class ePpuEventType : uint8_t
+		{
+			REGISTER_READ,	// $2002 and $2007 reads, which move the write toggle, the VRAM address and the read buffer
+			REGISTER_WRITE,
+			OAM_DMA,
+			MAPPER_WRITE,	// CHR banks, mirroring and the scanline counter
+			COUNT,
+		};
+
+		// One CPU access that changed what the PPU draws, at the PPU clock it happened
+		struct PpuEvent final
+		{
+			uint64_t		Clock;
+			address_t		Address;	// For OAM_DMA, the offset of the page in PpuFrameLog::OamPages
+			data_t			Data;
+			ePpuEventType	Type;
+		};
+		static_assert( sizeof( PpuEvent ) == 16 );
+
+		// Everything needed to draw one frame again: the PPU and mapper state it started from and every access after that
+		struct PpuFrameLog final
+		{
+			PpuState				StartState;
+			MapperState				StartMapperState;
+			uint64_t				EndClock = 0;
+			DynamicArray<PpuEvent>	Events;
+			DynamicArray<data_t>	OamPages;
+		};
+
+		// Draws frames on a worker thread, one frame behind the emulation. The emulation thread runs its PPU without drawing:
+		// it still sets every status flag, sprite 0 hit and overflow included, so the CPU sees what it would have, and logs
+		// every access that changes the picture. The worker replays the log on a PPU and mapper of its own, with its own copy
+		// of the CHR-RAM, so both threads reach the same pixels without sharing anything mutable.
+		// Only the scanline engine is deferred; the dot engine draws as it goes.
+		class DeferredRenderer final
+		{
+		public:
+			DeferredRenderer() = delete;
+			// Copies the CHR-RAM as it is now; create the renderer before the first frame it draws
+			DeferredRenderer( const std::shared_ptr<const RomImage>& romImage, const CartridgeRamState& cartridgeRam ) noexcept;
+			DeferredRenderer( const DeferredRenderer& ) = delete;
+			DeferredRenderer( DeferredRenderer&& ) = delete;
+			~DeferredRenderer() noexcept;
+
+			DeferredRenderer& operator=( const DeferredRenderer& ) = delete;
+			DeferredRenderer& operator=( DeferredRenderer&& ) = delete;
+
+		public:
+			// Emulation thread. The log of the next frame, once the worker is done with the frame that used it before
+			PpuFrameLog&			BeginFrame( const PpuState& ppuState, const MapperState& mapperState ) noexcept;
+			void					EndFrame( const uint64_t endClock ) noexcept;
+			// Waits until every frame handed over so far is drawn
+			void					Flush() noexcept;
+			// Follows a console state loaded over the one being drawn
+			void					LoadCharacterRam( const CartridgeRamState& cartridgeRam ) noexcept;
+
+			// Copies the last frame the worker finished; returns how many it has finished
+			uint64_t				ReadFramebuffer( data_t* outFramebuffer ) const noexcept;
+
+		private:
+			static constexpr const size_t NUM_FRAME_LOGS = 2;
+
+			void					renderFrames( std::stop_token stopToken ) noexcept;
+			void					replay( const PpuFrameLog& log ) noexcept;
+
+		private:
+			std::shared_ptr<const RomImage>
+									mRomImage;
+			CartridgeRamState		mCartridgeRam;	// Its own CHR-RAM; the mapper keeps the tile cache of it
+			MapperState				mMapperState;
+			Mapper					mMapper;
+			PpuState				mPpuState;
+			Arena					mArena;
+			Ppu						mPpu;
+			PpuFrameLog				mFrameLogs[NUM_FRAME_LOGS];	// Frame n is logged in mFrameLogs[n % NUM_FRAME_LOGS]
+			DynamicArray<data_t>	mFinishedFramebuffer;
+
+			mutable std::mutex		mMutex;
+			std::condition_variable_any
+									mCondition;
+			uint64_t				mNumSubmittedFrames;
+			uint64_t				mNumFinishedFrames;
+			std::jthread			mWorker;		// Last, so it starts after everything it uses and stops before it goes
+		};
+	}
+}
\ No newline at end of file
@@ -1,42 +1,56 @@
 #pragma once
 
+#include "NES/Allocator.h"
+#include "NES/ArrayStorage.h"
 #include "NES/IArray.h"
 
 namespace ninmuse
 {
-	template <typename ElementType>
+	template <typename ElementType, Allocator TAllocator = DefaultAllocator>
 	class DynamicArray final : public IArray<ElementType>
 	{
 	public:
-		constexpr DynamicArray() noexcept;
-		DynamicArray( size_t capacity ) noexcept;
+		DynamicArray() noexcept requires std::default_initializable<TAllocator>;
+		explicit DynamicArray( const TAllocator& allocator ) noexcept;
+		DynamicArray( size_t capacity, const TAllocator& allocator = TAllocator() ) noexcept;
 		DynamicArray( const DynamicArray& other ) noexcept;
-		constexpr DynamicArray( DynamicArray&& other ) noexcept;
+		DynamicArray( DynamicArray&& other ) noexcept;
 		~DynamicArray() noexcept;
 
 		DynamicArray& operator=( const DynamicArray& other ) noexcept;
-		constexpr DynamicArray& operator=( DynamicArray&& other ) noexcept;
+		DynamicArray& operator=( DynamicArray&& other ) noexcept;
 
 		// Element Access
 		constexpr ElementType*			GetData() noexcept override { return mData; }
 		constexpr const ElementType*	GetData() const noexcept override { return mData; }
 
 		// Capacities
-		void				SetSize( const size_t zSize ) noexcept;
+		void					SetSize( const size_t size ) noexcept;
 		inline constexpr size_t	GetSize() const noexcept override { return mSize; }
-		void				SetCapacity( size_t zCapacity ) noexcept;
+		void					SetCapacity( const size_t capacity ) noexcept;
 		inline constexpr size_t	GetCapacity() const noexcept { return mCapacity; }
+		inline constexpr const TAllocator&
+								GetAllocator() const noexcept { return mAllocator; }
 
 		// Modifiers
-		constexpr void		Clear() noexcept;
-		constexpr void		PushBack( const ElementType& value ) noexcept;
-		constexpr void		PushBack( ElementType&& value ) noexcept;
-		constexpr void		PopBack() noexcept;
+		void					Clear() noexcept;
+		void					PushBack( const ElementType& value ) noexcept;
+		void					PushBack( ElementType&& value ) noexcept;
+		template <typename... TArgs>
+		ElementType&			EmplaceBack( TArgs&&... args ) noexcept;
+		void					PopBack() noexcept;
 
 	private:
+		using Storage = ArrayStorage<ElementType>;
+
 		static constexpr const size_t DEFAULT_CAPACITY = 8;
+		static constexpr const size_t GROWTH_FACTOR = 2;
+
+	private:
+		constexpr size_t		getGrownCapacity() const noexcept;
 
 	private:
+		TAllocator		mAllocator;
 		size_t			mCapacity;
 		size_t			mSize;
 		ElementType*	mData;
@@ -5,81 +5,90 @@
 
 namespace ninmuse
 {
-	template<typename ElementType>
-	inline constexpr DynamicArray<ElementType>::DynamicArray() noexcept
-		: DynamicArray( DEFAULT_CAPACITY )
+	template<typename ElementType, Allocator TAllocator>
+	inline DynamicArray<ElementType, TAllocator>::DynamicArray() noexcept requires std::default_initializable<TAllocator>
+		: DynamicArray( TAllocator() )
 	{
 	}
 
-	template<typename ElementType>
-	inline DynamicArray<ElementType>::DynamicArray( size_t capacity ) noexcept
+	template<typename ElementType, Allocator TAllocator>
+	inline DynamicArray<ElementType, TAllocator>::DynamicArray( const TAllocator& allocator ) noexcept
 		: IArray<ElementType>()
-		, mCapacity( capacity )
+		, mAllocator( allocator )
+		, mCapacity( 0 )
 		, mSize( 0 )
 		, mData( nullptr )
 	{
-		SetCapacity( mCapacity );
 	}
 
-	template<typename ElementType>
-	inline DynamicArray<ElementType>::DynamicArray( const DynamicArray& other ) noexcept
-		: IArray<ElementType>( other )
-		, mCapacity( other.mCapacity )
-		, mSize( other.mSize )
+	template<typename ElementType, Allocator TAllocator>
+	inline DynamicArray<ElementType, TAllocator>::DynamicArray( size_t capacity, const TAllocator& allocator ) noexcept
+		: DynamicArray( allocator )
 	{
-		if ( this != &other )
+		SetCapacity( capacity );
+	}
+
+	template<typename ElementType, Allocator TAllocator>
+	inline DynamicArray<ElementType, TAllocator>::DynamicArray( const DynamicArray& other ) noexcept
+		: DynamicArray( other.mSize, other.mAllocator )
+	{
+		if ( mData == nullptr )
 		{
-			SetCapacity( mCapacity );
+			return;
 		}
+
+		if constexpr ( Storage::IS_TRIVIALLY_RELOCATABLE )
+		{
+			memcpy( mData, other.mData, sizeof( ElementType ) * other.mSize );
+		}
+		else
+		{
+			std::uninitialized_copy_n( other.mData, other.mSize, mData );
+		}
+		mSize = other.mSize;
 	}
 
-	template<typename ElementType>
-	inline constexpr DynamicArray<ElementType>::DynamicArray( DynamicArray&& other ) noexcept
+	template<typename ElementType, Allocator TAllocator>
+	inline DynamicArray<ElementType, TAllocator>::DynamicArray( DynamicArray&& other ) noexcept
 		: IArray<ElementType>( std::move( other ) )
+		, mAllocator( other.mAllocator )
 		, mCapacity( other.mCapacity )
 		, mSize( other.mSize )
 		, mData( other.mData )
 	{
-		if ( this != &other )
-		{
-			other.mCapacity = 0;
-			other.mSize = 0;
-			other.mData = nullptr;
-		}
-
-		return *this;
+		other.mCapacity = 0;
+		other.mSize = 0;
+		other.mData = nullptr;
 	}
 
-	template<typename ElementType>
-	inline DynamicArray<ElementType>::~DynamicArray() noexcept
+	template<typename ElementType, Allocator TAllocator>
+	inline DynamicArray<ElementType, TAllocator>::~DynamicArray() noexcept
 	{
-		if ( mData != nullptr )
-		{
-			free( mData );
-		}
+		Storage::Destroy( mData, mSize );
+		Storage::Deallocate( mAllocator, mData, mCapacity );
 	}
 
-	template<typename ElementType>
-	inline DynamicArray<ElementType>& DynamicArray<ElementType>::operator=( const DynamicArray& other ) noexcept
+	template<typename ElementType, Allocator TAllocator>
+	inline DynamicArray<ElementType, TAllocator>& DynamicArray<ElementType, TAllocator>::operator=( const DynamicArray& other ) noexcept
 	{
-		IArray::operator=( other );
-
 		if ( this != &other )
 		{
-			mSize = other.mSize;
-			SetCapacity( other.mCapacity );
+			DynamicArray copy( other );
+			*this = std::move( copy );
 		}
 
 		return *this;
 	}
 
-	template<typename ElementType>
-	inline constexpr DynamicArray<ElementType>& DynamicArray<ElementType>::operator=( DynamicArray&& other ) noexcept
+	template<typename ElementType, Allocator TAllocator>
+	inline DynamicArray<ElementType, TAllocator>& DynamicArray<ElementType, TAllocator>::operator=( DynamicArray&& other ) noexcept
 	{
-		IArray::operator=( std::move( other ) );
-
 		if ( this != &other )
 		{
+			Storage::Destroy( mData, mSize );
+			Storage::Deallocate( mAllocator, mData, mCapacity );
+
+			mAllocator = other.mAllocator;
 			mCapacity = other.mCapacity;
 			mSize = other.mSize;
 			mData = other.mData;
@@ -92,87 +101,103 @@ namespace ninmuse
 		return *this;
 	}
 
-	template<typename ElementType>
-	inline void DynamicArray<ElementType>::SetSize( const size_t zSize ) noexcept
+	template<typename ElementType, Allocator TAllocator>
+	inline void DynamicArray<ElementType, TAllocator>::SetSize( const size_t size ) noexcept
 	{
-		const bool needsReallocation = mData == nullptr || mCapacity < zSize;
+		if ( size < mSize )
+		{
+			Storage::Destroy( mData + size, mSize - size );
+			mSize = size;
+			return;
+		}
 
-		if ( needsReallocation == true )
+		SetCapacity( size );
+		if ( mCapacity < size )
 		{
-			ElementType* paData = new ElementType[zSize];
-			if ( mData != nullptr )
-			{
-				memcpy( paData, mData, sizeof( ElementType ) * mSize );
-				free( mData );
-			}
-
-			mCapacity = zSize;
-			mSize = zSize;
-			mData = paData;
+			return;
 		}
+
+		std::uninitialized_value_construct_n( mData + mSize, size - mSize );
+		mSize = size;
 	}
 
-	template<typename ElementType>
-	inline void DynamicArray<ElementType>::SetCapacity( size_t capacity ) noexcept
+	template<typename ElementType, Allocator TAllocator>
+	inline void DynamicArray<ElementType, TAllocator>::SetCapacity( const size_t capacity ) noexcept
 	{
-		const bool needsReallocation = mData == nullptr || mCapacity < capacity;
-
-		if ( needsReallocation == true )
+		if ( capacity <= mCapacity )
 		{
-			ElementType* paData = static_cast<ElementType*>( malloc( sizeof( ElementType ) * capacity ) );
-			if ( paData == nullptr )
-			{
-				NM_ASSERT( false, "Failed to allocate an array!!" );
-				return;
-			}
-
-			if ( mData != nullptr )
-			{
-				memcpy( paData, mData, sizeof( ElementType ) * mSize );
-				free( mData );
-			}
-
-			mCapacity = capacity;
-			mData = paData;
+			return;
 		}
-	}
 
-	template<typename ElementType>
-	inline constexpr void DynamicArray<ElementType>::Clear() noexcept
-	{
-		for ( size_t zDataIndex = 0; zDataIndex < mSize; ++zDataIndex )
+		ElementType* paData = Storage::Allocate( mAllocator, capacity );
+		if ( paData == nullptr )
 		{
-			mData[zDataIndex].~ElementType();
+			return;
 		}
 
+		Storage::Relocate( paData, mData, mSize );
+		Storage::Deallocate( mAllocator, mData, mCapacity );
+
+		mCapacity = capacity;
+		mData = paData;
+	}
+
+	template<typename ElementType, Allocator TAllocator>
+	inline void DynamicArray<ElementType, TAllocator>::Clear() noexcept
+	{
+		Storage::Destroy( mData, mSize );
 		mSize = 0;
 	}
 
-	template<typename ElementType>
-	inline constexpr void DynamicArray<ElementType>::PushBack( const ElementType& value ) noexcept
+	template<typename ElementType, Allocator TAllocator>
+	inline void DynamicArray<ElementType, TAllocator>::PushBack( const ElementType& value ) noexcept
 	{
-		if ( mSize >= mCapacity )
-		{
-			SetCapacity( mCapacity * 2 );
-		}
+		EmplaceBack( value );
+	}
 
-		mData[mSize++] = value;
+	template<typename ElementType, Allocator TAllocator>
+	inline void DynamicArray<ElementType, TAllocator>::PushBack( ElementType&& value ) noexcept
+	{
+		EmplaceBack( std::move( value ) );
 	}
 
-	template<typename ElementType>
-	inline constexpr void DynamicArray<ElementType>::PushBack( ElementType&& value ) noexcept
+	template<typename ElementType, Allocator TAllocator>
+	template<typename... TArgs>
+	inline ElementType& DynamicArray<ElementType, TAllocator>::EmplaceBack( TArgs&&... args ) noexcept
 	{
-		if ( mSize >= mCapacity )
+		if ( mSize < mCapacity )
 		{
-			SetCapacity( mCapacity * 2 );
+			ElementType* element = std::construct_at( mData + mSize, std::forward<TArgs>( args )... );
+			++mSize;
+			return *element;
 		}
 
-		mData[mSize++] = std::move( value );
+		// The arguments may refer to an element of this array, so construct the new element
+		// before the old storage goes away.
+		const size_t capacity = getGrownCapacity();
+		ElementType* paData = Storage::AllocateOrAbort( mAllocator, capacity );
+
+		ElementType* element = std::construct_at( paData + mSize, std::forward<TArgs>( args )... );
+		Storage::Relocate( paData, mData, mSize );
+		Storage::Deallocate( mAllocator, mData, mCapacity );
+
+		mCapacity = capacity;
+		mData = paData;
+		++mSize;
+
+		return *element;
+	}
+
+	template<typename ElementType, Allocator TAllocator>
+	inline void DynamicArray<ElementType, TAllocator>::PopBack() noexcept
+	{
+		NM_ASSERT( mSize > 0, "Array is empty!!" );
+		std::destroy_at( mData + --mSize );
 	}
 
-	template<typename ElementType>
-	inline constexpr void DynamicArray<ElementType>::PopBack() noexcept
+	template<typename ElementType, Allocator TAllocator>
+	inline constexpr size_t DynamicArray<ElementType, TAllocator>::getGrownCapacity() const noexcept
 	{
-		mData[--mSize].~ElementType();
+		return mCapacity < DEFAULT_CAPACITY ? DEFAULT_CAPACITY : mCapacity * GROWTH_FACTOR;
 	}
 }
\ No newline at end of file
@@ -0,0 +1,183 @@
+#include "stdafx.h"
+
+#include "NES/Hash.h"
+
+namespace ninmuse
+{
+	// Slicing-by-8: eight lookups fold eight input bytes per step instead of one
+	struct Crc32Tables final
+	{
+		static constexpr const size_t NUM_SLICES = 8;
+		static constexpr const uint32_t POLYNOMIAL = 0xEDB8'8320;
+
+		uint32_t	Table[NUM_SLICES][256] = {};
+	};
+
+	static constexpr Crc32Tables CreateCrc32Tables() noexcept
+	{
+		Crc32Tables tables;
+		for ( uint32_t index = 0; index < 256; ++index )
+		{
+			uint32_t crc = index;
+			for ( size_t bit = 0; bit < NUM_BITS_IN_BYTE; ++bit )
+			{
+				crc = ( crc & 1 ) ? ( crc >> 1 ) ^ Crc32Tables::POLYNOMIAL : crc >> 1;
+			}
+			tables.Table[0][index] = crc;
+		}
+
+		for ( size_t slice = 1; slice < Crc32Tables::NUM_SLICES; ++slice )
+		{
+			for ( size_t index = 0; index < 256; ++index )
+			{
+				const uint32_t previous = tables.Table[slice - 1][index];
+				tables.Table[slice][index] = ( previous >> 8 ) ^ tables.Table[0][previous & 0xFF];
+			}
+		}
+
+		return tables;
+	}
+
+	static constexpr const Crc32Tables CRC32_TABLES = CreateCrc32Tables();
+	static_assert( CRC32_TABLES.Table[0][1] == 0x7707'3096 );
+
+	static inline uint32_t LoadLittleEndian32( const std::byte* data ) noexcept
+	{
+		return static_cast< uint32_t >( data[0] )
+			| ( static_cast< uint32_t >( data[1] ) << 8 )
+			| ( static_cast< uint32_t >( data[2] ) << 16 )
+			| ( static_cast< uint32_t >( data[3] ) << 24 );
+	}
+
+	static inline uint32_t LoadBigEndian32( const std::byte* data ) noexcept
+	{
+		return ( static_cast< uint32_t >( data[0] ) << 24 )
+			| ( static_cast< uint32_t >( data[1] ) << 16 )
+			| ( static_cast< uint32_t >( data[2] ) << 8 )
+			| static_cast< uint32_t >( data[3] );
+	}
+
+	static inline constexpr uint32_t RotateLeft( const uint32_t value, const uint32_t count ) noexcept
+	{
+		return ( value << count ) | ( value >> ( 32 - count ) );
+	}
+
+	uint32_t ComputeCrc32( const std::byte* data, size_t size, const uint32_t crc ) noexcept
+	{
+		const auto& table = CRC32_TABLES.Table;
+
+		uint32_t result = ~crc;
+		for ( ; size >= Crc32Tables::NUM_SLICES; size -= Crc32Tables::NUM_SLICES, data += Crc32Tables::NUM_SLICES )
+		{
+			const uint32_t low = LoadLittleEndian32( data ) ^ result;
+			const uint32_t high = LoadLittleEndian32( data + 4 );
+			result = table[7][low & 0xFF] ^ table[6][( low >> 8 ) & 0xFF] ^ table[5][( low >> 16 ) & 0xFF] ^ table[4][low >> 24]
+				^ table[3][high & 0xFF] ^ table[2][( high >> 8 ) & 0xFF] ^ table[1][( high >> 16 ) & 0xFF] ^ table[0][high >> 24];
+		}
+
+		for ( ; size > 0; --size, ++data )
+		{
+			result = ( result >> 8 ) ^ table[0][( result ^ static_cast< uint32_t >( *data ) ) & 0xFF];
+		}
+
+		return ~result;
+	}
+
+	// [REF]: RFC 3174. US Secure Hash Algorithm 1 (SHA1).
+	static void ProcessSha1Block( uint32_t inoutState[5], const std::byte* block ) noexcept
+	{
+		uint32_t words[80];
+		for ( size_t index = 0; index < 16; ++index )
+		{
+			words[index] = LoadBigEndian32( block + index * 4 );
+		}
+		for ( size_t index = 16; index < 80; ++index )
+		{
+			words[index] = RotateLeft( words[index - 3] ^ words[index - 8] ^ words[index - 14] ^ words[index - 16], 1 );
+		}
+
+		uint32_t a = inoutState[0];
+		uint32_t b = inoutState[1];
+		uint32_t c = inoutState[2];
+		uint32_t d = inoutState[3];
+		uint32_t e = inoutState[4];
+		for ( size_t index = 0; index < 80; ++index )
+		{
+			uint32_t f = 0;
+			uint32_t k = 0;
+			if ( index < 20 )
+			{
+				f = ( b & c ) | ( ~b & d );
+				k = 0x5A82'7999;
+			}
+			else if ( index < 40 )
+			{
+				f = b ^ c ^ d;
+				k = 0x6ED9'EBA1;
+			}
+			else if ( index < 60 )
+			{
+				f = ( b & c ) | ( b & d ) | ( c & d );
+				k = 0x8F1B'BCDC;
+			}
+			else
+			{
+				f = b ^ c ^ d;
+				k = 0xCA62'C1D6;
+			}
+
+			const uint32_t temp = RotateLeft( a, 5 ) + f + e + k + words[index];
+			e = d;
+			d = c;
+			c = RotateLeft( b, 30 );
+			b = a;
+			a = temp;
+		}
+
+		inoutState[0] += a;
+		inoutState[1] += b;
+		inoutState[2] += c;
+		inoutState[3] += d;
+		inoutState[4] += e;
+	}
+
+	Sha1Digest ComputeSha1( const std::byte* data, const size_t size ) noexcept
+	{
+		static constexpr const size_t BLOCK_SIZE = 64;
+		static constexpr const size_t LENGTH_SIZE = 8;
+
+		uint32_t state[5] = { 0x6745'2301, 0xEFCD'AB89, 0x98BA'DCFE, 0x1032'5476, 0xC3D2'E1F0 };
+
+		const size_t numFullBlocks = size / BLOCK_SIZE;
+		for ( size_t block = 0; block < numFullBlocks; ++block )
+		{
+			ProcessSha1Block( state, data + block * BLOCK_SIZE );
+		}
+
+		// Padding: 0x80, zeros, then the message length in bits, big endian
+		std::byte tail[BLOCK_SIZE * 2] = {};
+		const size_t remainder = size - numFullBlocks * BLOCK_SIZE;
+		memcpy( tail, data + numFullBlocks * BLOCK_SIZE, remainder );
+		tail[remainder] = std::byte{ 0x80 };
+
+		const size_t tailSize = remainder + 1 + LENGTH_SIZE <= BLOCK_SIZE ? BLOCK_SIZE : BLOCK_SIZE * 2;
+		const uint64_t numBits = static_cast< uint64_t >( size ) * NUM_BITS_IN_BYTE;
+		for ( size_t index = 0; index < LENGTH_SIZE; ++index )
+		{
+			tail[tailSize - 1 - index] = static_cast< std::byte >( numBits >> ( index * NUM_BITS_IN_BYTE ) );
+		}
+
+		for ( size_t offset = 0; offset < tailSize; offset += BLOCK_SIZE )
+		{
+			ProcessSha1Block( state, tail + offset );
+		}
+
+		Sha1Digest digest;
+		for ( size_t index = 0; index < Sha1Digest::SIZE; ++index )
+		{
+			digest.Bytes[index] = static_cast< uint8_t >( state[index / 4] >> ( 24 - ( index % 4 ) * NUM_BITS_IN_BYTE ) );
+		}
+
+		return digest;
+	}
+}
\ No newline at end of file
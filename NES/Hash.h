@@ -0,0 +1,20 @@
+#pragma once
+
+#include "NES/Common.h"
+
+namespace ninmuse
+{
+	struct Sha1Digest final
+	{
+		static constexpr const size_t SIZE = 20;
+
+		uint8_t	Bytes[SIZE] = {};
+
+		inline constexpr bool	operator==( const Sha1Digest& other ) const noexcept = default;
+	};
+
+	// CRC-32 as used by zip/zlib and the ROM databases (reflected polynomial 0xEDB88320).
+	// Pass the previous result as crc to hash a buffer in pieces.
+	uint32_t	ComputeCrc32( const std::byte* data, const size_t size, const uint32_t crc = 0 ) noexcept;
+	Sha1Digest	ComputeSha1( const std::byte* data, const size_t size ) noexcept;
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "NES/Allocator.h"
+#include "NES/ArrayStorage.h"
+#include "NES/IArray.h"
+
+namespace ninmuse
+{
+	// DynamicArray with small buffer optimization. The first NumInlineElements live inside the object;
+	// the array only goes to TAllocator once it outgrows them.
+	template <typename ElementType, size_t NumInlineElements, Allocator TAllocator = DefaultAllocator>
+	class InlineArray final : public IArray<ElementType>
+	{
+	public:
+		InlineArray() noexcept requires std::default_initializable<TAllocator>;
+		explicit InlineArray( const TAllocator& allocator ) noexcept;
+		InlineArray( const InlineArray& other ) noexcept;
+		InlineArray( InlineArray&& other ) noexcept;
+		~InlineArray() noexcept;
+
+		InlineArray& operator=( const InlineArray& other ) noexcept;
+		InlineArray& operator=( InlineArray&& other ) noexcept;
+
+		// Element Access
+		constexpr ElementType*			GetData() noexcept override { return mData; }
+		constexpr const ElementType*	GetData() const noexcept override { return mData; }
+
+		// Capacities
+		void					SetSize( const size_t size ) noexcept;
+		inline constexpr size_t	GetSize() const noexcept override { return mSize; }
+		void					SetCapacity( const size_t capacity ) noexcept;
+		inline constexpr size_t	GetCapacity() const noexcept { return mCapacity; }
+		inline bool				IsInline() const noexcept { return mData == getInlineData(); }
+
+		// Modifiers
+		void					Clear() noexcept;
+		void					PushBack( const ElementType& value ) noexcept;
+		void					PushBack( ElementType&& value ) noexcept;
+		template <typename... TArgs>
+		ElementType&			EmplaceBack( TArgs&&... args ) noexcept;
+		void					PopBack() noexcept;
+
+	private:
+		using Storage = ArrayStorage<ElementType>;
+
+		static constexpr const size_t GROWTH_FACTOR = 2;
+		static_assert( NumInlineElements > 0, "Use DynamicArray when there is no inline storage!!" );
+
+	private:
+		inline ElementType*		getInlineData() noexcept { return reinterpret_cast<ElementType*>( mInlineStorage ); }
+		inline const ElementType*	getInlineData() const noexcept { return reinterpret_cast<const ElementType*>( mInlineStorage ); }
+		void					deallocate() noexcept;
+		void					stealOrRelocate( InlineArray&& other ) noexcept;
+
+	private:
+		ElementType*			mData;
+		size_t					mSize;
+		size_t					mCapacity;
+		TAllocator				mAllocator;
+		alignas( ElementType ) std::byte
+								mInlineStorage[sizeof( ElementType ) * NumInlineElements];
+	};
+}
\ No newline at end of file
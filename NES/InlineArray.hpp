@@ -0,0 +1,206 @@
+#pragma once
+
+#include "InlineArray.h"
+#include "IArray.h"
+
+namespace ninmuse
+{
+	template<typename ElementType, size_t NumInlineElements, Allocator TAllocator>
+	inline InlineArray<ElementType, NumInlineElements, TAllocator>::InlineArray() noexcept requires std::default_initializable<TAllocator>
+		: InlineArray( TAllocator() )
+	{
+	}
+
+	template<typename ElementType, size_t NumInlineElements, Allocator TAllocator>
+	inline InlineArray<ElementType, NumInlineElements, TAllocator>::InlineArray( const TAllocator& allocator ) noexcept
+		: IArray<ElementType>()
+		, mData( getInlineData() )
+		, mSize( 0 )
+		, mCapacity( NumInlineElements )
+		, mAllocator( allocator )
+	{
+	}
+
+	template<typename ElementType, size_t NumInlineElements, Allocator TAllocator>
+	inline InlineArray<ElementType, NumInlineElements, TAllocator>::InlineArray( const InlineArray& other ) noexcept
+		: InlineArray( other.mAllocator )
+	{
+		SetCapacity( other.mSize );
+		if ( mCapacity < other.mSize )
+		{
+			return;
+		}
+
+		std::uninitialized_copy_n( other.mData, other.mSize, mData );
+		mSize = other.mSize;
+	}
+
+	template<typename ElementType, size_t NumInlineElements, Allocator TAllocator>
+	inline InlineArray<ElementType, NumInlineElements, TAllocator>::InlineArray( InlineArray&& other ) noexcept
+		: InlineArray( other.mAllocator )
+	{
+		stealOrRelocate( std::move( other ) );
+	}
+
+	template<typename ElementType, size_t NumInlineElements, Allocator TAllocator>
+	inline InlineArray<ElementType, NumInlineElements, TAllocator>::~InlineArray() noexcept
+	{
+		Storage::Destroy( mData, mSize );
+		deallocate();
+	}
+
+	template<typename ElementType, size_t NumInlineElements, Allocator TAllocator>
+	inline InlineArray<ElementType, NumInlineElements, TAllocator>& InlineArray<ElementType, NumInlineElements, TAllocator>::operator=( const InlineArray& other ) noexcept
+	{
+		if ( this != &other )
+		{
+			InlineArray copy( other );
+			*this = std::move( copy );
+		}
+
+		return *this;
+	}
+
+	template<typename ElementType, size_t NumInlineElements, Allocator TAllocator>
+	inline InlineArray<ElementType, NumInlineElements, TAllocator>& InlineArray<ElementType, NumInlineElements, TAllocator>::operator=( InlineArray&& other ) noexcept
+	{
+		if ( this != &other )
+		{
+			Storage::Destroy( mData, mSize );
+			deallocate();
+
+			mData = getInlineData();
+			mSize = 0;
+			mCapacity = NumInlineElements;
+			mAllocator = other.mAllocator;
+
+			stealOrRelocate( std::move( other ) );
+		}
+
+		return *this;
+	}
+
+	template<typename ElementType, size_t NumInlineElements, Allocator TAllocator>
+	inline void InlineArray<ElementType, NumInlineElements, TAllocator>::SetSize( const size_t size ) noexcept
+	{
+		if ( size < mSize )
+		{
+			Storage::Destroy( mData + size, mSize - size );
+			mSize = size;
+			return;
+		}
+
+		SetCapacity( size );
+		if ( mCapacity < size )
+		{
+			return;
+		}
+
+		std::uninitialized_value_construct_n( mData + mSize, size - mSize );
+		mSize = size;
+	}
+
+	template<typename ElementType, size_t NumInlineElements, Allocator TAllocator>
+	inline void InlineArray<ElementType, NumInlineElements, TAllocator>::SetCapacity( const size_t capacity ) noexcept
+	{
+		if ( capacity <= mCapacity )
+		{
+			return;
+		}
+
+		ElementType* paData = Storage::Allocate( mAllocator, capacity );
+		if ( paData == nullptr )
+		{
+			return;
+		}
+
+		Storage::Relocate( paData, mData, mSize );
+		deallocate();
+
+		mCapacity = capacity;
+		mData = paData;
+	}
+
+	template<typename ElementType, size_t NumInlineElements, Allocator TAllocator>
+	inline void InlineArray<ElementType, NumInlineElements, TAllocator>::Clear() noexcept
+	{
+		Storage::Destroy( mData, mSize );
+		mSize = 0;
+	}
+
+	template<typename ElementType, size_t NumInlineElements, Allocator TAllocator>
+	inline void InlineArray<ElementType, NumInlineElements, TAllocator>::PushBack( const ElementType& value ) noexcept
+	{
+		EmplaceBack( value );
+	}
+
+	template<typename ElementType, size_t NumInlineElements, Allocator TAllocator>
+	inline void InlineArray<ElementType, NumInlineElements, TAllocator>::PushBack( ElementType&& value ) noexcept
+	{
+		EmplaceBack( std::move( value ) );
+	}
+
+	template<typename ElementType, size_t NumInlineElements, Allocator TAllocator>
+	template<typename... TArgs>
+	inline ElementType& InlineArray<ElementType, NumInlineElements, TAllocator>::EmplaceBack( TArgs&&... args ) noexcept
+	{
+		if ( mSize < mCapacity )
+		{
+			ElementType* element = std::construct_at( mData + mSize, std::forward<TArgs>( args )... );
+			++mSize;
+			return *element;
+		}
+
+		// Spill to the heap. As in DynamicArray, the new element is constructed first since
+		// the arguments may point into the storage being replaced.
+		const size_t capacity = mCapacity * GROWTH_FACTOR;
+		ElementType* paData = Storage::AllocateOrAbort( mAllocator, capacity );
+
+		ElementType* element = std::construct_at( paData + mSize, std::forward<TArgs>( args )... );
+		Storage::Relocate( paData, mData, mSize );
+		deallocate();
+
+		mCapacity = capacity;
+		mData = paData;
+		++mSize;
+
+		return *element;
+	}
+
+	template<typename ElementType, size_t NumInlineElements, Allocator TAllocator>
+	inline void InlineArray<ElementType, NumInlineElements, TAllocator>::PopBack() noexcept
+	{
+		NM_ASSERT( mSize > 0, "Array is empty!!" );
+		std::destroy_at( mData + --mSize );
+	}
+
+	template<typename ElementType, size_t NumInlineElements, Allocator TAllocator>
+	inline void InlineArray<ElementType, NumInlineElements, TAllocator>::deallocate() noexcept
+	{
+		if ( IsInline() == false )
+		{
+			Storage::Deallocate( mAllocator, mData, mCapacity );
+		}
+	}
+
+	template<typename ElementType, size_t NumInlineElements, Allocator TAllocator>
+	inline void InlineArray<ElementType, NumInlineElements, TAllocator>::stealOrRelocate( InlineArray&& other ) noexcept
+	{
+		if ( other.IsInline() )
+		{
+			Storage::Relocate( mData, other.mData, other.mSize );
+			mSize = other.mSize;
+		}
+		else
+		{
+			mData = other.mData;
+			mSize = other.mSize;
+			mCapacity = other.mCapacity;
+
+			other.mData = other.getInlineData();
+			other.mCapacity = NumInlineElements;
+		}
+
+		other.mSize = 0;
+	}
+}
\ No newline at end of file
@@ -1,19 +1,294 @@
 #include "stdafx.h"
 
+#include <chrono>
+#include <future>
 #include <iostream>
 #include <string>
 
 #include "NES/Cartridge.h"
+#include "NES/ColorConverter.h"
+#include "NES/DeferredRenderer.h"
+#include "NES/Hash.h"
+#include "NES/Mapper.h"
 #include "NES/Nes.h"
+#include "NES/Ppu.h"
+#include "NES/RomLibrary.h"
+#include "NES/TileDecoder.h"
 
 using namespace ninmuse;
 using namespace ninmuse::nes;
 
 static constexpr const char* CARTRIDGE_FILE_NAME_KEY = "CartidgeFileName=";
+static constexpr const char* ROM_LIBRARY_DIRECTORY_KEY = "RomLibraryDirectory=";
+static constexpr const char* ROM_LIBRARY_INDEX_FILE_NAME = "RomLibrary.index";
+static constexpr const char* MAPPER_BENCHMARK_KEY = "MapperBenchmark=";
+static constexpr const char* PPU_BENCHMARK_KEY = "PpuBenchmark=";
+static constexpr const char* PPU_ACCURACY_KEY = "PpuAccuracy=";
+static constexpr const char* PPU_ACCURACY_NAMES[] = { "Scanline", "Dot" };
+static constexpr const char* DEFERRED_RENDERING_KEY = "DeferredRendering=";
+static_assert( ARRAYSIZE( PPU_ACCURACY_NAMES ) == static_cast< size_t >( ePpuAccuracy::COUNT ) );
+static constexpr const char* SIMD_LEVEL_NAMES[] = { "scalar", "SSE2", "AVX2" };
+static_assert( ARRAYSIZE( SIMD_LEVEL_NAMES ) == static_cast< size_t >( eSimdLevel::COUNT ) );
+
+// The register writes a game issues to switch the 16 KB or 8 KB PRG bank at $8000
+static void SwitchProgramBank( Mapper& mapper, const uint16_t mapperNumber, const data_t bank ) noexcept
+{
+	switch ( mapperNumber )
+	{
+	case 1:
+		for ( uint32_t bit = 0; bit < 5; ++bit )
+		{
+			mapper.WriteProgram( 0xE000, static_cast< data_t >( bank >> bit ) );
+		}
+		break;
+	case 2:
+		[[fallthrough]];
+	case 3:
+		mapper.WriteProgram( 0x8000, bank );
+		break;
+	case 4:
+		mapper.WriteProgram( 0x8000, 6 );
+		mapper.WriteProgram( 0x8001, bank );
+		break;
+	default:
+		break;
+	}
+}
+
+// Switches banks and reads through the new mapping in a tight loop, like a game streaming level data
+static void RunMapperBenchmark( Cartridge& cartridge, const size_t numIterations ) noexcept
+{
+	const uint16_t mapperNumber = cartridge.GetRomImage()->GetInfo().MapperNumber;
+	if ( Mapper::IsSupported( mapperNumber ) == false )
+	{
+		std::cout << "Mapper " << mapperNumber << " is not supported" << std::endl;
+		return;
+	}
+
+	MapperState state;
+	const std::unique_ptr<CartridgeRamState> cartridgeRam = std::make_unique<CartridgeRamState>();
+	Mapper mapper( *cartridge.GetRomImage(), state, *cartridgeRam );
+
+	uint32_t checksum = 0;
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for ( size_t iteration = 0; iteration < numIterations; ++iteration )
+	{
+		SwitchProgramBank( mapper, mapperNumber, static_cast< data_t >( iteration ) );
+		checksum += mapper.ReadProgram( static_cast< address_t >( Mapper::PROGRAM_ROM_ADDRESS + ( iteration & 0x3FFF ) ) );
+	}
+	const std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - start;
+
+	const double nanoseconds = static_cast< double >( std::chrono::duration_cast<std::chrono::nanoseconds>( elapsed ).count() );
+	std::cout << mapper.GetName() << ": " << numIterations << " bank switches in " << nanoseconds / 1'000'000.0 << " ms, ";
+	std::cout << nanoseconds / static_cast< double >( numIterations ) << " ns per switch (checksum " << checksum << ")" << std::endl;
+}
+
+static constexpr const char* COLOR_FORMAT_NAMES[] = { "RGBA8", "RGB8" };
+static_assert( ARRAYSIZE( COLOR_FORMAT_NAMES ) == static_cast< size_t >( eColorFormat::COUNT ) );
+
+// What a frontend pays to show a frame: every format, from the indices a PPU benchmark left behind
+static void RunColorConversionBenchmark( const data_t* frame, const size_t numFrames ) noexcept
+{
+	const ColorConverter converter;
+	std::cout << "Color conversion (" << SIMD_LEVEL_NAMES[static_cast< size_t >( GetColorConverterSimdLevel() )] << "):";
+	for ( size_t format = 0; format < static_cast< size_t >( eColorFormat::COUNT ); ++format )
+	{
+		const size_t outputSize = ColorConverter::GetOutputSize( static_cast< eColorFormat >( format ) );
+		DynamicArray<data_t> pixels( outputSize );
+		pixels.SetSize( outputSize );
+
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for ( size_t frameIndex = 0; frameIndex < numFrames; ++frameIndex )
+		{
+			converter.Convert( frame, static_cast< eColorFormat >( format ), pixels.GetData() );
+		}
+		const std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - start;
+
+		const double microseconds = static_cast< double >( std::chrono::duration_cast<std::chrono::nanoseconds>( elapsed ).count() ) / 1'000.0 / static_cast< double >( numFrames );
+		const uint32_t crc32 = ComputeCrc32( reinterpret_cast<const std::byte*>( pixels.GetData() ), outputSize );
+		std::cout << ' ' << COLOR_FORMAT_NAMES[format] << ' ' << microseconds << " us/frame (CRC32 " << std::hex << crc32 << std::dec << ')';
+	}
+	std::cout << std::endl;
+}
+
+static void WritePpuMemory( Ppu& ppu, const address_t address, const data_t data ) noexcept
+{
+	ppu.WriteRegister( PpuRegisterMap::Address, static_cast< data_t >( address >> 8 ) );
+	ppu.WriteRegister( PpuRegisterMap::Address, static_cast< data_t >( address ) );
+	ppu.WriteRegister( PpuRegisterMap::Data, data );
+}
+
+// The scene of the PPU benchmark: the background and 64 sprites on. The CPU is not run: the scene is set up once
+// through the PPU registers, the way a game's init code would.
+static void SetUpPpuBenchmarkScene( Ppu& ppu ) noexcept
+{
+	// CHR-RAM boards start blank; give them something to draw. CHR-ROM writes are ignored.
+	for ( address_t address = 0; address < Ppu::NAMETABLE_ADDRESS; ++address )
+	{
+		WritePpuMemory( ppu, address, static_cast< data_t >( address * 0x9D ^ ( address >> 4 ) ) );
+	}
+	for ( address_t address = Ppu::NAMETABLE_ADDRESS; address < Ppu::NAMETABLE_ADDRESS + PpuState::NUM_NAMETABLES * PpuState::NAMETABLE_SIZE; ++address )
+	{
+		WritePpuMemory( ppu, address, static_cast< data_t >( address ) );
+	}
+	for ( address_t address = 0; address < PpuState::PALETTE_SIZE; ++address )
+	{
+		WritePpuMemory( ppu, Ppu::PALETTE_ADDRESS + address, static_cast< data_t >( address * 3 + 1 ) );
+	}
+
+	data_t oam[PpuState::OAM_SIZE];
+	for ( size_t offset = 0; offset < PpuState::OAM_SIZE; offset += 4 )
+	{
+		oam[offset + 0] = static_cast< data_t >( offset * 7 % 232 );	// Y
+		oam[offset + 1] = static_cast< data_t >( offset );				// Tile
+		oam[offset + 2] = static_cast< data_t >( offset >> 2 );			// Palette, priority and flips
+		oam[offset + 3] = static_cast< data_t >( offset * 13 );			// X
+	}
+	ppu.WriteRegister( PpuRegisterMap::OamAddress, 0 );
+	ppu.WriteOam( oam );
+
+	ppu.WriteRegister( PpuRegisterMap::Control, 0x08 );		// Sprites at $1000
+	ppu.WriteRegister( PpuRegisterMap::Mask, 0x1E );		// Background and sprites, left column included
+}
+
+// Scrolls one pixel per frame
+template <ePpuAccuracy Accuracy>
+static void RunPpuBenchmarkFrame( Ppu& ppu, const size_t frame ) noexcept
+{
+	ppu.WriteRegister( PpuRegisterMap::Scroll, static_cast< data_t >( frame ) );
+	ppu.WriteRegister( PpuRegisterMap::Scroll, static_cast< data_t >( frame / 2 ) );
+	ppu.Run<Accuracy>( PpuTiming::NUM_DOTS_PER_FRAME );
+}
+
+// Renders frames of the benchmark scene headless, scrolling one pixel per frame.
+// Deferred, the frames are drawn on a worker thread from the logged register writes while the next frame runs.
+template <ePpuAccuracy Accuracy>
+static void RunPpuBenchmark( Cartridge& cartridge, const size_t numFrames, const bool isDeferred ) noexcept
+{
+	const uint16_t mapperNumber = cartridge.GetRomImage()->GetInfo().MapperNumber;
+	if ( Mapper::IsSupported( mapperNumber ) == false )
+	{
+		std::cout << "Mapper " << mapperNumber << " is not supported" << std::endl;
+		return;
+	}
+
+	MapperState mapperState;
+	const std::unique_ptr<CartridgeRamState> cartridgeRam = std::make_unique<CartridgeRamState>();
+	Mapper mapper( *cartridge.GetRomImage(), mapperState, *cartridgeRam );
+	PpuState ppuState;
+	Arena arena( Ppu::GetRequiredArenaSize() );
+	Ppu ppu( ppuState, arena );
+	ppu.SetMapper( mapper );
+	SetUpPpuBenchmarkScene( ppu );
+
+	std::unique_ptr<DeferredRenderer> rendererOrNull = isDeferred && Accuracy == ePpuAccuracy::SCANLINE ? std::make_unique<DeferredRenderer>( cartridge.GetRomImage(), *cartridgeRam ) : nullptr;
+	uint32_t checksum = 0;
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for ( size_t frame = 0; frame < numFrames; ++frame )
+	{
+		if ( rendererOrNull != nullptr )
+		{
+			ppu.SetFrameLog( &rendererOrNull->BeginFrame( ppuState, mapperState ) );
+		}
+
+		RunPpuBenchmarkFrame<Accuracy>( ppu, frame );
+
+		if ( rendererOrNull != nullptr )
+		{
+			rendererOrNull->EndFrame( ppu.GetClock() );
+		}
+		else
+		{
+			checksum += ppu.GetFramebuffer()[frame % Ppu::FRAMEBUFFER_SIZE];
+		}
+	}
+
+	// Deferred, this is all the emulation thread spends; the rest of the elapsed time is the worker finishing the last frame
+	const std::chrono::steady_clock::duration emulationElapsed = std::chrono::steady_clock::now() - start;
+	DynamicArray<data_t> framebuffer;
+	framebuffer.SetSize( Ppu::FRAME_SIZE );
+	if ( rendererOrNull != nullptr )
+	{
+		rendererOrNull->Flush();
+		rendererOrNull->ReadFramebuffer( framebuffer.GetData() );
+	}
+	else
+	{
+		memcpy( framebuffer.GetData(), ppu.GetFramebuffer(), Ppu::FRAME_SIZE );
+	}
+	const std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - start;
+
+	const double seconds = static_cast< double >( std::chrono::duration_cast<std::chrono::nanoseconds>( elapsed ).count() ) / 1'000'000'000.0;
+	const uint32_t frameCrc32 = ComputeCrc32( reinterpret_cast<const std::byte*>( framebuffer.GetData() ), Ppu::FRAMEBUFFER_SIZE );
+	std::cout << "PPU (" << PPU_ACCURACY_NAMES[static_cast< size_t >( Accuracy )] << ( rendererOrNull != nullptr ? ", deferred" : "" ) << "): " << ppu.GetFrameCount() << " frames in " << seconds * 1'000.0 << " ms, " << static_cast< double >( numFrames ) / seconds << " frames/s ";
+	if ( rendererOrNull != nullptr )
+	{
+		std::cout << "(emulation thread " << static_cast< double >( std::chrono::duration_cast<std::chrono::microseconds>( emulationElapsed ).count() ) / 1'000.0 << " ms) ";
+	}
+	const NametableCacheStatistics& cacheStatistics = ppu.GetNametableCacheStatistics();
+	if ( Accuracy == ePpuAccuracy::SCANLINE && rendererOrNull == nullptr )
+	{
+		std::cout << "(nametable cache hit rate " << cacheStatistics.GetHitRate() * 100.0 << "%, " << cacheStatistics.NumTileMisses << " tiles redrawn) ";
+	}
+	std::cout << "(checksum " << checksum << ", last frame CRC32 " << std::hex << frameCrc32 << std::dec << ", " << SIMD_LEVEL_NAMES[static_cast< size_t >( GetTileDecoderSimdLevel() )] << " tile decoding)" << std::endl;
+
+	RunColorConversionBenchmark( framebuffer.GetData(), numFrames );
+}
+
+// Renders every frame of the benchmark scene twice, from the deferred renderer's log and synchronously on a PPU of its
+// own, and compares the CRC32 of the two. The renderer is flushed after each frame, so this is not part of the timing.
+static void CheckDeferredRendering( Cartridge& cartridge, const size_t numFrames ) noexcept
+{
+	MapperState deferredMapperState;
+	const std::unique_ptr<CartridgeRamState> deferredCartridgeRam = std::make_unique<CartridgeRamState>();
+	Mapper deferredMapper( *cartridge.GetRomImage(), deferredMapperState, *deferredCartridgeRam );
+	PpuState deferredPpuState;
+	Arena deferredArena( Ppu::GetRequiredArenaSize() );
+	Ppu deferredPpu( deferredPpuState, deferredArena );
+	deferredPpu.SetMapper( deferredMapper );
+	SetUpPpuBenchmarkScene( deferredPpu );
+
+	MapperState mapperState;
+	const std::unique_ptr<CartridgeRamState> cartridgeRam = std::make_unique<CartridgeRamState>();
+	Mapper mapper( *cartridge.GetRomImage(), mapperState, *cartridgeRam );
+	PpuState ppuState;
+	Arena arena( Ppu::GetRequiredArenaSize() );
+	Ppu ppu( ppuState, arena );
+	ppu.SetMapper( mapper );
+	SetUpPpuBenchmarkScene( ppu );
+
+	DeferredRenderer renderer( cartridge.GetRomImage(), *deferredCartridgeRam );
+	DynamicArray<data_t> framebuffer;
+	framebuffer.SetSize( Ppu::FRAME_SIZE );
+	for ( size_t frame = 0; frame < numFrames; ++frame )
+	{
+		deferredPpu.SetFrameLog( &renderer.BeginFrame( deferredPpuState, deferredMapperState ) );
+		RunPpuBenchmarkFrame<ePpuAccuracy::SCANLINE>( deferredPpu, frame );
+		renderer.EndFrame( deferredPpu.GetClock() );
+		renderer.Flush();
+		renderer.ReadFramebuffer( framebuffer.GetData() );
+
+		RunPpuBenchmarkFrame<ePpuAccuracy::SCANLINE>( ppu, frame );
+
+		const uint32_t deferredCrc32 = ComputeCrc32( reinterpret_cast<const std::byte*>( framebuffer.GetData() ), Ppu::FRAME_SIZE );
+		const uint32_t crc32 = ComputeCrc32( reinterpret_cast<const std::byte*>( ppu.GetFramebuffer() ), Ppu::FRAME_SIZE );
+		if ( deferredCrc32 != crc32 )
+		{
+			std::cout << "Deferred rendering check: frame " << frame << " CRC32 " << std::hex << deferredCrc32 << " deferred, " << crc32 << " synchronous" << std::dec << std::endl;
+			return;
+		}
+	}
+	std::cout << "Deferred rendering check: " << numFrames << " frames match the synchronous PPU" << std::endl;
+}
 
 int main(int argc, char* argv[])
 {
 	std::filesystem::path romFileName;
+	std::filesystem::path romLibraryDirectory;
+	size_t numMapperBenchmarkIterations = 0;
+	size_t numPpuBenchmarkFrames = 0;
+	ePpuAccuracy ppuAccuracy = ePpuAccuracy::SCANLINE;
+	bool isDeferredRenderingEnabled = false;
 	for (int argumentIndex = 0; argumentIndex < argc; ++argumentIndex)
 	{
 		const std::string argument = argv[argumentIndex];
@@ -21,17 +296,96 @@ int main(int argc, char* argv[])
 		{
 			const size_t fileNameIndex = argument.find_first_of('=');
 			romFileName = argument.substr(fileNameIndex + 1);
-			break;
+		}
+		else if (argument.starts_with(ROM_LIBRARY_DIRECTORY_KEY) == true)
+		{
+			const size_t directoryIndex = argument.find_first_of('=');
+			romLibraryDirectory = argument.substr(directoryIndex + 1);
+		}
+		else if (argument.starts_with(MAPPER_BENCHMARK_KEY) == true)
+		{
+			const size_t iterationsIndex = argument.find_first_of('=');
+			numMapperBenchmarkIterations = std::stoull(argument.substr(iterationsIndex + 1));
+		}
+		else if (argument.starts_with(PPU_BENCHMARK_KEY) == true)
+		{
+			const size_t framesIndex = argument.find_first_of('=');
+			numPpuBenchmarkFrames = std::stoull(argument.substr(framesIndex + 1));
+		}
+		else if (argument.starts_with(DEFERRED_RENDERING_KEY) == true)
+		{
+			isDeferredRenderingEnabled = std::stoi(argument.substr(argument.find_first_of('=') + 1)) != 0;
+		}
+		else if (argument.starts_with(PPU_ACCURACY_KEY) == true)
+		{
+			const std::string accuracyName = argument.substr(argument.find_first_of('=') + 1);
+			for (size_t accuracyIndex = 0; accuracyIndex < ARRAYSIZE(PPU_ACCURACY_NAMES); ++accuracyIndex)
+			{
+				if (accuracyName == PPU_ACCURACY_NAMES[accuracyIndex])
+				{
+					ppuAccuracy = static_cast<ePpuAccuracy>(accuracyIndex);
+				}
+			}
 		}
 	}
 
 	const std::filesystem::path workingDirectory = std::filesystem::current_path();
+	if ( romLibraryDirectory.empty() == false )
+	{
+		// Only files added or modified since the last scan are opened
+		RomLibrary romLibrary( workingDirectory / ROM_LIBRARY_INDEX_FILE_NAME );
+		const size_t numParsedRoms = romLibrary.Scan( workingDirectory / romLibraryDirectory );
+		romLibrary.Save();
+		std::cout << romLibrary.GetEntries().GetSize() << " ROMs indexed (" << numParsedRoms << " parsed)" << std::endl;
+		return 0;
+	}
+
 	const std::filesystem::path romFilePath = workingDirectory / romFileName;
-	std::unique_ptr<Cartridge> cartridge = std::make_unique<Cartridge>( romFilePath );
+	if ( numMapperBenchmarkIterations > 0 )
+	{
+		Cartridge cartridge( romFilePath );
+		RunMapperBenchmark( cartridge, numMapperBenchmarkIterations );
+		return 0;
+	}
+
+	if ( numPpuBenchmarkFrames > 0 )
+	{
+		Cartridge cartridge( romFilePath );
+		if ( ppuAccuracy == ePpuAccuracy::DOT )
+		{
+			RunPpuBenchmark<ePpuAccuracy::DOT>( cartridge, numPpuBenchmarkFrames, isDeferredRenderingEnabled );
+		}
+		else
+		{
+			RunPpuBenchmark<ePpuAccuracy::SCANLINE>( cartridge, numPpuBenchmarkFrames, isDeferredRenderingEnabled );
+			if ( isDeferredRenderingEnabled )
+			{
+				CheckDeferredRendering( cartridge, numPpuBenchmarkFrames );
+			}
+		}
+		return 0;
+	}
+
+	// Cold start: map the file, hash it and parse every section out of it on a worker thread.
+	// Hashing touches every page, so PRG/CHR-ROM are resident by the time the CPU reads them.
+	std::future<std::unique_ptr<Cartridge>> cartridgeLoading = std::async( std::launch::async, [romFilePath]() noexcept
+		{
+			// Only this console keeps battery-backed RAM on disk, next to the ROM
+			std::unique_ptr<Cartridge> cartridge = std::make_unique<Cartridge>( RomImage::Open( romFilePath ), Cartridge::GetDefaultSaveFilePath( romFilePath ) );
+			PrintCartridgeInfo( cartridge->GetRomImage()->GetInfo() );
+			return cartridge;
+		} );
 
+	// Meanwhile the console allocates and initializes its state
 	Nes nes;
-	nes.InsertCartridge( std::move( cartridge ) );
-	nes.TurnOn();
+	nes.InsertCartridge( std::move( cartridgeLoading ) );
+	nes.SetPpuAccuracy( ppuAccuracy );
+	nes.SetDeferredRendering( isDeferredRenderingEnabled );
+	if ( nes.PowerOn() )
+	{
+		PrintStartupTimings( nes.GetStartupTimings() );
+		nes.Run();
+	}
 	nes.TurnOff();
 
 	return 0;
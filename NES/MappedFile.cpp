@@ -0,0 +1,211 @@
+#include "stdafx.h"
+
+#include "NES/MappedFile.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else	// NOT defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif	// defined(_WIN32)
+
+namespace ninmuse
+{
+#if defined(_WIN32)
+	MappedFile::MappedFile( const std::filesystem::path& filePath ) noexcept
+		: mData( nullptr )
+		, mSize( 0 )
+		, mFileHandle( INVALID_HANDLE_VALUE )
+		, mMappingHandle( nullptr )
+	{
+		mFileHandle = CreateFileW( filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr );
+		if ( mFileHandle == INVALID_HANDLE_VALUE )
+		{
+			return;
+		}
+
+		LARGE_INTEGER fileSize = {};
+		if ( GetFileSizeEx( mFileHandle, &fileSize ) == FALSE || fileSize.QuadPart == 0 )
+		{
+			return;
+		}
+
+		mMappingHandle = CreateFileMappingW( mFileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr );
+		if ( mMappingHandle == nullptr )
+		{
+			return;
+		}
+
+		mData = static_cast<const std::byte*>( MapViewOfFile( mMappingHandle, FILE_MAP_READ, 0, 0, 0 ) );
+		if ( mData != nullptr )
+		{
+			mSize = static_cast<size_t>( fileSize.QuadPart );
+		}
+	}
+
+	MappedFile::~MappedFile() noexcept
+	{
+		if ( mData != nullptr )
+		{
+			UnmapViewOfFile( mData );
+		}
+		if ( mMappingHandle != nullptr )
+		{
+			CloseHandle( mMappingHandle );
+		}
+		if ( mFileHandle != INVALID_HANDLE_VALUE )
+		{
+			CloseHandle( mFileHandle );
+		}
+	}
+
+	WritableMappedFile::WritableMappedFile( const std::filesystem::path& filePath, const size_t size ) noexcept
+		: mData( nullptr )
+		, mSize( 0 )
+		, mFileHandle( INVALID_HANDLE_VALUE )
+		, mMappingHandle( nullptr )
+	{
+		if ( size == 0 )
+		{
+			return;
+		}
+
+		mFileHandle = CreateFileW( filePath.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr );
+		if ( mFileHandle == INVALID_HANDLE_VALUE )
+		{
+			return;
+		}
+
+		// A mapping larger than the file grows the file to the mapping size
+		const uint64_t mappingSize = static_cast<uint64_t>( size );
+		mMappingHandle = CreateFileMappingW( mFileHandle, nullptr, PAGE_READWRITE, static_cast<DWORD>( mappingSize >> 32 ), static_cast<DWORD>( mappingSize ), nullptr );
+		if ( mMappingHandle == nullptr )
+		{
+			return;
+		}
+
+		mData = static_cast<std::byte*>( MapViewOfFile( mMappingHandle, FILE_MAP_WRITE, 0, 0, size ) );
+		if ( mData != nullptr )
+		{
+			mSize = size;
+		}
+	}
+
+	WritableMappedFile::~WritableMappedFile() noexcept
+	{
+		if ( mData != nullptr )
+		{
+			Flush( true );
+			UnmapViewOfFile( mData );
+		}
+		if ( mMappingHandle != nullptr )
+		{
+			CloseHandle( mMappingHandle );
+		}
+		if ( mFileHandle != INVALID_HANDLE_VALUE )
+		{
+			CloseHandle( mFileHandle );
+		}
+	}
+
+	void WritableMappedFile::Flush( const bool waitForCompletion ) noexcept
+	{
+		if ( mData == nullptr )
+		{
+			return;
+		}
+
+		FlushViewOfFile( mData, mSize );
+		if ( waitForCompletion )
+		{
+			FlushFileBuffers( mFileHandle );
+		}
+	}
+#else	// NOT defined(_WIN32)
+	MappedFile::MappedFile( const std::filesystem::path& filePath ) noexcept
+		: mData( nullptr )
+		, mSize( 0 )
+	{
+		const int fileDescriptor = open( filePath.c_str(), O_RDONLY );
+		if ( fileDescriptor < 0 )
+		{
+			return;
+		}
+
+		struct stat fileStatus = {};
+		if ( fstat( fileDescriptor, &fileStatus ) == 0 && fileStatus.st_size > 0 )
+		{
+			void* mapping = mmap( nullptr, static_cast<size_t>( fileStatus.st_size ), PROT_READ, MAP_PRIVATE, fileDescriptor, 0 );
+			if ( mapping != MAP_FAILED )
+			{
+				mData = static_cast<const std::byte*>( mapping );
+				mSize = static_cast<size_t>( fileStatus.st_size );
+			}
+		}
+
+		// The mapping keeps its own reference to the file
+		close( fileDescriptor );
+	}
+
+	MappedFile::~MappedFile() noexcept
+	{
+		if ( mData != nullptr )
+		{
+			munmap( const_cast<std::byte*>( mData ), mSize );
+		}
+	}
+
+	WritableMappedFile::WritableMappedFile( const std::filesystem::path& filePath, const size_t size ) noexcept
+		: mData( nullptr )
+		, mSize( 0 )
+	{
+		if ( size == 0 )
+		{
+			return;
+		}
+
+		const int fileDescriptor = open( filePath.c_str(), O_RDWR | O_CREAT, 0644 );
+		if ( fileDescriptor < 0 )
+		{
+			return;
+		}
+
+		// New or short files are zero-filled up to the mapping size; longer ones keep their tail untouched
+		struct stat fileStatus = {};
+		const bool isSizeValid = fstat( fileDescriptor, &fileStatus ) == 0
+			&& ( static_cast<size_t>( fileStatus.st_size ) >= size || ftruncate( fileDescriptor, static_cast<off_t>( size ) ) == 0 );
+		if ( isSizeValid )
+		{
+			void* mapping = mmap( nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0 );
+			if ( mapping != MAP_FAILED )
+			{
+				mData = static_cast<std::byte*>( mapping );
+				mSize = size;
+			}
+		}
+
+		close( fileDescriptor );
+	}
+
+	WritableMappedFile::~WritableMappedFile() noexcept
+	{
+		if ( mData != nullptr )
+		{
+			Flush( true );
+			munmap( mData, mSize );
+		}
+	}
+
+	void WritableMappedFile::Flush( const bool waitForCompletion ) noexcept
+	{
+		if ( mData != nullptr )
+		{
+			msync( mData, mSize, waitForCompletion ? MS_SYNC : MS_ASYNC );
+		}
+	}
+#endif	// defined(_WIN32)
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "NES/Common.h"
+
+namespace ninmuse
+{
+	// Read-only mapping of a whole file. Pages are faulted in on first touch and shared with every
+	// other mapping of the same file, so opening a file costs neither a read loop nor a copy.
+	class MappedFile final
+	{
+	public:
+		MappedFile() = delete;
+		explicit MappedFile( const std::filesystem::path& filePath ) noexcept;
+		MappedFile( const MappedFile& ) = delete;
+		MappedFile( MappedFile&& ) = delete;
+		~MappedFile() noexcept;
+
+		MappedFile& operator=( const MappedFile& ) = delete;
+		MappedFile& operator=( MappedFile&& ) = delete;
+
+	public:
+		inline constexpr bool				IsOpen() const noexcept { return mData != nullptr; }
+		inline constexpr const std::byte*	GetData() const noexcept { return mData; }
+		inline constexpr size_t				GetSize() const noexcept { return mSize; }
+
+	private:
+		const std::byte*	mData;
+		size_t				mSize;
+#if defined(_WIN32)
+		void*				mFileHandle;
+		void*				mMappingHandle;
+#endif	// defined(_WIN32)
+	};
+
+	// Read-write shared mapping of a file of a fixed size, which is created or grown to that size as needed.
+	// Stores land in the page cache directly; they reach the disk when the OS writes the pages back, on Flush(),
+	// and at the latest when the mapping is destroyed.
+	class WritableMappedFile final
+	{
+	public:
+		WritableMappedFile() = delete;
+		WritableMappedFile( const std::filesystem::path& filePath, const size_t size ) noexcept;
+		WritableMappedFile( const WritableMappedFile& ) = delete;
+		WritableMappedFile( WritableMappedFile&& ) = delete;
+		~WritableMappedFile() noexcept;
+
+		WritableMappedFile& operator=( const WritableMappedFile& ) = delete;
+		WritableMappedFile& operator=( WritableMappedFile&& ) = delete;
+
+	public:
+		inline constexpr bool				IsOpen() const noexcept { return mData != nullptr; }
+		inline constexpr std::byte*			GetData() noexcept { return mData; }
+		inline constexpr const std::byte*	GetData() const noexcept { return mData; }
+		inline constexpr size_t				GetSize() const noexcept { return mSize; }
+
+		// Queues every dirty page for writeback in one call; waitForCompletion blocks until they are on disk
+		void								Flush( const bool waitForCompletion ) noexcept;
+
+	private:
+		std::byte*	mData;
+		size_t		mSize;
+#if defined(_WIN32)
+		void*		mFileHandle;
+		void*		mMappingHandle;
+#endif	// defined(_WIN32)
+	};
+}
\ No newline at end of file
@@ -0,0 +1,610 @@
+#include "stdafx.h"
+
+#include "NES/DynamicArray.hpp"
+#include "NES/Mapper.h"
+
+namespace ninmuse
+{
+	namespace nes
+	{
+		// Counter clocks happen at one dot of every visible scanline and of the pre-render scanline
+		static constexpr const uint64_t NUM_SCANLINE_COUNTER_CLOCKS_PER_FRAME = PpuTiming::NUM_VISIBLE_SCANLINES + 1;
+
+		static constexpr uint64_t GetScanlineCounterClockTime( const uint64_t clockIndex, const uint16_t dot ) noexcept
+		{
+			const uint64_t frame = clockIndex / NUM_SCANLINE_COUNTER_CLOCKS_PER_FRAME;
+			const uint64_t clockInFrame = clockIndex % NUM_SCANLINE_COUNTER_CLOCKS_PER_FRAME;
+			const uint64_t scanline = clockInFrame < PpuTiming::NUM_VISIBLE_SCANLINES ? clockInFrame : PpuTiming::PRE_RENDER_SCANLINE;
+			return frame * PpuTiming::NUM_DOTS_PER_FRAME + scanline * PpuTiming::NUM_DOTS_PER_SCANLINE + dot;
+		}
+
+		// Number of counter clocks at or before ppuClock since power-on
+		static constexpr uint64_t CountScanlineCounterClocks( const uint64_t ppuClock, const uint16_t dot ) noexcept
+		{
+			const uint32_t scanline = PpuTiming::GetScanline( ppuClock );
+			const uint64_t hasPassedDot = PpuTiming::GetDot( ppuClock ) >= dot ? 1 : 0;
+
+			uint64_t numClocksInFrame = PpuTiming::NUM_VISIBLE_SCANLINES;
+			if ( scanline < PpuTiming::NUM_VISIBLE_SCANLINES )
+			{
+				numClocksInFrame = scanline + hasPassedDot;
+			}
+			else if ( scanline == PpuTiming::PRE_RENDER_SCANLINE )
+			{
+				numClocksInFrame += hasPassedDot;
+			}
+
+			return ppuClock / PpuTiming::NUM_DOTS_PER_FRAME * NUM_SCANLINE_COUNTER_CLOCKS_PER_FRAME + numClocksInFrame;
+		}
+		static_assert( CountScanlineCounterClocks( GetScanlineCounterClockTime( 0, 260 ), 260 ) == 1 );
+		static_assert( CountScanlineCounterClocks( GetScanlineCounterClockTime( 0, 260 ) - 1, 260 ) == 0 );
+		static_assert( CountScanlineCounterClocks( GetScanlineCounterClockTime( 240, 324 ), 324 ) == 241 );
+		static_assert( CountScanlineCounterClocks( GetScanlineCounterClockTime( 1000, 260 ), 260 ) == 1001 );
+		static_assert( GetScanlineCounterClockTime( 241, 260 ) == PpuTiming::NUM_DOTS_PER_FRAME + 260 );
+
+		// [REF]: https://www.nesdev.org/wiki/MMC3#IRQ_Specifics
+		// The IRQ counter on its own, so advancing it in one step can be checked against clocking it one clock at a time
+		struct ScanlineCounter final
+		{
+			data_t	Counter			= 0;
+			data_t	Latch			= 0;
+			bool	IsReloadPending	= false;
+			bool	HasReachedZero	= false;	// At the end of any of the clocks so far
+
+			inline constexpr bool operator==( const ScanlineCounter& ) const noexcept = default;
+		};
+
+		static constexpr uint32_t GetNumClocksUntilZero( const ScanlineCounter& counter ) noexcept
+		{
+			// A clock on an empty counter, or after a reload request, only reloads it from the latch
+			if ( counter.Counter == 0 || counter.IsReloadPending )
+			{
+				return counter.Latch + 1u;
+			}
+
+			return counter.Counter;
+		}
+
+		// Same result as clocking numClocks times: count down to zero, then wrap with a period of latch + 1
+		static constexpr ScanlineCounter AdvanceScanlineCounter( ScanlineCounter counter, const uint64_t numClocks ) noexcept
+		{
+			if ( numClocks == 0 )
+			{
+				return counter;
+			}
+
+			const uint32_t numClocksUntilZero = GetNumClocksUntilZero( counter );
+			if ( numClocks < numClocksUntilZero )
+			{
+				const bool isReloading = counter.Counter == 0 || counter.IsReloadPending;
+				const data_t start = isReloading ? counter.Latch : counter.Counter;
+				counter.Counter = static_cast< data_t >( start - ( numClocks - ( isReloading ? 1 : 0 ) ) );
+			}
+			else
+			{
+				const uint64_t numClocksSinceZero = ( numClocks - numClocksUntilZero ) % ( counter.Latch + 1u );
+				counter.Counter = static_cast< data_t >( numClocksSinceZero == 0 ? 0 : counter.Latch - ( numClocksSinceZero - 1 ) );
+				counter.HasReachedZero = true;
+			}
+			counter.IsReloadPending = false;
+			return counter;
+		}
+
+		// One A12 rise, the way the board handles it
+		static constexpr ScanlineCounter ClockScanlineCounterOnce( ScanlineCounter counter ) noexcept
+		{
+			if ( counter.Counter == 0 || counter.IsReloadPending )
+			{
+				counter.Counter = counter.Latch;
+			}
+			else
+			{
+				--counter.Counter;
+			}
+			counter.IsReloadPending = false;
+			counter.HasReachedZero |= counter.Counter == 0;
+			return counter;
+		}
+
+		static constexpr bool IsAdvanceSameAsClocking( const ScanlineCounter& start, const uint64_t maxNumClocks ) noexcept
+		{
+			ScanlineCounter clocked = start;
+			for ( uint64_t numClocks = 0; numClocks <= maxNumClocks; ++numClocks )
+			{
+				if ( AdvanceScanlineCounter( start, numClocks ) != clocked )
+				{
+					return false;
+				}
+				// The predicted IRQ is the clock the counter first reads zero at
+				if ( start.HasReachedZero == false && clocked.HasReachedZero != ( numClocks >= GetNumClocksUntilZero( start ) ) )
+				{
+					return false;
+				}
+				clocked = ClockScanlineCounterOnce( clocked );
+			}
+
+			return true;
+		}
+		static_assert( IsAdvanceSameAsClocking( ScanlineCounter{ .Counter = 0, .Latch = 0 }, 600 ) );
+		static_assert( IsAdvanceSameAsClocking( ScanlineCounter{ .Counter = 4, .Latch = 0 }, 600 ) );
+		static_assert( IsAdvanceSameAsClocking( ScanlineCounter{ .Counter = 5, .Latch = 9, .IsReloadPending = true }, 600 ) );
+		static_assert( IsAdvanceSameAsClocking( ScanlineCounter{ .Counter = 0, .Latch = 9, .IsReloadPending = true }, 600 ) );
+		static_assert( IsAdvanceSameAsClocking( ScanlineCounter{ .Counter = 3, .Latch = 7 }, 600 ) );
+		static_assert( IsAdvanceSameAsClocking( ScanlineCounter{ .Counter = 0, .Latch = 255 }, 1200 ) );
+		static_assert( IsAdvanceSameAsClocking( ScanlineCounter{ .Counter = 200, .Latch = 1, .HasReachedZero = true }, 600 ) );
+
+		// A12 rises at the first sprite pattern fetch (dot 260) when sprites use $1000 and the background $0000,
+		// or at the first background prefetch for the next line (dot 324) the other way around. Any other setup either
+		// never clocks the counter or clocks it irregularly.
+		static constexpr eScanlineCounterMode PredictScanlineCounterMode( const PpuRenderingConfiguration& configuration, uint16_t& outDot ) noexcept
+		{
+			outDot = 0;
+			if ( configuration.IsRenderingEnabled() == false )
+			{
+				return eScanlineCounterMode::STOPPED;
+			}
+
+			if ( configuration.IsSprite8x16 )
+			{
+				return eScanlineCounterMode::A12_CLOCKED;
+			}
+
+			if ( configuration.IsBackgroundPatternTableHigh == configuration.IsSpritePatternTableHigh )
+			{
+				return configuration.IsBackgroundPatternTableHigh ? eScanlineCounterMode::A12_CLOCKED : eScanlineCounterMode::STOPPED;
+			}
+
+			outDot = configuration.IsSpritePatternTableHigh ? 260 : 324;
+			return eScanlineCounterMode::PREDICTED;
+		}
+
+		// Register writes dispatch through this table; mapper numbers follow the iNES numbering
+		const Mapper::Descriptor Mapper::DESCRIPTORS[] =
+		{
+			{ 0, "NROM",	&Mapper::resetNrom,	&Mapper::updateNrom,	&Mapper::writeNrom,		false },
+			{ 1, "MMC1",	&Mapper::resetMmc1,	&Mapper::updateMmc1,	&Mapper::writeMmc1,		false },
+			{ 2, "UxROM",	&Mapper::resetNrom,	&Mapper::updateUxrom,	&Mapper::writeUxrom,	false },
+			{ 3, "CNROM",	&Mapper::resetNrom,	&Mapper::updateCnrom,	&Mapper::writeCnrom,	false },
+			{ 4, "MMC3",	&Mapper::resetMmc3,	&Mapper::updateMmc3,	&Mapper::writeMmc3,		true },
+		};
+
+		Mapper::Mapper( const RomImage& romImage, MapperState& state, CartridgeRamState& ram ) noexcept
+			: mDescriptor( findDescriptor( romImage.GetInfo().MapperNumber ) )
+			, mState( state )
+			, mPpuClockOrNull( nullptr )
+			, mHeaderMirroringType( romImage.GetInfo().MirroringType )
+			, mProgramRom( romImage.GetProgramRom().Data.GetData(), romImage.GetProgramRom().Data.GetSize() )
+			, mCharacterMemory( nullptr, 0 )
+			, mCharacterRamOrNull( nullptr )
+			, mProgramRam( ram.ProgramRam, romImage.GetInfo().ProgramRamSize + romImage.GetInfo().ProgramNvramSize )
+			, mCharacterRamTileCache()
+			, mTileCache( romImage.GetCharacterRom().Data.IsEmpty() ? mCharacterRamTileCache : romImage.GetCharacterRomTileCache() )
+			, mCharacterRamTileCacheOrNull( nullptr )
+			, mProgramPages()
+			, mCharacterPages()
+			, mNametableRamOrNull( nullptr )
+			, mNametablePages()
+		{
+			NM_ASSERT( mDescriptor != nullptr, "Unsupported mapper!!" );
+			NM_ASSERT( mProgramRom.GetSize() >= PROGRAM_PAGE_SIZE, "PRG-ROM is smaller than a page!!" );
+			NM_ASSERT( CartridgeRamState::CanHold( romImage.GetInfo() ), "Cartridge RAM does not fit in the console state!!" );
+
+			const RomImage::CharacterRom& characterRom = romImage.GetCharacterRom();
+			if ( characterRom.Data.IsEmpty() )
+			{
+				const CartridgeInfo& info = romImage.GetInfo();
+				const size_t characterRamSize = info.CharacterRamSize + info.CharacterNvramSize;
+				mCharacterMemory = ArrayView<const data_t>( ram.CharacterRam, characterRamSize );
+				mCharacterRamOrNull = ram.CharacterRam;
+				mCharacterRamTileCache.Build( ram.CharacterRam, characterRamSize );
+				mCharacterRamTileCacheOrNull = &mCharacterRamTileCache;
+			}
+			else
+			{
+				mCharacterMemory = ArrayView<const data_t>( characterRom.Data.GetData(), characterRom.Data.GetSize() );
+			}
+			NM_ASSERT( mCharacterMemory.GetSize() >= CHARACTER_PAGE_SIZE, "CHR memory is smaller than a page!!" );
+
+			Reset();
+		}
+
+		bool Mapper::IsSupported( const uint16_t mapperNumber ) noexcept
+		{
+			return findDescriptor( mapperNumber ) != nullptr;
+		}
+
+		void Mapper::Reset() noexcept
+		{
+			mState = {};
+			mState.ScanlineCounterSyncClock = getPpuClock();
+			mState.MirroringType = mHeaderMirroringType;
+			mDescriptor->Reset( *this );
+			Update();
+		}
+
+		void Mapper::Update() noexcept
+		{
+			mDescriptor->Update( *this );
+			updateNametablePages();
+		}
+
+		void Mapper::SetNametableRam( data_t* nametableRam ) noexcept
+		{
+			mNametableRamOrNull = nametableRam;
+			updateNametablePages();
+		}
+
+		void Mapper::WriteProgram( const address_t address, const data_t data ) noexcept
+		{
+			if ( address >= PROGRAM_ROM_ADDRESS )
+			{
+				mDescriptor->WriteRegister( *this, address, data );
+				return;
+			}
+
+			NM_ASSERT( address >= PROGRAM_RAM_ADDRESS, "Invalid address!!" );
+			const size_t offset = address - PROGRAM_RAM_ADDRESS;
+			if ( mState.IsProgramRamEnabled && offset < mProgramRam.GetSize() )
+			{
+				mProgramRam[offset] = data;
+			}
+		}
+
+		void Mapper::SetRenderingConfiguration( const PpuRenderingConfiguration& configuration ) noexcept
+		{
+			if ( HasScanlineCounter() == false )
+			{
+				return;
+			}
+
+			// Settle the counter under the old configuration before predicting under the new one
+			syncScanlineCounter();
+
+			uint16_t dot = 0;
+			mState.ScanlineCounterMode = PredictScanlineCounterMode( configuration, dot );
+			mState.ScanlineCounterDot = dot;
+			predictIrq();
+		}
+
+		void Mapper::ClockScanlineCounter() noexcept
+		{
+			NM_ASSERT( mState.ScanlineCounterMode == eScanlineCounterMode::A12_CLOCKED, "Scanline counter is clocked by PPU time!!" );
+			advanceScanlineCounter( 1 );
+			mState.ScanlineCounterSyncClock = getPpuClock();
+		}
+
+		bool Mapper::IsIrqAsserted() noexcept
+		{
+			if ( mState.IsIrqAsserted == false && getPpuClock() >= mState.IrqClock )
+			{
+				syncScanlineCounter();
+				predictIrq();
+			}
+
+			return mState.IsIrqAsserted;
+		}
+
+		uint32_t Mapper::getNumClocksUntilIrqCounterIsZero() const noexcept
+		{
+			return GetNumClocksUntilZero( ScanlineCounter{ .Counter = mState.IrqCounter, .Latch = mState.IrqLatch, .IsReloadPending = mState.IsIrqReloadPending } );
+		}
+
+		void Mapper::advanceScanlineCounter( const uint64_t numClocks ) noexcept
+		{
+			const ScanlineCounter counter = AdvanceScanlineCounter( ScanlineCounter{ .Counter = mState.IrqCounter, .Latch = mState.IrqLatch, .IsReloadPending = mState.IsIrqReloadPending }, numClocks );
+			mState.IrqCounter = counter.Counter;
+			mState.IsIrqReloadPending = counter.IsReloadPending;
+			mState.IsIrqAsserted |= counter.HasReachedZero && mState.IsIrqEnabled;
+		}
+
+		void Mapper::syncScanlineCounter() noexcept
+		{
+			const uint64_t ppuClock = getPpuClock();
+			if ( mState.ScanlineCounterMode == eScanlineCounterMode::PREDICTED && ppuClock > mState.ScanlineCounterSyncClock )
+			{
+				const uint16_t dot = mState.ScanlineCounterDot;
+				advanceScanlineCounter( CountScanlineCounterClocks( ppuClock, dot ) - CountScanlineCounterClocks( mState.ScanlineCounterSyncClock, dot ) );
+			}
+			mState.ScanlineCounterSyncClock = ppuClock;
+		}
+
+		void Mapper::predictIrq() noexcept
+		{
+			mState.IrqClock = MapperState::NEVER;
+			if ( mState.ScanlineCounterMode != eScanlineCounterMode::PREDICTED || mState.IsIrqEnabled == false || mState.IsIrqAsserted )
+			{
+				return;
+			}
+
+			const uint16_t dot = mState.ScanlineCounterDot;
+			const uint64_t clockIndex = CountScanlineCounterClocks( mState.ScanlineCounterSyncClock, dot ) + getNumClocksUntilIrqCounterIsZero() - 1;
+			mState.IrqClock = GetScanlineCounterClockTime( clockIndex, dot );
+		}
+
+		const Mapper::Descriptor* Mapper::findDescriptor( const uint16_t mapperNumber ) noexcept
+		{
+			for ( const Descriptor& descriptor : DESCRIPTORS )
+			{
+				if ( descriptor.MapperNumber == mapperNumber )
+				{
+					return &descriptor;
+				}
+			}
+
+			return nullptr;
+		}
+
+		void Mapper::setProgramBank( const size_t pageIndex, const size_t bankSize, const size_t bankIndex ) noexcept
+		{
+			NM_ASSERT( bankSize % PROGRAM_PAGE_SIZE == 0 && pageIndex + bankSize / PROGRAM_PAGE_SIZE <= NUM_PROGRAM_PAGES, "Invalid PRG bank!!" );
+			for ( size_t page = 0; page < bankSize / PROGRAM_PAGE_SIZE; ++page )
+			{
+				const size_t offset = ( bankIndex * bankSize + page * PROGRAM_PAGE_SIZE ) % mProgramRom.GetSize();
+				mProgramPages[pageIndex + page] = mProgramRom.GetData() + offset;
+			}
+		}
+
+		void Mapper::setCharacterBank( const size_t pageIndex, const size_t bankSize, const size_t bankIndex ) noexcept
+		{
+			NM_ASSERT( bankSize % CHARACTER_PAGE_SIZE == 0 && pageIndex + bankSize / CHARACTER_PAGE_SIZE <= NUM_CHARACTER_PAGES, "Invalid CHR bank!!" );
+			for ( size_t page = 0; page < bankSize / CHARACTER_PAGE_SIZE; ++page )
+			{
+				const size_t offset = ( bankIndex * bankSize + page * CHARACTER_PAGE_SIZE ) % mCharacterMemory.GetSize();
+				mCharacterPages[pageIndex + page] = mCharacterMemory.GetData() + offset;
+			}
+		}
+
+		void Mapper::setMirroringType( const eMirroringType mirroringType ) noexcept
+		{
+			if ( mirroringType != mState.MirroringType )
+			{
+				mState.MirroringType = mirroringType;
+				updateNametablePages();
+			}
+		}
+
+		// [REF]: https://www.nesdev.org/wiki/Mirroring
+		void Mapper::updateNametablePages() noexcept
+		{
+			// Which 1 KB of nametable RAM each of $2000, $2400, $2800 and $2C00 is
+			static constexpr const uint8_t PHYSICAL_PAGES[][NUM_NAMETABLE_PAGES] =
+			{
+				{ 0, 0, 1, 1 },	// HORIZONTAL
+				{ 0, 1, 0, 1 },	// VERTICAL
+				{ 0, 1, 2, 3 },	// FOUR_SCREEN
+				{ 0, 0, 0, 0 },	// SINGLE_SCREEN_LOWER
+				{ 1, 1, 1, 1 },	// SINGLE_SCREEN_UPPER
+			};
+			static_assert( ARRAYSIZE( PHYSICAL_PAGES ) == static_cast< size_t >( eMirroringType::COUNT ) );
+
+			NM_ASSERT( mState.MirroringType < eMirroringType::COUNT, "Invalid mirroring type!!" );
+			for ( size_t page = 0; page < NUM_NAMETABLE_PAGES; ++page )
+			{
+				mNametablePages[page] = mNametableRamOrNull != nullptr
+					? mNametableRamOrNull + PHYSICAL_PAGES[static_cast< size_t >( mState.MirroringType )][page] * NAMETABLE_PAGE_SIZE
+					: nullptr;
+			}
+		}
+
+		// [REF]: https://www.nesdev.org/wiki/NROM
+		void Mapper::resetNrom( Mapper& ) noexcept
+		{
+		}
+
+		void Mapper::updateNrom( Mapper& mapper ) noexcept
+		{
+			// NROM-128 mirrors its 16 KB into $C000-$FFFF
+			mapper.setProgramBank( 0, 32 * KILO_BYTE, 0 );
+			mapper.setCharacterBank( 0, 8 * KILO_BYTE, 0 );
+		}
+
+		void Mapper::writeNrom( Mapper&, const address_t, const data_t ) noexcept
+		{
+		}
+
+		// [REF]: https://www.nesdev.org/wiki/MMC1
+		void Mapper::resetMmc1( Mapper& mapper ) noexcept
+		{
+			// PRG-ROM mode 3: $C000-$FFFF fixed to the last bank, so the reset vector is always reachable
+			mapper.mState.Control = 0x0C;
+		}
+
+		void Mapper::updateMmc1( Mapper& mapper ) noexcept
+		{
+			static constexpr const eMirroringType MIRRORING_TYPES[] =
+			{
+				eMirroringType::SINGLE_SCREEN_LOWER,
+				eMirroringType::SINGLE_SCREEN_UPPER,
+				eMirroringType::VERTICAL,
+				eMirroringType::HORIZONTAL,
+			};
+
+			MapperState& state = mapper.mState;
+			const data_t characterBank0 = state.BankRegisters[0];
+			const data_t characterBank1 = state.BankRegisters[1];
+			const data_t programBank = state.BankRegisters[2] & 0x0F;
+
+			mapper.setMirroringType( MIRRORING_TYPES[state.Control & 0b11] );
+			state.IsProgramRamEnabled = ( state.BankRegisters[2] & 0x10 ) == 0;
+
+			switch ( ( state.Control >> 2 ) & 0b11 )
+			{
+			case 0:
+				[[fallthrough]];
+			case 1:
+				mapper.setProgramBank( 0, 32 * KILO_BYTE, programBank >> 1 );
+				break;
+			case 2:
+				mapper.setProgramBank( 0, 16 * KILO_BYTE, 0 );
+				mapper.setProgramBank( 2, 16 * KILO_BYTE, programBank );
+				break;
+			case 3:
+				mapper.setProgramBank( 0, 16 * KILO_BYTE, programBank );
+				mapper.setProgramBank( 2, 16 * KILO_BYTE, mapper.getNumProgramBanks( 16 * KILO_BYTE ) - 1 );
+				break;
+			default:
+				break;
+			}
+
+			if ( state.Control & 0x10 )
+			{
+				mapper.setCharacterBank( 0, 4 * KILO_BYTE, characterBank0 );
+				mapper.setCharacterBank( 4, 4 * KILO_BYTE, characterBank1 );
+			}
+			else
+			{
+				mapper.setCharacterBank( 0, 8 * KILO_BYTE, characterBank0 >> 1 );
+			}
+		}
+
+		void Mapper::writeMmc1( Mapper& mapper, const address_t address, const data_t data ) noexcept
+		{
+			// [TODO]: Writes on consecutive CPU cycles are ignored by the real chip
+			MapperState& state = mapper.mState;
+			if ( data & 0x80 )
+			{
+				state.ShiftRegister = 0;
+				state.ShiftCount = 0;
+				state.Control |= 0x0C;
+				updateMmc1( mapper );
+				return;
+			}
+
+			// Serial port: five writes, least significant bit first
+			state.ShiftRegister = static_cast< data_t >( ( state.ShiftRegister >> 1 ) | ( ( data & 1 ) << 4 ) );
+			if ( ++state.ShiftCount < 5 )
+			{
+				return;
+			}
+
+			const size_t registerIndex = ( address >> 13 ) & 0b11;	// $8000, $A000, $C000, $E000
+			if ( registerIndex == 0 )
+			{
+				state.Control = state.ShiftRegister;
+			}
+			else
+			{
+				state.BankRegisters[registerIndex - 1] = state.ShiftRegister;
+			}
+
+			state.ShiftRegister = 0;
+			state.ShiftCount = 0;
+			updateMmc1( mapper );
+		}
+
+		// [REF]: https://www.nesdev.org/wiki/UxROM
+		void Mapper::updateUxrom( Mapper& mapper ) noexcept
+		{
+			mapper.setProgramBank( 0, 16 * KILO_BYTE, mapper.mState.BankRegisters[0] );
+			mapper.setProgramBank( 2, 16 * KILO_BYTE, mapper.getNumProgramBanks( 16 * KILO_BYTE ) - 1 );
+			mapper.setCharacterBank( 0, 8 * KILO_BYTE, 0 );
+		}
+
+		void Mapper::writeUxrom( Mapper& mapper, const address_t, const data_t data ) noexcept
+		{
+			mapper.mState.BankRegisters[0] = data;
+			updateUxrom( mapper );
+		}
+
+		// [REF]: https://www.nesdev.org/wiki/CNROM
+		void Mapper::updateCnrom( Mapper& mapper ) noexcept
+		{
+			mapper.setProgramBank( 0, 32 * KILO_BYTE, 0 );
+			mapper.setCharacterBank( 0, 8 * KILO_BYTE, mapper.mState.BankRegisters[0] );
+		}
+
+		void Mapper::writeCnrom( Mapper& mapper, const address_t, const data_t data ) noexcept
+		{
+			mapper.mState.BankRegisters[0] = data;
+			updateCnrom( mapper );
+		}
+
+		// [REF]: https://www.nesdev.org/wiki/MMC3
+		void Mapper::resetMmc3( Mapper& mapper ) noexcept
+		{
+			// Power-on bank contents are unspecified; start from the first banks in order
+			static constexpr const data_t BANK_REGISTERS[MapperState::NUM_BANK_REGISTERS] = { 0, 2, 4, 5, 6, 7, 0, 1 };
+			memcpy( mapper.mState.BankRegisters, BANK_REGISTERS, sizeof( BANK_REGISTERS ) );
+		}
+
+		void Mapper::updateMmc3( Mapper& mapper ) noexcept
+		{
+			const MapperState& state = mapper.mState;
+			const data_t* bankRegisters = state.BankRegisters;
+			const size_t secondLastBank = mapper.getNumProgramBanks( 8 * KILO_BYTE ) - 2;
+
+			// PRG-ROM mode swaps $8000 and $C000; $A000 is R7 and $E000 the last bank either way
+			const bool isProgramRomModeSwapped = ( state.Control & 0x40 ) != 0;
+			mapper.setProgramBank( 0, 8 * KILO_BYTE, isProgramRomModeSwapped ? secondLastBank : ( bankRegisters[6] & 0x3F ) );
+			mapper.setProgramBank( 1, 8 * KILO_BYTE, bankRegisters[7] & 0x3F );
+			mapper.setProgramBank( 2, 8 * KILO_BYTE, isProgramRomModeSwapped ? ( bankRegisters[6] & 0x3F ) : secondLastBank );
+			mapper.setProgramBank( 3, 8 * KILO_BYTE, secondLastBank + 1 );
+
+			// CHR A12 inversion swaps the 2 KB banks at $0000-$0FFF with the 1 KB banks at $1000-$1FFF
+			const size_t twoKiloBytePage = ( state.Control & 0x80 ) ? 4 : 0;
+			const size_t oneKiloBytePage = 4 - twoKiloBytePage;
+			mapper.setCharacterBank( twoKiloBytePage + 0, 2 * KILO_BYTE, bankRegisters[0] >> 1 );
+			mapper.setCharacterBank( twoKiloBytePage + 2, 2 * KILO_BYTE, bankRegisters[1] >> 1 );
+			for ( size_t bank = 0; bank < 4; ++bank )
+			{
+				mapper.setCharacterBank( oneKiloBytePage + bank, 1 * KILO_BYTE, bankRegisters[2 + bank] );
+			}
+		}
+
+		void Mapper::writeMmc3( Mapper& mapper, const address_t address, const data_t data ) noexcept
+		{
+			MapperState& state = mapper.mState;
+			const bool isOdd = ( address & 1 ) != 0;
+			switch ( address & 0xE000 )
+			{
+			case 0x8000:
+				if ( isOdd )
+				{
+					state.BankRegisters[state.Control & 0b111] = data;
+				}
+				else
+				{
+					state.Control = data;
+				}
+				updateMmc3( mapper );
+				break;
+			case 0xA000:
+				if ( isOdd )
+				{
+					state.IsProgramRamEnabled = ( data & 0x80 ) != 0;
+				}
+				else if ( mapper.mHeaderMirroringType != eMirroringType::FOUR_SCREEN )
+				{
+					mapper.setMirroringType( ( data & 1 ) ? eMirroringType::HORIZONTAL : eMirroringType::VERTICAL );
+				}
+				break;
+			case 0xC000:
+				mapper.syncScanlineCounter();
+				if ( isOdd )
+				{
+					state.IrqCounter = 0;
+					state.IsIrqReloadPending = true;
+				}
+				else
+				{
+					state.IrqLatch = data;
+				}
+				mapper.predictIrq();
+				break;
+			case 0xE000:
+				// Disabling also acknowledges a pending IRQ
+				mapper.syncScanlineCounter();
+				state.IsIrqEnabled = isOdd;
+				if ( isOdd == false )
+				{
+					state.IsIrqAsserted = false;
+				}
+				mapper.predictIrq();
+				break;
+			default:
+				NM_ASSERT( false, "Invalid address!!" );
+				break;
+			}
+		}
+	}
+}
\ No newline at end of file
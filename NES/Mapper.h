@@ -0,0 +1,251 @@
+#pragma once
+
+#include "NES/Cartridge.h"
+#include "NES/PpuTiming.h"
+
+namespace ninmuse
+{
+	namespace nes
+	{
+		enum class eScanlineCounterMode : uint8_t
+		{
+			STOPPED,		// Rendering is off, or A12 never rises: the counter is not clocked
+			PREDICTED,		// A12 rises once per scanline at a known dot, so counter clocks and IRQs are computed from PPU time
+			A12_CLOCKED,	// Unpredictable A12 pattern (e.g. 8x16 sprites): the PPU calls ClockScanlineCounter() on every rise
+			COUNT,
+		};
+
+		// Mapper registers of the running cartridge. Plain bytes only, so they are saved, restored and cloned with
+		// the rest of the console state; the bank pointers derived from them live in Mapper and are rebuilt on load.
+		struct MapperState final
+		{
+			static constexpr const size_t NUM_BANK_REGISTERS = 8;
+			static constexpr const uint64_t NEVER = UINT64_MAX;
+
+			data_t			BankRegisters[NUM_BANK_REGISTERS] = {};	// MMC3 R0-R7; MMC1 CHR bank 0, CHR bank 1, PRG bank; UxROM/CNROM bank in [0]
+			data_t			Control = 0;							// MMC1 control, MMC3 bank select
+			data_t			ShiftRegister = 0;						// MMC1 serial port
+			data_t			ShiftCount = 0;
+			bool			IsProgramRamEnabled = true;
+			eMirroringType	MirroringType = eMirroringType::HORIZONTAL;
+
+			// MMC3 scanline counter
+			data_t			IrqLatch = 0;
+			data_t			IrqCounter = 0;
+			bool			IsIrqEnabled = false;
+			bool			IsIrqReloadPending = false;
+			bool			IsIrqAsserted = false;
+			eScanlineCounterMode
+							ScanlineCounterMode = eScanlineCounterMode::STOPPED;
+			uint16_t		ScanlineCounterDot = 0;				// Dot of every counter clock while PREDICTED
+			uint64_t		ScanlineCounterSyncClock = 0;		// PPU clock the counter is up to date with
+			uint64_t		IrqClock = NEVER;					// PPU clock at which the predicted IRQ asserts; the timed event to schedule
+		};
+		static_assert( std::is_trivially_copyable_v<MapperState> );
+
+		// RAM on the cartridge board. Sized for the largest boards the supported mappers come on, so it is saved, restored
+		// and cloned with the rest of the console state; the cartridge header decides how much of it is used.
+		struct CartridgeRamState final
+		{
+			static constexpr const size_t PROGRAM_RAM_CAPACITY		= 32 * KILO_BYTE;
+			static constexpr const size_t CHARACTER_RAM_CAPACITY	= 32 * KILO_BYTE;
+
+			data_t	ProgramRam[PROGRAM_RAM_CAPACITY] = {};		// Battery-backed part first; the cartridge mirrors it to the save file
+			data_t	CharacterRam[CHARACTER_RAM_CAPACITY] = {};
+
+			static inline constexpr bool	CanHold( const CartridgeInfo& info ) noexcept
+			{
+				return info.ProgramRamSize + info.ProgramNvramSize <= PROGRAM_RAM_CAPACITY && info.CharacterRamSize + info.CharacterNvramSize <= CHARACTER_RAM_CAPACITY;
+			}
+		};
+		static_assert( std::is_trivially_copyable_v<CartridgeRamState> );
+
+		// Maps cartridge memory into the CPU and PPU address spaces. The CPU sees $6000-$7FFF as one PRG-RAM page and
+		// $8000-$FFFF as four 8 KB PRG pages; the PPU sees $0000-$1FFF as eight 1 KB CHR pages and $2000-$2FFF as four
+		// 1 KB nametable pages. Bank switching and mirroring changes only rewrite these page pointers into the mapped ROM
+		// image, the cartridge RAM or the PPU's nametable RAM, and never copy contents.
+		class Mapper final
+		{
+		public:
+			static constexpr const address_t	PROGRAM_RAM_ADDRESS			= 0x6000;
+			static constexpr const address_t	PROGRAM_ROM_ADDRESS			= 0x8000;
+			static constexpr const size_t		PROGRAM_PAGE_SIZE			= 8 * KILO_BYTE;
+			static constexpr const size_t		NUM_PROGRAM_PAGES			= 4;
+			static constexpr const size_t		CHARACTER_PAGE_SIZE			= 1 * KILO_BYTE;
+			static constexpr const size_t		NUM_CHARACTER_PAGES			= 8;
+			static constexpr const size_t		NAMETABLE_PAGE_SIZE			= 1 * KILO_BYTE;
+			static constexpr const size_t		NUM_NAMETABLE_PAGES			= 4;	// Also the 1 KB pages of nametable RAM: two in the console, two on four-screen boards
+
+		public:
+			Mapper() = delete;
+			Mapper( const RomImage& romImage, MapperState& state, CartridgeRamState& ram ) noexcept;
+			Mapper( const Mapper& ) = delete;
+			Mapper( Mapper&& ) = delete;
+			~Mapper() = default;
+
+			Mapper& operator=( const Mapper& ) = delete;
+			Mapper& operator=( Mapper&& ) = delete;
+
+		public:
+			static bool				IsSupported( const uint16_t mapperNumber ) noexcept;
+
+			inline const char*		GetName() const noexcept { return mDescriptor->Name; }
+			inline eMirroringType	GetMirroringType() const noexcept { return mState.MirroringType; }
+
+			// Puts the registers in their power-on state
+			void					Reset() noexcept;
+			// Rebuilds every page pointer from the registers, e.g. after the state was loaded from a snapshot
+			void					Update() noexcept;
+			// After the CHR-RAM was replaced as a whole, e.g. by loading a snapshot
+			inline void				InvalidateCharacterRam() noexcept { mCharacterRamTileCache.InvalidateAll(); }
+
+			// CPU $6000-$FFFF
+			inline data_t			ReadProgram( const address_t address ) const noexcept;
+			// Returns the rest of the PRG page holding address, for code that walks instructions without going through the bus
+			inline const data_t*	GetProgramData( const address_t address ) const noexcept;
+			void					WriteProgram( const address_t address, const data_t data ) noexcept;
+
+			// PPU $0000-$1FFF
+			inline data_t			ReadCharacter( const address_t address ) const noexcept;
+			inline void				WriteCharacter( const address_t address, const data_t data ) noexcept;
+			// The eight pixels of the tile row whose low bitplane byte is at address, as color indices 0-3
+			inline const data_t*	GetDecodedTileRow( const address_t address, const bool isFlippedX ) noexcept;
+
+			// PPU $2000-$2FFF, mirrored up to $3EFF. The PPU hands over its NUM_NAMETABLE_PAGES KB of nametable RAM;
+			// the header and then the mapper's registers decide which page of it each nametable is.
+			void					SetNametableRam( data_t* nametableRam ) noexcept;
+			inline data_t*			GetNametable( const address_t address ) const noexcept { return mNametablePages[( address / NAMETABLE_PAGE_SIZE ) % NUM_NAMETABLE_PAGES]; }
+			// Where the byte at PPU address lives in CHR memory under the current banking
+			inline size_t			GetCharacterOffset( const address_t address ) const noexcept
+			{
+				NM_ASSERT( address < NUM_CHARACTER_PAGES * CHARACTER_PAGE_SIZE, "Invalid address!!" );
+				return static_cast<size_t>( mCharacterPages[address / CHARACTER_PAGE_SIZE] - mCharacterMemory.GetData() ) + address % CHARACTER_PAGE_SIZE;
+			}
+
+			// Scanline IRQ. The counter is not polled per dot: while the PPU fetches in a regular pattern, its clocks
+			// are derived from PPU time and the IRQ is a single timed event at GetIrqClock(). Only when the rendering
+			// configuration makes A12 unpredictable does the PPU fall back to calling ClockScanlineCounter() per rise.
+			inline bool				HasScanlineCounter() const noexcept { return mDescriptor->HasScanlineCounter; }
+			inline void				SetPpuClock( const uint64_t& ppuClock ) noexcept { mPpuClockOrNull = &ppuClock; }
+			void					SetRenderingConfiguration( const PpuRenderingConfiguration& configuration ) noexcept;
+			inline eScanlineCounterMode
+									GetScanlineCounterMode() const noexcept { return mState.ScanlineCounterMode; }
+			inline uint64_t			GetIrqClock() const noexcept { return mState.IrqClock; }
+			void					ClockScanlineCounter() noexcept;
+			bool					IsIrqAsserted() noexcept;
+
+		private:
+			struct Descriptor final
+			{
+				uint16_t	MapperNumber;
+				const char*	Name;
+				void		( *Reset )( Mapper& mapper ) noexcept;
+				void		( *Update )( Mapper& mapper ) noexcept;
+				void		( *WriteRegister )( Mapper& mapper, const address_t address, const data_t data ) noexcept;	// $8000-$FFFF
+				bool		HasScanlineCounter;
+			};
+
+			static const Descriptor	DESCRIPTORS[];
+			static const Descriptor* findDescriptor( const uint16_t mapperNumber ) noexcept;
+
+		private:
+			// Banks are numbered in units of their own size, and wrap around the ROM like the unconnected high bank lines do
+			void					setProgramBank( const size_t pageIndex, const size_t bankSize, const size_t bankIndex ) noexcept;
+			void					setCharacterBank( const size_t pageIndex, const size_t bankSize, const size_t bankIndex ) noexcept;
+			inline size_t			getNumProgramBanks( const size_t bankSize ) const noexcept { return mProgramRom.GetSize() / bankSize; }
+			void					setMirroringType( const eMirroringType mirroringType ) noexcept;
+			void					updateNametablePages() noexcept;
+
+			inline uint64_t			getPpuClock() const noexcept { return mPpuClockOrNull != nullptr ? *mPpuClockOrNull : mState.ScanlineCounterSyncClock; }
+			uint32_t				getNumClocksUntilIrqCounterIsZero() const noexcept;
+			void					advanceScanlineCounter( const uint64_t numClocks ) noexcept;
+			void					syncScanlineCounter() noexcept;
+			void					predictIrq() noexcept;
+
+			static void				resetNrom( Mapper& mapper ) noexcept;
+			static void				updateNrom( Mapper& mapper ) noexcept;
+			static void				writeNrom( Mapper& mapper, const address_t address, const data_t data ) noexcept;
+
+			static void				resetMmc1( Mapper& mapper ) noexcept;
+			static void				updateMmc1( Mapper& mapper ) noexcept;
+			static void				writeMmc1( Mapper& mapper, const address_t address, const data_t data ) noexcept;
+
+			static void				updateUxrom( Mapper& mapper ) noexcept;
+			static void				writeUxrom( Mapper& mapper, const address_t address, const data_t data ) noexcept;
+
+			static void				updateCnrom( Mapper& mapper ) noexcept;
+			static void				writeCnrom( Mapper& mapper, const address_t address, const data_t data ) noexcept;
+
+			static void				resetMmc3( Mapper& mapper ) noexcept;
+			static void				updateMmc3( Mapper& mapper ) noexcept;
+			static void				writeMmc3( Mapper& mapper, const address_t address, const data_t data ) noexcept;
+
+		private:
+			const Descriptor*		mDescriptor;
+			MapperState&			mState;
+			const uint64_t*			mPpuClockOrNull;
+			eMirroringType			mHeaderMirroringType;
+			ArrayView<const data_t>	mProgramRom;
+			ArrayView<const data_t>	mCharacterMemory;		// CHR-ROM, or CHR-RAM when the board has none
+			data_t*					mCharacterRamOrNull;	// Same memory as mCharacterMemory when it is writable
+			ArrayView<data_t>		mProgramRam;
+			TileCache				mCharacterRamTileCache;	// Empty when the board has CHR-ROM
+			const TileCache&		mTileCache;				// Shared by every console using the ROM image when it is CHR-ROM
+			TileCache*				mCharacterRamTileCacheOrNull;	// mCharacterRamTileCache when it is mTileCache
+			const data_t*			mProgramPages[NUM_PROGRAM_PAGES];
+			const data_t*			mCharacterPages[NUM_CHARACTER_PAGES];
+			data_t*					mNametableRamOrNull;
+			data_t*					mNametablePages[NUM_NAMETABLE_PAGES];	// Null until the PPU hands over its RAM
+		};
+
+		inline data_t Mapper::ReadProgram( const address_t address ) const noexcept
+		{
+			if ( address < PROGRAM_ROM_ADDRESS )
+			{
+				NM_ASSERT( address >= PROGRAM_RAM_ADDRESS, "Invalid address!!" );
+				const size_t offset = address - PROGRAM_RAM_ADDRESS;
+				return mState.IsProgramRamEnabled && offset < mProgramRam.GetSize() ? mProgramRam[offset] : 0;
+			}
+
+			const address_t offset = address - PROGRAM_ROM_ADDRESS;
+			return mProgramPages[offset / PROGRAM_PAGE_SIZE][offset % PROGRAM_PAGE_SIZE];
+		}
+
+		inline const data_t* Mapper::GetProgramData( const address_t address ) const noexcept
+		{
+			NM_ASSERT( address >= PROGRAM_ROM_ADDRESS, "Invalid address!!" );
+			const address_t offset = address - PROGRAM_ROM_ADDRESS;
+			return mProgramPages[offset / PROGRAM_PAGE_SIZE] + offset % PROGRAM_PAGE_SIZE;
+		}
+
+		inline data_t Mapper::ReadCharacter( const address_t address ) const noexcept
+		{
+			NM_ASSERT( address < NUM_CHARACTER_PAGES * CHARACTER_PAGE_SIZE, "Invalid address!!" );
+			return mCharacterPages[address / CHARACTER_PAGE_SIZE][address % CHARACTER_PAGE_SIZE];
+		}
+
+		inline void Mapper::WriteCharacter( const address_t address, const data_t data ) noexcept
+		{
+			NM_ASSERT( address < NUM_CHARACTER_PAGES * CHARACTER_PAGE_SIZE, "Invalid address!!" );
+			if ( mCharacterRamOrNull == nullptr )
+			{
+				return;
+			}
+
+			// Pages point into mCharacterMemory, which is mCharacterRamOrNull itself
+			const size_t offset = GetCharacterOffset( address );
+			mCharacterRamOrNull[offset] = data;
+			mCharacterRamTileCacheOrNull->Invalidate( offset );
+		}
+
+		inline const data_t* Mapper::GetDecodedTileRow( const address_t address, const bool isFlippedX ) noexcept
+		{
+			const size_t offset = GetCharacterOffset( address );
+			if ( mCharacterRamTileCacheOrNull != nullptr )
+			{
+				mCharacterRamTileCacheOrNull->Refresh( offset );
+			}
+			return mTileCache.GetRow( offset, isFlippedX );
+		}
+	}
+}
\ No newline at end of file
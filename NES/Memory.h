@@ -4,6 +4,7 @@
 
 #include "NES/ArrayView.h"
 #include "NES/DynamicArray.hpp"
+#include "NES/InlineArray.hpp"
 #include "NES/StaticArray.hpp"
 
 namespace ninmuse
@@ -30,6 +31,7 @@ namespace ninmuse
 	{
 	public:
 		ConsecutiveMemory() = default;
+		inline explicit ConsecutiveMemory( TArray&& data ) noexcept : mData( std::move( data ) ) {}
 		ConsecutiveMemory( const ConsecutiveMemory& ) = delete;
 		explicit ConsecutiveMemory( ConsecutiveMemory&& ) noexcept = default;
 		virtual ~ConsecutiveMemory() = default;
@@ -66,12 +68,12 @@ namespace ninmuse
 		ArrayView<nes::data_t>	mData;
 	};
 
-	template <Data TData>
+	template <Data TData, Array<TData> TArray = DynamicArray<TData>>
 	class IRam
 	{
 	public:
 		IRam() = delete;
-		IRam( const size_t capacity ) noexcept;
+		explicit IRam( TArray&& data ) noexcept;
 		IRam( const IRam& ) = delete;
 		explicit IRam( IRam&& ) noexcept = default;
 		virtual ~IRam() = default;
@@ -80,20 +82,31 @@ namespace ninmuse
 		IRam& operator=( IRam&& ) noexcept = default;
 
 	public:
-		inline constexpr ConsecutiveMemory<TData, DynamicArray<TData>>& GetMemory() noexcept { return mMemory; }
-		inline constexpr const ConsecutiveMemory<TData, DynamicArray<TData>>& GetMemory() const noexcept { return mMemory; }
+		inline constexpr ConsecutiveMemory<TData, TArray>& GetMemory() noexcept { return mMemory; }
+		inline constexpr const ConsecutiveMemory<TData, TArray>& GetMemory() const noexcept { return mMemory; }
 
 	protected:
-		ConsecutiveMemory<TData, DynamicArray<TData>>	mMemory;
+		ConsecutiveMemory<TData, TArray>	mMemory;
 	};
 
 	namespace nes
 	{
 		// [REF]: https://www.nesdev.org/wiki/CPU_memory_map
-		class NesRam final : public IRam<data_t>
+		class NesRam final : public IRam<data_t, ArrayView<data_t>>
 		{
 		public:
-			NesRam() noexcept;
+			static constexpr const size_t		ADDRESS_SPACE_SIZE				= 0x10000;
+
+		public:
+			NesRam() = delete;
+			// The memory itself is owned by the console state; NesRam only lays the memory map over it.
+			NesRam( data_t* memory, Arena& arena ) noexcept;
+
+			// Arena bytes NesRam needs for its mirror views
+			static inline constexpr size_t GetRequiredArenaSize() noexcept
+			{
+				return NUM_PPU_REGISTERS_MIRRORS * sizeof( ConsecutiveMemory8BitView ) + alignof( ConsecutiveMemory8BitView );
+			}
 
 		private:
 			// MEMORY MAP ADDRESS RANGE AND SIZE
@@ -119,13 +132,13 @@ namespace ninmuse
 			static constexpr const size_t		CARTRIDGE_SIZE					= 0x10000 - CARTRIDGE_ADDRESS;
 
 		private:
-			ConsecutiveMemory8BitView						mRam;					// 2 KB internal RAM
-			DynamicArray<ConsecutiveMemory8BitView>			mRamMirrors;			// Mirrors of the internal RAM
-			ConsecutiveMemory8BitView						mPpuRegisters;			// PPU registers
-			DynamicArray<ConsecutiveMemory8BitView>			mPpuRegistersMirrors;	// Mirrors of the PPU 
-			ConsecutiveMemory8BitView						mApuAndIoRegisters;		// APU and I/O registers
-			ConsecutiveMemory8BitView						mDisabledApuAndIo;		// APU and I/O functionality that is normally disabled.
-			ConsecutiveMemory8BitView						mCartridge;				// Cartridge space: PRG ROM, PRG RAM, and mapper registers
+			ConsecutiveMemory8BitView										mRam;					// 2 KB internal RAM
+			InlineArray<ConsecutiveMemory8BitView, NUM_RAM_MIRRORS>			mRamMirrors;			// Mirrors of the internal RAM
+			ConsecutiveMemory8BitView										mPpuRegisters;			// PPU registers
+			DynamicArray<ConsecutiveMemory8BitView, ArenaAllocator>			mPpuRegistersMirrors;	// Mirrors of the PPU 
+			ConsecutiveMemory8BitView										mApuAndIoRegisters;		// APU and I/O registers
+			ConsecutiveMemory8BitView										mDisabledApuAndIo;		// APU and I/O functionality that is normally disabled.
+			ConsecutiveMemory8BitView										mCartridge;				// Cartridge space: PRG ROM, PRG RAM, and mapper registers
 
 		private:
 			static_assert( RAM_MIRRORS_ADDRESS == 0x0800 );
@@ -139,6 +152,7 @@ namespace ninmuse
 			static_assert( DISABLED_APU_AND_IO_ADDRESS		== 0x4018 );
 			static_assert( CARTRIDGE_ADDRESS				== 0x4020 );
 			static_assert( CARTRIDGE_SIZE					== 0xBFE0 );
+			static_assert( CARTRIDGE_ADDRESS + CARTRIDGE_SIZE == ADDRESS_SPACE_SIZE );
 		};
 	}
 }
\ No newline at end of file
@@ -6,11 +6,10 @@
 
 namespace ninmuse
 {
-	template<Data TData>
-	inline IRam<TData>::IRam( const size_t capacity ) noexcept
-		: mMemory()
+	template<Data TData, Array<TData> TArray>
+	inline IRam<TData, TArray>::IRam( TArray&& data ) noexcept
+		: mMemory( std::move( data ) )
 	{
-		mMemory.GetData().SetSize( capacity );
 	}
 
 	template<Array<nes::data_t> TArray>
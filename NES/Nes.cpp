@@ -1,6 +1,6 @@
 #include "stdafx.h"
 
-#include "NES/Cartridge.h"
+#include "NES/Memory.hpp"
 #include "NES/Nes.h"
 
 namespace ninmuse
@@ -8,44 +8,262 @@ namespace ninmuse
     namespace nes
     {
 		Nes::Nes()
-			: mCartridgeOrNull()
-			, mMemoryMap()
-			, mCpu( mMemoryMap, nullptr )
+			: mCreationTime( std::chrono::steady_clock::now() )
+			, mStartupTimings()
+			, mCartridgeOrNull()
+			, mCartridgeLoading()
+			, mArena( ARENA_SIZE )
+			, mState( *std::construct_at( static_cast<NesState*>( mArena.Allocate( sizeof( NesState ), alignof( NesState ) ) ) ) )
+			, mMemoryMap( mState.CpuMemory, mArena )
+			, mCpu( mMemoryMap, nullptr, mState.Cpu )
+			, mPpu( mState.Ppu, mArena )
+			, mMapper()
+			, mIsDeferredRenderingEnabled( false )
+			, mDeferredRendererOrNull()
         {
+			NM_ASSERT( reinterpret_cast<std::byte*>( &mState ) == mArena.GetData() + STATE_OFFSET, "Console state must start the arena!!" );
+			mCpu.SetPpu( mPpu );
         }
 
         void Nes::InsertCartridge( std::unique_ptr<Cartridge>&& cartridge ) noexcept
         {
-            if ( mCartridgeOrNull != nullptr )
-            {
-                mCartridgeOrNull.release();
-            }
-
+            ejectCartridge();
             mCartridgeOrNull = std::move( cartridge );
         }
 
+        void Nes::InsertCartridge( std::future<std::unique_ptr<Cartridge>>&& cartridgeLoading ) noexcept
+        {
+            ejectCartridge();
+            mCartridgeLoading = std::move( cartridgeLoading );
+        }
+
 		void Nes::TurnOn() noexcept
 		{
-			readCartridge();
-            mCpu.SetRom( *mCartridgeOrNull );
-
-            mCpu.Run();
+			if ( PowerOn() )
+			{
+				Run();
+			}
         }
 
+		bool Nes::PowerOn() noexcept
+		{
+			const std::chrono::steady_clock::time_point waitStart = std::chrono::steady_clock::now();
+			if ( readCartridge() == false )
+			{
+				return false;
+			}
+
+			// A console that ran another cartridge before still holds its RAM
+			mState.CartridgeRam = {};
+			mCartridgeOrNull->ReadSaveData( mState.CartridgeRam.ProgramRam );
+			mMapper.emplace( *mCartridgeOrNull->GetRomImage(), mState.Mapper, mState.CartridgeRam );
+			mCpu.SetMapper( *mMapper );
+			mPpu.SetMapper( *mMapper );
+			if ( mIsDeferredRenderingEnabled )
+			{
+				mDeferredRendererOrNull = std::make_unique<DeferredRenderer>( mCartridgeOrNull->GetRomImage(), mState.CartridgeRam );
+			}
+
+			// Console state was built while the cartridge loaded; keep how much of the load was left to wait for
+			const std::chrono::steady_clock::time_point firstInstructionTime = std::chrono::steady_clock::now();
+			mStartupTimings.CartridgeWait = std::chrono::duration_cast<std::chrono::microseconds>( firstInstructionTime - waitStart );
+			mStartupTimings.TimeToFirstInstruction = std::chrono::duration_cast<std::chrono::microseconds>( firstInstructionTime - mCreationTime );
+
+			mCpu.PowerUp();
+#if defined(_DEBUG)
+			// Reset() must bring the console back to exactly this state
+			mPowerOnStateOrNull = std::make_unique<NesState>();
+			SaveState( *mPowerOnStateOrNull );
+#endif	// defined(_DEBUG)
+			return true;
+		}
+
+		void Nes::Run() noexcept
+		{
+			while ( true )
+			{
+				RunFrame();
+			}
+		}
+
         void Nes::TurnOff() noexcept
         {
+            if ( mCartridgeOrNull != nullptr )
+            {
+                mCartridgeOrNull->FlushSaveData( mState.CartridgeRam.ProgramRam, true );
+            }
+        }
+
+		void Nes::RunFrame() noexcept
+		{
+			// One branch per frame; each loop below is built for a single PPU engine
+			switch ( mPpu.GetAccuracy() )
+			{
+			case ePpuAccuracy::SCANLINE:
+				runFrame<ePpuAccuracy::SCANLINE>();
+				break;
+			case ePpuAccuracy::DOT:
+				runFrame<ePpuAccuracy::DOT>();
+				break;
+			default:
+				NM_ASSERT( false, "Invalid PPU accuracy!!" );
+				break;
+			}
+
+			if ( mPpu.GetFrameCount() % NUM_FRAMES_PER_SAVE_DATA_FLUSH == 0 && mCartridgeOrNull != nullptr )
+			{
+				mCartridgeOrNull->FlushSaveData( mState.CartridgeRam.ProgramRam, false );
+			}
+		}
+
+		void Nes::ReadFramebuffer( data_t* outFramebuffer ) const noexcept
+		{
+			if ( mDeferredRendererOrNull != nullptr )
+			{
+				mDeferredRendererOrNull->ReadFramebuffer( outFramebuffer );
+				return;
+			}
+
+			memcpy( outFramebuffer, mPpu.GetFramebuffer(), Ppu::FRAME_SIZE );
+		}
+
+		template <ePpuAccuracy Accuracy>
+		void Nes::runFrame() noexcept
+		{
+			// NTSC only, PAL and Dendy cartridges are refused by readCartridge
+			static constexpr const uint64_t NUM_DOTS_PER_CPU_CYCLE = 3;
+
+			const bool isDeferred = Accuracy == ePpuAccuracy::SCANLINE && mDeferredRendererOrNull != nullptr;
+			if ( isDeferred )
+			{
+				mPpu.SetFrameLog( &mDeferredRendererOrNull->BeginFrame( mState.Ppu, mState.Mapper ) );
+			}
+
+			const uint64_t frameCount = mPpu.GetFrameCount();
+			while ( mPpu.GetFrameCount() == frameCount )
+			{
+				// The CPU runs alone up to the next event it could notice; its PPU and mapper accesses in between catch the PPU up themselves
+				while ( mPpu.IsSyncDue() == false )
+				{
+					mCpu.Step();
+					mPpu.AdvanceCpuClock( NUM_DOTS_PER_CPU_CYCLE );
+				}
+				mPpu.CatchUp<Accuracy>();
+
+				// The interrupt lines only move at these syncs; a predicted mapper IRQ gets one of its own
+				mCpu.SetNonMaskableInterruptBar( mPpu.IsNmiAsserted() == false );
+				mCpu.SetInterruptRequestBar( mMapper->IsIrqAsserted() == false );
+			}
+
+			if ( isDeferred )
+			{
+				mPpu.SetFrameLog( nullptr );
+				mDeferredRendererOrNull->EndFrame( mPpu.GetClock() );
+			}
+		}
+
+		void Nes::SaveState( NesState& outState ) const noexcept
+		{
+			memcpy( &outState, &mState, sizeof( NesState ) );
+		}
+
+		void Nes::LoadState( const NesState& state ) noexcept
+		{
+			memcpy( &mState, &state, sizeof( NesState ) );
+			if ( mMapper.has_value() )
+			{
+				mMapper->Update();
+				mMapper->InvalidateCharacterRam();
+			}
+			if ( mDeferredRendererOrNull != nullptr )
+			{
+				mDeferredRendererOrNull->LoadCharacterRam( mState.CartridgeRam );
+			}
+			mPpu.Update();
+		}
+
+		void Nes::CopyStateFrom( const Nes& other ) noexcept
+		{
+			LoadState( other.mState );
+		}
+
+		void Nes::Reset() noexcept
+		{
+			static const NesState POWER_ON_STATE = {};
+
+			// Battery-backed PRG-RAM is the one part of the console that keeps its contents without power
+			const size_t programNvramSize = getProgramNvramSize();
+			DynamicArray<data_t> programNvram( programNvramSize );
+			programNvram.SetSize( programNvramSize );
+			memcpy( programNvram.GetData(), mState.CartridgeRam.ProgramRam, programNvramSize );
+			LoadState( POWER_ON_STATE );
+			memcpy( mState.CartridgeRam.ProgramRam, programNvram.GetData(), programNvramSize );
+
+			if ( mMapper.has_value() )
+			{
+				mMapper->Reset();
+				// The CPU fetches the reset vector again, same as at power-on
+				mCpu.PowerUp();
+			}
+#if defined(_DEBUG)
+			if ( mPowerOnStateOrNull != nullptr )
+			{
+				memcpy( mPowerOnStateOrNull->CartridgeRam.ProgramRam, programNvram.GetData(), programNvramSize );
+			}
+			NM_ASSERT( mPowerOnStateOrNull == nullptr || memcmp( &mState, mPowerOnStateOrNull.get(), sizeof( NesState ) ) == 0, "Reset console differs from a powered-on one!!" );
+#endif	// defined(_DEBUG)
+		}
+
+        void Nes::ejectCartridge() noexcept
+        {
+            // Battery-backed PRG-RAM is in the console state, so it has to reach the save file before the cartridge goes
+            if ( mCartridgeOrNull != nullptr && mMapper.has_value() )
+            {
+                mCartridgeOrNull->FlushSaveData( mState.CartridgeRam.ProgramRam, true );
+            }
+
+            // The mapper points into the cartridge being pulled out, and the CPU and PPU point to the mapper
+            mDeferredRendererOrNull.reset();
+            mCpu.RemoveMapper();
+            mPpu.RemoveMapper();
+            mMapper.reset();
+#if defined(_DEBUG)
+            mPowerOnStateOrNull.reset();
+#endif	// defined(_DEBUG)
+            mCartridgeOrNull.reset();
+            mCartridgeLoading = {};
         }
 
         bool Nes::readCartridge() noexcept
         {
+            if ( mCartridgeLoading.valid() )
+            {
+                mCartridgeOrNull = mCartridgeLoading.get();
+            }
+
             if ( mCartridgeOrNull == nullptr )
             {
                 return false;
             }
-            
-            mCartridgeOrNull->Read();
 
-            return true;
+            // The shared ROM image was parsed when it was opened
+            const std::shared_ptr<const RomImage>& romImage = mCartridgeOrNull->GetRomImage();
+            if ( romImage->IsValid() == false )
+            {
+                return false;
+            }
+
+            const bool isMapperSupported = Mapper::IsSupported( romImage->GetInfo().MapperNumber );
+            NM_ASSERT( isMapperSupported, "Unsupported mapper!!" );
+            const bool isRamSupported = CartridgeRamState::CanHold( romImage->GetInfo() );
+            NM_ASSERT( isRamSupported, "Cartridge RAM does not fit in the console state!!" );
+
+            // PpuTiming and runFrame are fixed to the RP2C02, so a PAL or Dendy cartridge would run fast and
+            // time its raster effects against the wrong frame. Multiple region cartridges run as NTSC.
+            const eCpuPpuTimingMode timingMode = romImage->GetInfo().CpuPpuTimingMode;
+            const bool isTimingSupported = timingMode == eCpuPpuTimingMode::RP2C02 || timingMode == eCpuPpuTimingMode::MULTIPLE_REGION;
+            NM_ASSERT( isTimingSupported, "Only NTSC CPU/PPU timing is supported!!" );
+            return isMapperSupported && isRamSupported && isTimingSupported;
         }
 
         void Nes::loadProgramRom() noexcept
@@ -57,5 +275,11 @@ namespace ninmuse
 
             //const Cartridge::ProgramRom& prgRom = mCartridgeOrNull->GetProgramRom();
         }
+
+		void PrintStartupTimings( const StartupTimings& timings ) noexcept
+		{
+			std::cout << "Waited " << timings.CartridgeWait.count() << " us for the cartridge, ";
+			std::cout << "time to first instruction: " << timings.TimeToFirstInstruction.count() << " us" << std::endl;
+		}
     }
 }
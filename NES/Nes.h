@@ -1,35 +1,118 @@
 #pragma once
 
+#include <chrono>
+#include <future>
+#include <optional>
+
 #include "Common.h"
 
+#include "NES/Allocator.h"
 #include "NES/Cpu.h"
+#include "NES/DeferredRenderer.h"
+#include "NES/Mapper.h"
 #include "NES/Memory.h"
+#include "NES/Ppu.h"
 
 namespace ninmuse
 {
 	namespace nes
 	{
-		class Cartridge;
+		// All mutable state of one console, the RAM on the cartridge included. It is placed at offset 0 of the console's arena, and
+		// every member starts on its own cache line, so snapshotting, restoring, cloning and resetting a console are each one memcpy.
+		// Only the save file of battery-backed PRG-RAM is outside; the cartridge copies it in at power-on and out at every flush.
+		struct alignas( CACHE_LINE_SIZE ) NesState final
+		{
+			alignas( CACHE_LINE_SIZE ) data_t				CpuMemory[NesRam::ADDRESS_SPACE_SIZE];
+			alignas( CACHE_LINE_SIZE ) Cpu6502::State		Cpu;
+			alignas( CACHE_LINE_SIZE ) MapperState			Mapper;
+			alignas( CACHE_LINE_SIZE ) PpuState				Ppu;
+			alignas( CACHE_LINE_SIZE ) CartridgeRamState	CartridgeRam;
+		};
+		static_assert( std::is_trivially_copyable_v<NesState> );
+		static_assert( offsetof( NesState, CpuMemory ) == 0 );
+		static_assert( offsetof( NesState, Cpu ) == NesRam::ADDRESS_SPACE_SIZE );
+		static_assert( offsetof( NesState, Mapper ) == NesRam::ADDRESS_SPACE_SIZE + sizeof( Cpu6502::State ) );
+		static_assert( offsetof( NesState, Ppu ) % CACHE_LINE_SIZE == 0 );
+		static_assert( sizeof( NesState ) % CACHE_LINE_SIZE == 0 );
+
+		// How long a cold start took, measured by Nes::PowerOn()
+		struct StartupTimings final
+		{
+			std::chrono::microseconds	CartridgeWait;			// Left to wait for the cartridge once the console state was built
+			std::chrono::microseconds	TimeToFirstInstruction;	// Since the console was created
+		};
+
+		void PrintStartupTimings( const StartupTimings& timings ) noexcept;
 
 		class Nes final
 		{
+		public:
+			static constexpr const size_t STATE_OFFSET	= 0;
+			static constexpr const size_t ARENA_SIZE	= sizeof( NesState ) + NesRam::GetRequiredArenaSize() + Ppu::GetRequiredArenaSize();
+			// Battery-backed RAM reaches the disk about once a second; TurnOff() is not reached while Run() loops
+			static constexpr const uint64_t NUM_FRAMES_PER_SAVE_DATA_FLUSH = 60;
+
 		public:
 			Nes();
 			~Nes() = default;
 
 			void	InsertCartridge( std::unique_ptr<Cartridge>&& cartridge ) noexcept;
+			// The cartridge is still being loaded on another thread; TurnOn() waits for it only once the console is ready
+			void	InsertCartridge( std::future<std::unique_ptr<Cartridge>>&& cartridgeLoading ) noexcept;
 
 			void	TurnOn() noexcept;
 			void	TurnOff() noexcept;
+			// TurnOn() in two steps: PowerOn() collects the cartridge and brings the CPU up to its first instruction, Run() never returns
+			bool	PowerOn() noexcept;
+			void	Run() noexcept;
+			inline const StartupTimings&
+					GetStartupTimings() const noexcept { return mStartupTimings; }
+			// Runs the CPU until the PPU finishes the visible part of a frame; the PPU catches up only where the CPU can tell
+			void	RunFrame() noexcept;
+			// Scanline by default; games that change PPU registers mid-scanline need DOT
+			inline void			SetPpuAccuracy( const ePpuAccuracy accuracy ) noexcept { mPpu.SetAccuracy( accuracy ); }
+			// Draws frames on a second core, one frame late; takes effect at TurnOn()
+			inline void			SetDeferredRendering( const bool isEnabled ) noexcept { mIsDeferredRenderingEnabled = isEnabled; }
+			// The latest finished frame, Ppu::FRAME_SIZE bytes: FRAME_WIDTH x FRAME_HEIGHT color indices and the line emphasis
+			void				ReadFramebuffer( data_t* outFramebuffer ) const noexcept;
+
+			inline const Ppu&	GetPpu() const noexcept { return mPpu; }
+
+			// State
+			inline constexpr const NesState&
+							GetState() const noexcept { return mState; }
+			void			SaveState( NesState& outState ) const noexcept;
+			void			LoadState( const NesState& state ) noexcept;
+			void			CopyStateFrom( const Nes& other ) noexcept;
+			void			Reset() noexcept;
 
 		private:
 			void					loadProgramRom() noexcept;
+			void					ejectCartridge() noexcept;
 			bool					readCartridge() noexcept;
+			inline size_t			getProgramNvramSize() const noexcept { return mCartridgeOrNull != nullptr ? mCartridgeOrNull->GetRomImage()->GetInfo().ProgramNvramSize : 0; }
+			template <ePpuAccuracy Accuracy>
+			void					runFrame() noexcept;
 
 		private:
+			std::chrono::steady_clock::time_point
+										mCreationTime;
+			StartupTimings				mStartupTimings;
 			std::unique_ptr<Cartridge>	mCartridgeOrNull;
+			std::future<std::unique_ptr<Cartridge>>
+										mCartridgeLoading;	// Valid until TurnOn() collects the cartridge
+			Arena						mArena;			// Backs every per-console allocation; must outlive everything below
+			NesState&					mState;			// At STATE_OFFSET of mArena
 			NesRam						mMemoryMap;
 			CpuNes						mCpu;
+			Ppu							mPpu;
+			std::optional<Mapper>		mMapper;		// Created once the cartridge is known; its registers live in mState
+			bool						mIsDeferredRenderingEnabled;
+			std::unique_ptr<DeferredRenderer>
+										mDeferredRendererOrNull;
+#if defined(_DEBUG)
+			std::unique_ptr<NesState>	mPowerOnStateOrNull;	// What Reset() must reproduce
+#endif	// defined(_DEBUG)
 		};
 	}
 }
\ No newline at end of file
@@ -0,0 +1,1082 @@
+#include "stdafx.h"
+
+#include <bit>
+
+#include "NES/DeferredRenderer.h"
+#include "NES/DynamicArray.hpp"
+#include "NES/Mapper.h"
+#include "NES/Ppu.h"
+#include "NES/TileDecoder.h"
+
+namespace ninmuse
+{
+	namespace nes
+	{
+		namespace
+		{
+			// Loopy scroll register fields of v and t
+			// [REF]: https://www.nesdev.org/wiki/PPU_scrolling
+			constexpr const address_t	COARSE_X				= 0x001F;
+			constexpr const address_t	COARSE_Y				= 0x03E0;
+			constexpr const address_t	NAMETABLE_SELECT		= 0x0C00;
+			constexpr const address_t	NAMETABLE_SELECT_X		= 0x0400;
+			constexpr const address_t	NAMETABLE_SELECT_Y		= 0x0800;
+			constexpr const address_t	FINE_Y					= 0x7000;
+			constexpr const address_t	HORIZONTAL_SCROLL		= COARSE_X | NAMETABLE_SELECT_X;
+			constexpr const address_t	VRAM_ADDRESS_MASK		= 0x3FFF;
+
+			constexpr const address_t	ATTRIBUTE_TABLE_OFFSET	= 0x03C0;
+			constexpr const uint32_t	TILE_SIZE				= static_cast< uint32_t >( TileDecoder::TILE_SIZE );
+			constexpr const uint32_t	TILE_BYTES				= static_cast< uint32_t >( TileDecoder::TILE_BYTES );
+			constexpr const uint32_t	NUM_FETCHED_TILES		= Ppu::FRAME_WIDTH / TILE_SIZE + 1;	// One more for the fine X scroll
+
+			// A line buffer pixel is a palette address (0-31); sprites carry two more flags above it
+			constexpr const data_t		PALETTE_ADDRESS_MASK	= 0x1F;
+			constexpr const data_t		SPRITE_PALETTE			= 0x10;
+			constexpr const data_t		SPRITE_BEHIND_BACKGROUND	= 0x20;
+			constexpr const data_t		SPRITE_ZERO				= 0x40;
+
+			constexpr const data_t		SPRITE_ATTRIBUTE_PALETTE		= 0x03;
+			constexpr const data_t		SPRITE_ATTRIBUTE_PRIORITY		= 0x20;
+			constexpr const data_t		SPRITE_ATTRIBUTE_FLIP_X			= 0x40;
+			constexpr const data_t		SPRITE_ATTRIBUTE_FLIP_Y			= 0x80;
+
+			constexpr const uint32_t	NO_EVENT				= PpuTiming::NUM_DOTS_PER_SCANLINE;
+
+			inline constexpr bool IsOpaque( const data_t pixel ) noexcept
+			{
+				return ( pixel & 0x03 ) != 0;
+			}
+
+			// $3F10/$3F14/$3F18/$3F1C are the same bytes as $3F00/$3F04/$3F08/$3F0C
+			inline constexpr size_t GetPaletteIndex( const address_t address ) noexcept
+			{
+				const size_t index = address & ( PpuState::PALETTE_SIZE - 1 );
+				return ( index & 0x13 ) == 0x10 ? index & ~static_cast< size_t >( 0x10 ) : index;
+			}
+			static_assert( GetPaletteIndex( 0x3F10 ) == 0x00 && GetPaletteIndex( 0x3F1C ) == 0x0C && GetPaletteIndex( 0x3F11 ) == 0x11 && GetPaletteIndex( 0x3F3F ) == 0x1F );
+
+			// Eight pixels at a time: the palette bits go into every byte whose 2-bit value is not zero
+			inline uint64_t ApplyTilePalette( const data_t* decodedRow, const data_t palette ) noexcept
+			{
+				static constexpr const uint64_t LOWEST_BIT_OF_EACH_BYTE = 0x0101'0101'0101'0101ull;
+				uint64_t pixels = 0;
+				memcpy( &pixels, decodedRow, sizeof( pixels ) );
+				return pixels | ( ( pixels | ( pixels >> 1 ) ) & LOWEST_BIT_OF_EACH_BYTE ) * palette;
+			}
+
+			// Dots at which the scanline renderer has something to do, in order: the first one at or after dot
+			inline constexpr uint32_t GetFirstEventDot( const uint32_t scanline, const uint32_t dot, const uint32_t renderDot, const uint32_t vblankScanline, const uint32_t vblankDot ) noexcept
+			{
+				if ( scanline < PpuTiming::NUM_VISIBLE_SCANLINES )
+				{
+					return dot <= renderDot ? renderDot : NO_EVENT;
+				}
+
+				if ( scanline == vblankScanline )
+				{
+					return dot <= vblankDot ? vblankDot : NO_EVENT;
+				}
+
+				if ( scanline == PpuTiming::PRE_RENDER_SCANLINE )
+				{
+					return dot <= vblankDot ? vblankDot : dot <= renderDot ? renderDot : NO_EVENT;
+				}
+
+				return NO_EVENT;
+			}
+		}
+
+		Ppu::Ppu( PpuState& state, Arena& arena ) noexcept
+			: mState( state )
+			, mMapperOrNull( nullptr )
+			, mFramebuffer( static_cast<data_t*>( arena.Allocate( FRAME_SIZE, Arena::DEFAULT_ALIGNMENT ) ) )
+			, mAccuracy( ePpuAccuracy::SCANLINE )
+			, mFrameLogOrNull( nullptr )
+			, mNametableCache( static_cast<data_t*>( arena.Allocate( NAMETABLE_CACHE_SIZE, Arena::DEFAULT_ALIGNMENT ) ) )
+			, mDirtyTiles()
+			, mWrittenPatterns()
+			, mCachedPatternPages()
+			, mNametableCacheStatistics()
+			, mScanlineSprites()
+			, mScanlineSpritesHeight( 0 )
+		{
+			NM_ASSERT( mFramebuffer != nullptr, "Failed to allocate the framebuffer!!" );
+			NM_ASSERT( mNametableCache != nullptr, "Failed to allocate the nametable cache!!" );
+			memset( mFramebuffer, 0, FRAME_SIZE );
+			invalidateNametableCache();
+		}
+
+		void Ppu::SetMapper( Mapper& mapper ) noexcept
+		{
+			static_assert( PpuState::NAMETABLE_SIZE == Mapper::NAMETABLE_PAGE_SIZE && PpuState::NUM_NAMETABLES == Mapper::NUM_NAMETABLE_PAGES );
+			mMapperOrNull = &mapper;
+			mMapperOrNull->SetPpuClock( mState.Clock );
+			mMapperOrNull->SetNametableRam( mState.NametableRam );
+			updateRenderingConfiguration();
+			invalidateNametableCache();
+		}
+
+		void Ppu::Update() noexcept
+		{
+			invalidateNametableCache();
+			mScanlineSpritesHeight = 0;
+		}
+
+		data_t Ppu::ReadRegister( const address_t address ) noexcept
+		{
+			data_t data = mState.IoLatch;
+			switch ( PpuRegisterMap::Control | ( address & PpuRegisterMap::RegisterMask ) )
+			{
+			case PpuRegisterMap::Status:
+				recordEvent( ePpuEventType::REGISTER_READ, address, 0 );
+				data = static_cast< data_t >( ( mState.Status & ( STATUS_VBLANK | STATUS_SPRITE_ZERO_HIT | STATUS_SPRITE_OVERFLOW ) ) | ( mState.IoLatch & 0x1F ) );
+				if ( IsNmiAsserted() )
+				{
+					requestSync();
+				}
+				mState.Status &= ~STATUS_VBLANK;
+				mState.IsWriteToggleSet = false;
+				break;
+			case PpuRegisterMap::OamData:
+				data = mState.Oam[mState.OamAddress];
+				break;
+			case PpuRegisterMap::Data:
+			{
+				recordEvent( ePpuEventType::REGISTER_READ, address, 0 );
+				const address_t vramAddress = mState.VramAddress & VRAM_ADDRESS_MASK;
+				if ( vramAddress < PALETTE_ADDRESS )
+				{
+					data = mState.ReadBuffer;
+					mState.ReadBuffer = readMemory( vramAddress );
+				}
+				else
+				{
+					// Palette reads are immediate; the buffer gets the nametable byte underneath
+					data = static_cast< data_t >( ( readMemory( vramAddress ) & 0x3F ) | ( mState.IoLatch & 0xC0 ) );
+					mState.ReadBuffer = readMemory( vramAddress - PATTERN_TABLE_SIZE );
+				}
+				mState.VramAddress += ( mState.Control & CONTROL_INCREMENT_32 ) != 0 ? 32 : 1;
+			}
+			break;
+			default:
+				// Write-only registers read back the bus
+				break;
+			}
+
+			mState.IoLatch = data;
+			return data;
+		}
+
+		void Ppu::WriteRegister( const address_t address, const data_t data ) noexcept
+		{
+			recordEvent( ePpuEventType::REGISTER_WRITE, address, data );
+			mState.IoLatch = data;
+			switch ( PpuRegisterMap::Control | ( address & PpuRegisterMap::RegisterMask ) )
+			{
+			case PpuRegisterMap::Control:
+			{
+				// Enabling NMI during vblank raises it again
+				const bool wasNmiAsserted = IsNmiAsserted();
+				mState.Control = data;
+				mState.TemporaryVramAddress = static_cast< address_t >( ( mState.TemporaryVramAddress & ~NAMETABLE_SELECT ) | ( ( data & CONTROL_NAMETABLE ) << 10 ) );
+				updateRenderingConfiguration();
+				if ( IsNmiAsserted() != wasNmiAsserted )
+				{
+					requestSync();
+				}
+			}
+			break;
+			case PpuRegisterMap::Mask:
+				mState.Mask = data;
+				updateRenderingConfiguration();
+				break;
+			case PpuRegisterMap::Status:
+				break;
+			case PpuRegisterMap::OamAddress:
+				mState.OamAddress = data;
+				break;
+			case PpuRegisterMap::OamData:
+				if ( mState.OamAddress % 4 == 0 )
+				{
+					mScanlineSpritesHeight = 0;
+				}
+				mState.Oam[mState.OamAddress++] = data;
+				break;
+			case PpuRegisterMap::Scroll:
+				if ( mState.IsWriteToggleSet == false )
+				{
+					mState.TemporaryVramAddress = static_cast< address_t >( ( mState.TemporaryVramAddress & ~COARSE_X ) | ( data >> 3 ) );
+					mState.FineScrollX = data & 0x07;
+				}
+				else
+				{
+					mState.TemporaryVramAddress = static_cast< address_t >( ( mState.TemporaryVramAddress & ~( FINE_Y | COARSE_Y ) ) | ( ( data & 0x07 ) << 12 ) | ( ( data & 0xF8 ) << 2 ) );
+				}
+				mState.IsWriteToggleSet = !mState.IsWriteToggleSet;
+				break;
+			case PpuRegisterMap::Address:
+				if ( mState.IsWriteToggleSet == false )
+				{
+					mState.TemporaryVramAddress = static_cast< address_t >( ( mState.TemporaryVramAddress & 0x00FF ) | ( ( data & 0x3F ) << 8 ) );
+				}
+				else
+				{
+					mState.TemporaryVramAddress = static_cast< address_t >( ( mState.TemporaryVramAddress & 0xFF00 ) | data );
+					mState.VramAddress = mState.TemporaryVramAddress;
+				}
+				mState.IsWriteToggleSet = !mState.IsWriteToggleSet;
+				break;
+			case PpuRegisterMap::Data:
+				writeMemory( mState.VramAddress & VRAM_ADDRESS_MASK, data );
+				mState.VramAddress += ( mState.Control & CONTROL_INCREMENT_32 ) != 0 ? 32 : 1;
+				break;
+			default:
+				NM_ASSERT( false, "Invalid address!!" );
+				break;
+			}
+		}
+
+		void Ppu::WriteOam( const data_t* page ) noexcept
+		{
+			if ( mFrameLogOrNull != nullptr )
+			{
+				const size_t pageOffset = mFrameLogOrNull->OamPages.GetSize();
+				NM_ASSERT( pageOffset + PpuState::OAM_SIZE <= UINT16_MAX + 1u, "Too many OAM DMAs in a frame!!" );
+				mFrameLogOrNull->OamPages.SetSize( pageOffset + PpuState::OAM_SIZE );
+				memcpy( mFrameLogOrNull->OamPages.GetData() + pageOffset, page, PpuState::OAM_SIZE );
+				recordEvent( ePpuEventType::OAM_DMA, static_cast< address_t >( pageOffset ), 0 );
+			}
+
+			// The copy goes through OAMDATA, so it starts at OAMADDR and wraps
+			for ( size_t offset = 0; offset < PpuState::OAM_SIZE; ++offset )
+			{
+				mState.Oam[mState.OamAddress++] = page[offset];
+			}
+			mScanlineSpritesHeight = 0;
+		}
+
+		void Ppu::CatchUp() noexcept
+		{
+			switch ( mAccuracy )
+			{
+			case ePpuAccuracy::SCANLINE:
+				CatchUp<ePpuAccuracy::SCANLINE>();
+				break;
+			case ePpuAccuracy::DOT:
+				CatchUp<ePpuAccuracy::DOT>();
+				break;
+			default:
+				NM_ASSERT( false, "Invalid PPU accuracy!!" );
+				break;
+			}
+		}
+
+		void Ppu::OnMapperRegisterWritten( const address_t address, const data_t data ) noexcept
+		{
+			recordEvent( ePpuEventType::MAPPER_WRITE, address, data );
+			scheduleSync();
+			// The write may acknowledge or disable the IRQ
+			if ( mMapperOrNull != nullptr && mMapperOrNull->HasScanlineCounter() )
+			{
+				requestSync();
+			}
+		}
+
+		void Ppu::scheduleSync() noexcept
+		{
+			// Vblank sets its flag and may raise NMI at the first dot the PPU processes past it
+			static constexpr const uint64_t VBLANK_CLOCK_IN_FRAME = static_cast< uint64_t >( VBLANK_SCANLINE ) * PpuTiming::NUM_DOTS_PER_SCANLINE + VBLANK_DOT;
+			uint64_t vblankClock = mState.Clock - mState.Clock % PpuTiming::NUM_DOTS_PER_FRAME + VBLANK_CLOCK_IN_FRAME;
+			if ( vblankClock < mState.Clock )
+			{
+				vblankClock += PpuTiming::NUM_DOTS_PER_FRAME;
+			}
+			mState.SyncClock = vblankClock + 1;
+
+			// An asserted NMI has to be seen released before the next vblank, or the CPU misses that edge
+			if ( IsNmiAsserted() )
+			{
+				static constexpr const uint64_t VBLANK_END_CLOCK_IN_FRAME = static_cast< uint64_t >( PpuTiming::PRE_RENDER_SCANLINE ) * PpuTiming::NUM_DOTS_PER_SCANLINE + VBLANK_DOT;
+				uint64_t vblankEndClock = mState.Clock - mState.Clock % PpuTiming::NUM_DOTS_PER_FRAME + VBLANK_END_CLOCK_IN_FRAME;
+				if ( vblankEndClock < mState.Clock )
+				{
+					vblankEndClock += PpuTiming::NUM_DOTS_PER_FRAME;
+				}
+				mState.SyncClock = std::min( mState.SyncClock, vblankEndClock + 1 );
+			}
+
+			// The mapper asserts its predicted IRQ once the PPU clock reaches it, and the console hands it to the CPU at
+			// this sync; stopping any later would delay the interrupt by however far the CPU ran ahead
+			if ( mMapperOrNull != nullptr && mMapperOrNull->GetIrqClock() > mState.Clock )
+			{
+				mState.SyncClock = std::min( mState.SyncClock, mMapperOrNull->GetIrqClock() );
+			}
+
+			// Sprite 0 hit and the other status flags are only seen through $2002, and every register access catches up first
+		}
+
+		void Ppu::recordEvent( const ePpuEventType type, const address_t address, const data_t data ) noexcept
+		{
+			if ( mFrameLogOrNull != nullptr )
+			{
+				mFrameLogOrNull->Events.PushBack( PpuEvent{ .Clock = mState.Clock, .Address = address, .Data = data, .Type = type } );
+			}
+		}
+
+		inline uint64_t Ppu::getScanlineSprites( const uint32_t scanline ) noexcept
+		{
+			NM_ASSERT( scanline < NUM_SPRITE_SCANLINES, "Invalid scanline!!" );
+			const uint32_t height = ( mState.Control & CONTROL_SPRITE_8X16 ) != 0 ? 2 * TILE_SIZE : TILE_SIZE;
+			if ( height != mScanlineSpritesHeight )
+			{
+				buildScanlineSprites( height );
+			}
+			return mScanlineSprites[scanline];
+		}
+
+		inline data_t Ppu::composePixel( const data_t backgroundPixel, const data_t spritePixel, const uint32_t x ) noexcept
+		{
+			data_t paletteAddress = backgroundPixel;
+			if ( IsOpaque( spritePixel ) )
+			{
+				if ( IsOpaque( backgroundPixel ) )
+				{
+					if ( ( spritePixel & SPRITE_ZERO ) != 0 && x != FRAME_WIDTH - 1 )
+					{
+						mState.Status |= STATUS_SPRITE_ZERO_HIT;
+					}
+
+					if ( ( spritePixel & SPRITE_BEHIND_BACKGROUND ) == 0 )
+					{
+						paletteAddress = spritePixel & PALETTE_ADDRESS_MASK;
+					}
+				}
+				else
+				{
+					paletteAddress = spritePixel & PALETTE_ADDRESS_MASK;
+				}
+			}
+
+			// Transparent pixels of every palette show the backdrop color
+			const data_t colorMask = ( mState.Mask & MASK_GRAYSCALE ) != 0 ? 0x30 : 0x3F;
+			return mState.Palette[IsOpaque( paletteAddress ) ? paletteAddress : 0] & colorMask;
+		}
+
+		void Ppu::runScanlines( const uint64_t numDots ) noexcept
+		{
+			NM_ASSERT( mMapperOrNull != nullptr, "The PPU runs without a cartridge!!" );
+
+			// Only the dots where a scanline renderer has work are visited; everything between them is skipped
+			const uint64_t targetClock = mState.Clock + numDots;
+			while ( true )
+			{
+				const uint64_t eventClock = getNextEventClock( mState.Clock );
+				if ( eventClock >= targetClock )
+				{
+					break;
+				}
+
+				mState.Clock = eventClock;
+				processEvent();
+				mState.Clock = eventClock + 1;
+			}
+
+			mState.Clock = targetClock;
+		}
+
+		inline size_t Ppu::getNametableOffset( const address_t address ) const noexcept
+		{
+			// Which physical nametable is under address is a lookup in the mapper's page table, whatever the mirroring
+			NM_ASSERT( mMapperOrNull != nullptr, "The PPU runs without a cartridge!!" );
+			return static_cast< size_t >( mMapperOrNull->GetNametable( address ) - mState.NametableRam ) + address % PpuState::NAMETABLE_SIZE;
+		}
+
+		inline data_t Ppu::readNametable( const address_t address ) const noexcept
+		{
+			NM_ASSERT( mMapperOrNull != nullptr, "The PPU runs without a cartridge!!" );
+			return mMapperOrNull->GetNametable( address )[address % PpuState::NAMETABLE_SIZE];
+		}
+
+		data_t Ppu::readMemory( const address_t address ) const noexcept
+		{
+			if ( address < NAMETABLE_ADDRESS )
+			{
+				return mMapperOrNull != nullptr ? mMapperOrNull->ReadCharacter( address ) : 0;
+			}
+
+			if ( address < PALETTE_ADDRESS )
+			{
+				return mMapperOrNull != nullptr ? readNametable( address ) : 0;
+			}
+
+			return mState.Palette[GetPaletteIndex( address )];
+		}
+
+		void Ppu::writeMemory( const address_t address, const data_t data ) noexcept
+		{
+			if ( address < NAMETABLE_ADDRESS )
+			{
+				if ( mMapperOrNull != nullptr )
+				{
+					mMapperOrNull->WriteCharacter( address, data );
+
+					// The same CHR page may be banked in more than once, so every address showing the written byte has a new tile
+					const size_t pageOffset = mMapperOrNull->GetCharacterOffset( address ) - address % Mapper::CHARACTER_PAGE_SIZE;
+					for ( size_t page = 0; page < Mapper::NUM_CHARACTER_PAGES; ++page )
+					{
+						const address_t pageAddress = static_cast< address_t >( page * Mapper::CHARACTER_PAGE_SIZE );
+						if ( mMapperOrNull->GetCharacterOffset( pageAddress ) == pageOffset )
+						{
+							const size_t tile = ( pageAddress + address % Mapper::CHARACTER_PAGE_SIZE ) / TILE_BYTES;
+							mWrittenPatterns[tile / 64] |= 1ull << ( tile % 64 );
+						}
+					}
+				}
+			}
+			else if ( address < PALETTE_ADDRESS )
+			{
+				if ( mMapperOrNull == nullptr )
+				{
+					return;
+				}
+
+				const size_t nametableOffset = getNametableOffset( address );
+				mState.NametableRam[nametableOffset] = data;
+				invalidateNametableCacheEntry( nametableOffset );
+			}
+			else
+			{
+				mState.Palette[GetPaletteIndex( address )] = data & 0x3F;
+			}
+		}
+
+		void Ppu::updateRenderingConfiguration() noexcept
+		{
+			if ( mMapperOrNull != nullptr )
+			{
+				mMapperOrNull->SetRenderingConfiguration( PpuRenderingConfiguration::FromRegisters( mState.Control, mState.Mask ) );
+			}
+		}
+
+		uint64_t Ppu::getNextEventClock( const uint64_t clock ) const noexcept
+		{
+			uint32_t scanline = PpuTiming::GetScanline( clock );
+			uint32_t dot = PpuTiming::GetDot( clock );
+			uint64_t scanlineClock = clock - dot;
+			while ( true )
+			{
+				const uint32_t eventDot = GetFirstEventDot( scanline, dot, RENDER_DOT, VBLANK_SCANLINE, VBLANK_DOT );
+				if ( eventDot != NO_EVENT )
+				{
+					return scanlineClock + eventDot;
+				}
+
+				scanlineClock += PpuTiming::NUM_DOTS_PER_SCANLINE;
+				scanline = ( scanline + 1 ) % PpuTiming::NUM_SCANLINES_PER_FRAME;
+				dot = 0;
+			}
+		}
+
+		void Ppu::processEvent() noexcept
+		{
+			const uint32_t scanline = PpuTiming::GetScanline( mState.Clock );
+			const uint32_t dot = PpuTiming::GetDot( mState.Clock );
+
+			if ( scanline == VBLANK_SCANLINE )
+			{
+				mState.Status |= STATUS_VBLANK;
+				++mState.FrameCount;
+				return;
+			}
+
+			if ( scanline == PpuTiming::PRE_RENDER_SCANLINE && dot == VBLANK_DOT )
+			{
+				mState.Status &= ~( STATUS_VBLANK | STATUS_SPRITE_ZERO_HIT | STATUS_SPRITE_OVERFLOW );
+				return;
+			}
+
+			if ( scanline < PpuTiming::NUM_VISIBLE_SCANLINES )
+			{
+				renderScanline( scanline );
+			}
+
+			if ( isRenderingEnabled() == false )
+			{
+				return;
+			}
+
+			if ( scanline < PpuTiming::NUM_VISIBLE_SCANLINES )
+			{
+				// Dots 256 and 257: next row, back to the left edge
+				incrementVerticalScroll();
+				mState.VramAddress = static_cast< address_t >( ( mState.VramAddress & ~HORIZONTAL_SCROLL ) | ( mState.TemporaryVramAddress & HORIZONTAL_SCROLL ) );
+			}
+			else
+			{
+				// Pre-render dots 257-304 copy all of t back for the next frame
+				mState.VramAddress = mState.TemporaryVramAddress;
+			}
+
+			// A scanline renderer has no A12 edges of its own; one counter clock per line is what the regular fetch pattern produces
+			if ( mMapperOrNull != nullptr && mMapperOrNull->GetScanlineCounterMode() == eScanlineCounterMode::A12_CLOCKED )
+			{
+				mMapperOrNull->ClockScanlineCounter();
+			}
+		}
+
+		void Ppu::renderScanline( const uint32_t scanline ) noexcept
+		{
+			data_t* line = mFramebuffer + static_cast< size_t >( scanline ) * FRAME_WIDTH;
+			mFramebuffer[FRAMEBUFFER_SIZE + scanline] = static_cast< data_t >( mState.Mask >> MASK_EMPHASIS_SHIFT );
+			data_t discardedLine[FRAME_WIDTH];
+			if ( mFrameLogOrNull != nullptr )
+			{
+				// The deferred renderer draws the line. Only the status flags are needed here, and sprite 0 hit only where sprite 0 is.
+				const bool isSpriteZeroHitPossible = ( mState.Mask & ( MASK_BACKGROUND | MASK_SPRITE ) ) == ( MASK_BACKGROUND | MASK_SPRITE )
+					&& ( getScanlineSprites( scanline ) & 1 ) != 0;
+				if ( isSpriteZeroHitPossible == false )
+				{
+					evaluateSpriteOverflow( scanline );
+					return;
+				}
+				line = discardedLine;
+			}
+			if ( isRenderingEnabled() == false )
+			{
+				memset( line, composePixel( 0, 0, 0 ), FRAME_WIDTH );
+				return;
+			}
+
+			data_t background[FRAME_WIDTH] = {};
+			data_t sprites[FRAME_WIDTH] = {};
+			if ( ( mState.Mask & MASK_BACKGROUND ) != 0 )
+			{
+				renderBackground( background );
+				if ( ( mState.Mask & MASK_BACKGROUND_LEFT ) == 0 )
+				{
+					memset( background, 0, TILE_SIZE );
+				}
+			}
+
+			if ( ( mState.Mask & MASK_SPRITE ) != 0 )
+			{
+				renderSprites( scanline, sprites );
+				if ( ( mState.Mask & MASK_SPRITE_LEFT ) == 0 )
+				{
+					memset( sprites, 0, TILE_SIZE );
+				}
+			}
+
+			for ( uint32_t x = 0; x < FRAME_WIDTH; ++x )
+			{
+				line[x] = composePixel( background[x], sprites[x], x );
+			}
+		}
+
+		void Ppu::renderBackground( data_t* outLine ) noexcept
+		{
+			const address_t vramAddress = mState.VramAddress;
+			const uint32_t row = ( vramAddress & COARSE_Y ) >> 5;
+			if ( row >= NUM_TILE_ROWS )
+			{
+				++mNametableCacheStatistics.NumUncachedScanlines;
+				fetchBackground( outLine );
+				return;
+			}
+
+			// The line starts in one nametable and runs into its horizontal neighbor, the way coarse X wraps while fetching.
+			// The tiles it covers are redrawn if needed, then the line is one window of the cache.
+			validateNametableCache();
+			const uint32_t column = vramAddress & COARSE_X;
+			const address_t nametableAddress = static_cast< address_t >( NAMETABLE_ADDRESS | ( vramAddress & NAMETABLE_SELECT ) );
+			const size_t leftNametable = getNametableOffset( nametableAddress ) / PpuState::NAMETABLE_SIZE;
+			const size_t rightNametable = getNametableOffset( nametableAddress ^ NAMETABLE_SELECT_X ) / PpuState::NAMETABLE_SIZE;
+			const uint32_t leftColumns = ~0u << column;
+			const uint32_t rightColumns = ( 2u << column ) - 1;
+			if ( leftNametable == rightNametable )
+			{
+				refreshNametableCacheTiles( leftNametable, row, leftColumns | rightColumns );
+			}
+			else
+			{
+				refreshNametableCacheTiles( leftNametable, row, leftColumns );
+				refreshNametableCacheTiles( rightNametable, row, rightColumns );
+			}
+
+			const size_t y = row * TILE_SIZE + ( ( vramAddress & FINE_Y ) >> 12 );
+			const size_t x = column * TILE_SIZE + mState.FineScrollX;
+			memcpy( outLine, mNametableCache + leftNametable * FRAMEBUFFER_SIZE + y * FRAME_WIDTH + x, FRAME_WIDTH - x );
+			memcpy( outLine + FRAME_WIDTH - x, mNametableCache + rightNametable * FRAMEBUFFER_SIZE + y * FRAME_WIDTH, x );
+		}
+
+		void Ppu::fetchBackground( data_t* outLine ) noexcept
+		{
+			// Copy the pre-decoded row of every tile on the line with its palette, then take the 256 pixels starting at the fine X scroll
+			data_t tilePixels[NUM_FETCHED_TILES * TILE_SIZE];
+			address_t vramAddress = mState.VramAddress;
+			const address_t patternTable = ( mState.Control & CONTROL_BACKGROUND_TABLE ) != 0 ? PATTERN_TABLE_SIZE : 0;
+			const address_t fineY = ( vramAddress & FINE_Y ) >> 12;
+			for ( uint32_t tileIndex = 0; tileIndex < NUM_FETCHED_TILES; ++tileIndex )
+			{
+				const address_t nametableAddress = NAMETABLE_ADDRESS | ( vramAddress & ( NAMETABLE_SELECT | COARSE_Y | COARSE_X ) );
+				const address_t attributeAddress = NAMETABLE_ADDRESS | ATTRIBUTE_TABLE_OFFSET | ( vramAddress & NAMETABLE_SELECT ) | ( ( vramAddress >> 4 ) & 0x38 ) | ( ( vramAddress >> 2 ) & 0x07 );
+				const data_t tile = readNametable( nametableAddress );
+				const data_t attribute = readNametable( attributeAddress );
+				const uint32_t attributeShift = ( ( vramAddress >> 4 ) & 0x04 ) | ( vramAddress & 0x02 );
+				const data_t palette = static_cast< data_t >( ( ( attribute >> attributeShift ) & 0x03 ) << 2 );
+
+				const address_t patternAddress = static_cast< address_t >( patternTable + tile * TILE_BYTES + fineY );
+				const uint64_t pixels = ApplyTilePalette( mMapperOrNull->GetDecodedTileRow( patternAddress, false ), palette );
+				memcpy( tilePixels + tileIndex * TILE_SIZE, &pixels, sizeof( pixels ) );
+
+				// Coarse X wraps into the horizontally adjacent nametable
+				if ( ( vramAddress & COARSE_X ) == COARSE_X )
+				{
+					vramAddress = static_cast< address_t >( ( vramAddress & ~COARSE_X ) ^ NAMETABLE_SELECT_X );
+				}
+				else
+				{
+					++vramAddress;
+				}
+			}
+
+
+			memcpy( outLine, tilePixels + mState.FineScrollX, FRAME_WIDTH );
+		}
+
+		void Ppu::validateNametableCache() noexcept
+		{
+			// Different banks or the other pattern table behind the background: every tile may have changed
+			const address_t patternTable = ( mState.Control & CONTROL_BACKGROUND_TABLE ) != 0 ? PATTERN_TABLE_SIZE : 0;
+			bool isPatternTableChanged = false;
+			for ( size_t page = 0; page < NUM_PATTERN_TABLE_PAGES; ++page )
+			{
+				const size_t pageOffset = mMapperOrNull->GetCharacterOffset( static_cast< address_t >( patternTable + page * Mapper::CHARACTER_PAGE_SIZE ) );
+				isPatternTableChanged |= pageOffset != mCachedPatternPages[page];
+				mCachedPatternPages[page] = pageOffset;
+			}
+
+			if ( isPatternTableChanged )
+			{
+				memset( mDirtyTiles, 0xFF, sizeof( mDirtyTiles ) );
+				memset( mWrittenPatterns, 0, sizeof( mWrittenPatterns ) );
+				return;
+			}
+
+			// CHR-RAM writes: every nametable entry showing a rewritten tile of this pattern table
+			const uint64_t* writtenPatterns = mWrittenPatterns + patternTable / TILE_BYTES / 64;
+			bool isAnyPatternWritten = false;
+			for ( size_t word = 0; word < NUM_TILES / 2 / 64; ++word )
+			{
+				isAnyPatternWritten |= writtenPatterns[word] != 0;
+			}
+
+			if ( isAnyPatternWritten )
+			{
+				for ( size_t nametableIndex = 0; nametableIndex < PpuState::NUM_NAMETABLES; ++nametableIndex )
+				{
+					const data_t* nametable = mState.NametableRam + nametableIndex * PpuState::NAMETABLE_SIZE;
+					for ( uint32_t entry = 0; entry < NUM_TILE_ROWS * NUM_TILE_COLUMNS; ++entry )
+					{
+						const data_t tile = nametable[entry];
+						if ( ( writtenPatterns[tile / 64] & ( 1ull << ( tile % 64 ) ) ) != 0 )
+						{
+							mDirtyTiles[nametableIndex][entry / NUM_TILE_COLUMNS] |= 1u << ( entry % NUM_TILE_COLUMNS );
+						}
+					}
+				}
+			}
+			memset( mWrittenPatterns, 0, sizeof( mWrittenPatterns ) );
+		}
+
+		void Ppu::refreshNametableCacheTiles( const size_t nametableIndex, const uint32_t row, const uint32_t columnMask ) noexcept
+		{
+			uint32_t dirtyColumns = mDirtyTiles[nametableIndex][row] & columnMask;
+			const uint32_t numMisses = static_cast< uint32_t >( std::popcount( dirtyColumns ) );
+			mNametableCacheStatistics.NumTileHits += static_cast< uint32_t >( std::popcount( columnMask ) ) - numMisses;
+			mNametableCacheStatistics.NumTileMisses += numMisses;
+
+			mDirtyTiles[nametableIndex][row] &= ~dirtyColumns;
+			while ( dirtyColumns != 0 )
+			{
+				drawNametableCacheTile( nametableIndex, row, static_cast< uint32_t >( std::countr_zero( dirtyColumns ) ) );
+				dirtyColumns &= dirtyColumns - 1;
+			}
+		}
+
+		void Ppu::drawNametableCacheTile( const size_t nametableIndex, const uint32_t row, const uint32_t column ) noexcept
+		{
+			const data_t* nametable = mState.NametableRam + nametableIndex * PpuState::NAMETABLE_SIZE;
+			const data_t tile = nametable[row * NUM_TILE_COLUMNS + column];
+			const data_t attribute = nametable[ATTRIBUTE_TABLE_OFFSET + ( row / 4 ) * ( NUM_TILE_COLUMNS / 4 ) + column / 4];
+			const uint32_t attributeShift = ( ( row & 0x02 ) << 1 ) | ( column & 0x02 );
+			const data_t palette = static_cast< data_t >( ( ( attribute >> attributeShift ) & 0x03 ) << 2 );
+
+			const address_t patternTable = ( mState.Control & CONTROL_BACKGROUND_TABLE ) != 0 ? PATTERN_TABLE_SIZE : 0;
+			data_t* outPixels = mNametableCache + nametableIndex * FRAMEBUFFER_SIZE + static_cast< size_t >( row ) * TILE_SIZE * FRAME_WIDTH + column * TILE_SIZE;
+			for ( uint32_t fineY = 0; fineY < TILE_SIZE; ++fineY )
+			{
+				const address_t patternAddress = static_cast< address_t >( patternTable + tile * TILE_BYTES + fineY );
+				const uint64_t pixels = ApplyTilePalette( mMapperOrNull->GetDecodedTileRow( patternAddress, false ), palette );
+				memcpy( outPixels + fineY * FRAME_WIDTH, &pixels, sizeof( pixels ) );
+			}
+		}
+
+		void Ppu::invalidateNametableCache() noexcept
+		{
+			// No CHR offset is SIZE_MAX, so the next line sees a new pattern table and redraws everything
+			for ( size_t page = 0; page < NUM_PATTERN_TABLE_PAGES; ++page )
+			{
+				mCachedPatternPages[page] = SIZE_MAX;
+			}
+		}
+
+		void Ppu::invalidateNametableCacheEntry( const size_t nametableOffset ) noexcept
+		{
+			const size_t nametableIndex = nametableOffset / PpuState::NAMETABLE_SIZE;
+			const uint32_t entry = static_cast< uint32_t >( nametableOffset % PpuState::NAMETABLE_SIZE );
+			if ( entry < ATTRIBUTE_TABLE_OFFSET )
+			{
+				mDirtyTiles[nametableIndex][entry / NUM_TILE_COLUMNS] |= 1u << ( entry % NUM_TILE_COLUMNS );
+				return;
+			}
+
+			// An attribute byte colors a 4x4 block of tiles
+			const uint32_t attributeIndex = entry - ATTRIBUTE_TABLE_OFFSET;
+			const uint32_t firstRow = ( attributeIndex / ( NUM_TILE_COLUMNS / 4 ) ) * 4;
+			const uint32_t columns = 0x0Fu << ( ( attributeIndex % ( NUM_TILE_COLUMNS / 4 ) ) * 4 );
+			for ( uint32_t row = firstRow; row < firstRow + 4 && row < NUM_TILE_ROWS; ++row )
+			{
+				mDirtyTiles[nametableIndex][row] |= columns;
+			}
+		}
+
+		void Ppu::evaluateSpriteOverflow( const uint32_t scanline ) noexcept
+		{
+			// The same count renderSprites() makes, without fetching anything
+			if ( ( mState.Mask & MASK_SPRITE ) == 0 )
+			{
+				return;
+			}
+
+			if ( std::popcount( getScanlineSprites( scanline ) ) > static_cast< int >( MAX_SPRITES_PER_SCANLINE ) )
+			{
+				mState.Status |= STATUS_SPRITE_OVERFLOW;
+			}
+		}
+
+		void Ppu::renderSprites( const uint32_t scanline, data_t* outLine ) noexcept
+		{
+			// Sprites are evaluated on the previous line, so OAM Y is one less than the first line a sprite is on.
+			// Lower OAM indices win, so a pixel is only taken if no earlier sprite was opaque there.
+			const bool isSprite8x16 = ( mState.Control & CONTROL_SPRITE_8X16 ) != 0;
+			const uint32_t height = isSprite8x16 ? 2 * TILE_SIZE : TILE_SIZE;
+			const address_t patternTable = ( mState.Control & CONTROL_SPRITE_TABLE ) != 0 ? PATTERN_TABLE_SIZE : 0;
+
+			// [TODO]: The hardware overflow check misreads OAM after the eighth sprite
+			uint64_t sprites = getScanlineSprites( scanline );
+			if ( std::popcount( sprites ) > static_cast< int >( MAX_SPRITES_PER_SCANLINE ) )
+			{
+				mState.Status |= STATUS_SPRITE_OVERFLOW;
+			}
+
+			for ( uint32_t numSprites = 0; sprites != 0 && numSprites < MAX_SPRITES_PER_SCANLINE; ++numSprites, sprites &= sprites - 1 )
+			{
+				const uint32_t spriteIndex = static_cast< uint32_t >( std::countr_zero( sprites ) );
+				const data_t* sprite = mState.Oam + spriteIndex * 4;
+				uint32_t row = scanline - 1 - sprite[0];
+
+				const data_t tile = sprite[1];
+				const data_t attributes = sprite[2];
+				const uint32_t x = sprite[3];
+				if ( ( attributes & SPRITE_ATTRIBUTE_FLIP_Y ) != 0 )
+				{
+					row = height - 1 - row;
+				}
+
+				// 8x16 sprites take their pattern table from bit 0 of the tile, and the bottom half is the next tile
+				const address_t patternAddress = isSprite8x16
+					? static_cast< address_t >( ( tile & 0x01 ) * PATTERN_TABLE_SIZE + ( tile & 0xFE ) * TILE_BYTES + ( row & TILE_SIZE ) * 2 + ( row & ( TILE_SIZE - 1 ) ) )
+					: static_cast< address_t >( patternTable + tile * TILE_BYTES + row );
+
+				const data_t* pixels = mMapperOrNull->GetDecodedTileRow( patternAddress, ( attributes & SPRITE_ATTRIBUTE_FLIP_X ) != 0 );
+				const data_t flags = static_cast< data_t >( SPRITE_PALETTE | ( ( attributes & SPRITE_ATTRIBUTE_PALETTE ) << 2 )
+					| ( ( attributes & SPRITE_ATTRIBUTE_PRIORITY ) != 0 ? SPRITE_BEHIND_BACKGROUND : 0 )
+					| ( spriteIndex == 0 ? SPRITE_ZERO : 0 ) );
+				for ( uint32_t pixel = 0; pixel < TILE_SIZE && x + pixel < FRAME_WIDTH; ++pixel )
+				{
+					const data_t value = pixels[pixel];
+					if ( value != 0 && outLine[x + pixel] == 0 )
+					{
+						outLine[x + pixel] = static_cast< data_t >( flags | value );
+					}
+				}
+			}
+		}
+
+		void Ppu::buildScanlineSprites( const uint32_t height ) noexcept
+		{
+			// Once per OAM change instead of 64 Y compares on every line. A sprite covers the lines after its OAM Y.
+			memset( mScanlineSprites, 0, sizeof( mScanlineSprites ) );
+			for ( uint32_t spriteIndex = 0; spriteIndex < PpuState::OAM_SIZE / 4; ++spriteIndex )
+			{
+				const uint64_t spriteBit = 1ull << spriteIndex;
+				const uint32_t firstScanline = mState.Oam[spriteIndex * 4] + 1u;
+				const uint32_t endScanline = std::min( firstScanline + height, NUM_SPRITE_SCANLINES );
+				for ( uint32_t scanline = firstScanline; scanline < endScanline; ++scanline )
+				{
+					mScanlineSprites[scanline] |= spriteBit;
+				}
+			}
+			mScanlineSpritesHeight = height;
+		}
+
+		void Ppu::incrementVerticalScroll() noexcept
+		{
+			// Fine Y, then coarse Y, which wraps into the vertically adjacent nametable after row 29
+			address_t vramAddress = mState.VramAddress;
+			if ( ( vramAddress & FINE_Y ) != FINE_Y )
+			{
+				vramAddress += 0x1000;
+			}
+			else
+			{
+				vramAddress &= ~FINE_Y;
+				address_t coarseY = ( vramAddress & COARSE_Y ) >> 5;
+				if ( coarseY == 29 )
+				{
+					coarseY = 0;
+					vramAddress ^= NAMETABLE_SELECT_Y;
+				}
+				else if ( coarseY == 31 )
+				{
+					coarseY = 0;
+				}
+				else
+				{
+					++coarseY;
+				}
+				vramAddress = static_cast< address_t >( ( vramAddress & ~COARSE_Y ) | ( coarseY << 5 ) );
+			}
+
+			mState.VramAddress = vramAddress;
+		}
+
+		void Ppu::runDots( const uint64_t numDots ) noexcept
+		{
+			NM_ASSERT( mMapperOrNull != nullptr, "The PPU runs without a cartridge!!" );
+
+			uint32_t scanline = PpuTiming::GetScanline( mState.Clock );
+			uint32_t dot = PpuTiming::GetDot( mState.Clock );
+			for ( uint64_t dotIndex = 0; dotIndex < numDots; ++dotIndex )
+			{
+				stepDot( scanline, dot );
+				++mState.Clock;
+
+				if ( ++dot == PpuTiming::NUM_DOTS_PER_SCANLINE )
+				{
+					dot = 0;
+					scanline = ( scanline + 1 ) % PpuTiming::NUM_SCANLINES_PER_FRAME;
+				}
+			}
+		}
+
+		void Ppu::stepDot( const uint32_t scanline, const uint32_t dot ) noexcept
+		{
+			if ( scanline == VBLANK_SCANLINE )
+			{
+				if ( dot == VBLANK_DOT )
+				{
+					mState.Status |= STATUS_VBLANK;
+					++mState.FrameCount;
+				}
+				return;
+			}
+
+			const bool isPreRenderScanline = scanline == PpuTiming::PRE_RENDER_SCANLINE;
+			if ( scanline >= PpuTiming::NUM_VISIBLE_SCANLINES && isPreRenderScanline == false )
+			{
+				return;
+			}
+
+			if ( isPreRenderScanline && dot == VBLANK_DOT )
+			{
+				mState.Status &= ~( STATUS_VBLANK | STATUS_SPRITE_ZERO_HIT | STATUS_SPRITE_OVERFLOW );
+			}
+
+			if ( isRenderingEnabled() )
+			{
+				fetchDot( scanline, dot );
+			}
+
+			if ( isPreRenderScanline == false && dot >= 1 && dot <= FRAME_WIDTH )
+			{
+				outputDot( scanline, dot - 1 );
+			}
+		}
+
+		void Ppu::fetchDot( const uint32_t scanline, const uint32_t dot ) noexcept
+		{
+			// [REF]: https://www.nesdev.org/wiki/PPU_rendering
+			// Each tile takes eight dots: nametable, attribute, low and high bitplane, two dots each. Dots 321-336 prefetch
+			// the first two tiles of the next line. The shifts move one pixel per dot and take a new tile every eighth.
+			const bool isFetchDot = ( dot >= 2 && dot <= FRAME_WIDTH + 1 ) || ( dot >= 321 && dot <= 337 );
+			if ( isFetchDot )
+			{
+				mState.PatternShifts[0] <<= 1;
+				mState.PatternShifts[1] <<= 1;
+				mState.AttributeShifts[0] <<= 1;
+				mState.AttributeShifts[1] <<= 1;
+
+				const address_t vramAddress = mState.VramAddress;
+				const address_t patternTable = ( mState.Control & CONTROL_BACKGROUND_TABLE ) != 0 ? PATTERN_TABLE_SIZE : 0;
+				const address_t patternAddress = static_cast< address_t >( patternTable + mState.NextTile * TILE_BYTES + ( ( vramAddress & FINE_Y ) >> 12 ) );
+				switch ( ( dot - 1 ) % TILE_SIZE )
+				{
+				case 0:
+					loadBackgroundShifts();
+					mState.NextTile = readNametable( NAMETABLE_ADDRESS | ( vramAddress & ( NAMETABLE_SELECT | COARSE_Y | COARSE_X ) ) );
+					break;
+				case 2:
+				{
+					const address_t attributeAddress = NAMETABLE_ADDRESS | ATTRIBUTE_TABLE_OFFSET | ( vramAddress & NAMETABLE_SELECT ) | ( ( vramAddress >> 4 ) & 0x38 ) | ( ( vramAddress >> 2 ) & 0x07 );
+					const uint32_t attributeShift = ( ( vramAddress >> 4 ) & 0x04 ) | ( vramAddress & 0x02 );
+					mState.NextAttribute = ( readNametable( attributeAddress ) >> attributeShift ) & 0x03;
+				}
+				break;
+				case 4:
+					observeA12( patternTable != 0 );
+					mState.NextPatternLow = mMapperOrNull->ReadCharacter( patternAddress );
+					break;
+				case 6:
+					mState.NextPatternHigh = mMapperOrNull->ReadCharacter( patternAddress + TILE_SIZE );
+					break;
+				case 7:
+					incrementHorizontalScroll();
+					break;
+				default:
+					break;
+				}
+			}
+
+			if ( dot == FRAME_WIDTH )
+			{
+				incrementVerticalScroll();
+			}
+			else if ( dot == FRAME_WIDTH + 1 )
+			{
+				mState.VramAddress = static_cast< address_t >( ( mState.VramAddress & ~HORIZONTAL_SCROLL ) | ( mState.TemporaryVramAddress & HORIZONTAL_SCROLL ) );
+
+				// Dots 257-320 evaluate and fetch the sprites of the next line. The pre-render line fetches nothing visible.
+				memset( mState.SpriteLine, 0, sizeof( mState.SpriteLine ) );
+				if ( scanline != PpuTiming::PRE_RENDER_SCANLINE )
+				{
+					renderSprites( scanline + 1, mState.SpriteLine );
+				}
+				mState.SpriteSlotTables = getSpriteSlotTables( scanline );
+			}
+			else if ( scanline == PpuTiming::PRE_RENDER_SCANLINE && dot >= 280 && dot <= 304 )
+			{
+				mState.VramAddress = static_cast< address_t >( ( mState.VramAddress & HORIZONTAL_SCROLL ) | ( mState.TemporaryVramAddress & ~HORIZONTAL_SCROLL ) );
+			}
+
+			// Each of the eight sprite slots fetches its low bitplane four dots into its eight, from dot 260 on
+			const uint32_t spriteFetchDot = dot - ( FRAME_WIDTH + 4 );
+			if ( dot >= FRAME_WIDTH + 4 && spriteFetchDot % TILE_SIZE == 0 && spriteFetchDot / TILE_SIZE < MAX_SPRITES_PER_SCANLINE )
+			{
+				observeA12( ( ( mState.SpriteSlotTables >> ( spriteFetchDot / TILE_SIZE ) ) & 1 ) != 0 );
+			}
+		}
+
+		data_t Ppu::getSpriteSlotTables( const uint32_t scanline ) noexcept
+		{
+			// 8x8 sprites all fetch from the table $2000 selects. 8x16 sprites take it from bit 0 of their tile, and
+			// a slot without a sprite fetches tile $FF, which is at $1000. The pre-render line fetches only empty slots.
+			if ( ( mState.Control & CONTROL_SPRITE_8X16 ) == 0 )
+			{
+				return ( mState.Control & CONTROL_SPRITE_TABLE ) != 0 ? 0xFF : 0x00;
+			}
+
+			data_t slotTables = 0xFF;
+			if ( scanline != PpuTiming::PRE_RENDER_SCANLINE )
+			{
+				uint64_t sprites = getScanlineSprites( scanline + 1 );
+				for ( uint32_t slot = 0; sprites != 0 && slot < MAX_SPRITES_PER_SCANLINE; ++slot, sprites &= sprites - 1 )
+				{
+					const data_t tile = mState.Oam[std::countr_zero( sprites ) * 4 + 1];
+					if ( ( tile & 0x01 ) == 0 )
+					{
+						slotTables &= static_cast< data_t >( ~( 1u << slot ) );
+					}
+				}
+			}
+			return slotTables;
+		}
+
+		void Ppu::outputDot( const uint32_t scanline, const uint32_t x ) noexcept
+		{
+			data_t backgroundPixel = 0;
+			if ( ( mState.Mask & MASK_BACKGROUND ) != 0 && ( x >= TILE_SIZE || ( mState.Mask & MASK_BACKGROUND_LEFT ) != 0 ) )
+			{
+				const uint32_t shift = 15 - mState.FineScrollX;
+				const data_t value = static_cast< data_t >( ( ( mState.PatternShifts[0] >> shift ) & 1 ) | ( ( ( mState.PatternShifts[1] >> shift ) & 1 ) << 1 ) );
+				const data_t palette = static_cast< data_t >( ( ( mState.AttributeShifts[0] >> shift ) & 1 ) | ( ( ( mState.AttributeShifts[1] >> shift ) & 1 ) << 1 ) );
+				backgroundPixel = value != 0 ? static_cast< data_t >( ( palette << 2 ) | value ) : 0;
+			}
+
+			data_t spritePixel = 0;
+			if ( ( mState.Mask & MASK_SPRITE ) != 0 && ( x >= TILE_SIZE || ( mState.Mask & MASK_SPRITE_LEFT ) != 0 ) )
+			{
+				spritePixel = mState.SpriteLine[x];
+			}
+
+			mFramebuffer[static_cast< size_t >( scanline ) * FRAME_WIDTH + x] = composePixel( backgroundPixel, spritePixel, x );
+
+			// [TODO]: Emphasis is kept per line; the last dot's, like the scanline engine, wins over a change mid-line
+			mFramebuffer[FRAMEBUFFER_SIZE + scanline] = static_cast< data_t >( mState.Mask >> MASK_EMPHASIS_SHIFT );
+		}
+
+		void Ppu::loadBackgroundShifts() noexcept
+		{
+			mState.PatternShifts[0] = static_cast< uint16_t >( ( mState.PatternShifts[0] & 0xFF00 ) | mState.NextPatternLow );
+			mState.PatternShifts[1] = static_cast< uint16_t >( ( mState.PatternShifts[1] & 0xFF00 ) | mState.NextPatternHigh );
+			mState.AttributeShifts[0] = static_cast< uint16_t >( ( mState.AttributeShifts[0] & 0xFF00 ) | ( ( mState.NextAttribute & 0x01 ) != 0 ? 0xFF : 0x00 ) );
+			mState.AttributeShifts[1] = static_cast< uint16_t >( ( mState.AttributeShifts[1] & 0xFF00 ) | ( ( mState.NextAttribute & 0x02 ) != 0 ? 0xFF : 0x00 ) );
+		}
+
+		void Ppu::incrementHorizontalScroll() noexcept
+		{
+			// Coarse X wraps into the horizontally adjacent nametable
+			if ( ( mState.VramAddress & COARSE_X ) == COARSE_X )
+			{
+				mState.VramAddress = static_cast< address_t >( ( mState.VramAddress & ~COARSE_X ) ^ NAMETABLE_SELECT_X );
+			}
+			else
+			{
+				++mState.VramAddress;
+			}
+		}
+
+		void Ppu::observeA12( const bool isA12High ) noexcept
+		{
+			// Only needed when the mapper cannot predict its scanline counter from PPU time
+			if ( isA12High == mState.IsA12High )
+			{
+				return;
+			}
+
+			mState.IsA12High = isA12High;
+			if ( isA12High == false )
+			{
+				mState.A12LowClock = mState.Clock;
+				return;
+			}
+
+			if ( mState.Clock - mState.A12LowClock >= A12_FILTER_DOTS && mMapperOrNull->GetScanlineCounterMode() == eScanlineCounterMode::A12_CLOCKED )
+			{
+				mMapperOrNull->ClockScanlineCounter();
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,290 @@
+#pragma once
+
+#include "NES/Allocator.h"
+#include "NES/PpuTiming.h"
+
+namespace ninmuse
+{
+	namespace nes
+	{
+		class Mapper;
+		struct PpuFrameLog;
+		enum class ePpuEventType : uint8_t;
+
+		// How finely the PPU interleaves with the CPU. Both engines share PpuState, so a console can switch between them
+		// per ROM; the choice is a template argument so neither pays for the other in its inner loop.
+		enum class ePpuAccuracy : uint8_t
+		{
+			SCANLINE,	// Whole scanlines at once: register writes take effect between lines
+			DOT,		// One dot at a time with the real fetch pipeline: mid-scanline writes and A12 edges land where they do on hardware
+			COUNT,
+		};
+
+		// [REF]: https://www.nesdev.org/wiki/PPU_registers
+		struct PpuRegisterMap final
+		{
+			static constexpr const address_t	Control				= 0x2000;	// PPUCTRL: NMI enable, sprite size, pattern tables, increment, base nametable
+			static constexpr const address_t	Mask				= 0x2001;	// PPUMASK: color emphasis, show sprites/background, grayscale
+			static constexpr const address_t	Status				= 0x2002;	// PPUSTATUS: vblank, sprite 0 hit, sprite overflow
+			static constexpr const address_t	OamAddress			= 0x2003;	// OAMADDR
+			static constexpr const address_t	OamData				= 0x2004;	// OAMDATA
+			static constexpr const address_t	Scroll				= 0x2005;	// PPUSCROLL: x then y
+			static constexpr const address_t	Address				= 0x2006;	// PPUADDR: high then low
+			static constexpr const address_t	Data				= 0x2007;	// PPUDATA
+			static constexpr const address_t	RegisterMask		= 0x0007;	// $2008-$3FFF mirror the eight registers
+			static constexpr const address_t	RegistersEnd		= 0x4000;
+
+			static constexpr const address_t	OamDma				= 0x4014;	// Copies $xx00-$xxFF into OAM
+		};
+
+		// Every mutable field of the PPU. Like the CPU and mapper state it is plain bytes, so it is saved,
+		// restored and cloned with the rest of the console. The framebuffer is output, not state, and lives in Ppu.
+		struct PpuState final
+		{
+			static constexpr const size_t	OAM_SIZE		= 256;
+			static constexpr const size_t	PALETTE_SIZE	= 32;
+			static constexpr const size_t	NAMETABLE_SIZE	= 1 * KILO_BYTE;
+			static constexpr const size_t	NUM_NAMETABLES	= 4;	// Two in the console, two more on four-screen boards
+
+			uint64_t	Clock = 0;						// Dots since power-on
+			uint64_t	FrameCount = 0;					// Frames whose visible scanlines are all rendered
+			uint64_t	CpuClock = 0;					// Where the CPU is, in dots; Clock lags behind it until the next catch-up
+			uint64_t	SyncClock = 0;					// CpuClock at which the CPU has to stop and let the PPU catch up
+			data_t		Control = 0;
+			data_t		Mask = 0;
+			data_t		Status = 0;
+			data_t		OamAddress = 0;
+			address_t	VramAddress = 0;				// v: yyy NN YYYYY XXXXX
+			address_t	TemporaryVramAddress = 0;		// t: same layout; the top left of the next frame
+			data_t		FineScrollX = 0;				// x
+			bool		IsWriteToggleSet = false;		// w: second write to $2005/$2006
+			data_t		ReadBuffer = 0;					// $2007 reads below the palette return the previous read
+			data_t		IoLatch = 0;					// Last value on the CPU data bus; unused $2002 bits read it back
+			data_t		Oam[OAM_SIZE] = {};
+			data_t		Palette[PALETTE_SIZE] = {};
+			data_t		NametableRam[NUM_NAMETABLES * NAMETABLE_SIZE] = {};
+
+			// Dot renderer pipeline
+			uint16_t	PatternShifts[2] = {};			// Bitplanes of the current and next background tile
+			uint16_t	AttributeShifts[2] = {};		// Palette bits, widened to one per pixel
+			data_t		NextTile = 0;
+			data_t		NextAttribute = 0;
+			data_t		NextPatternLow = 0;
+			data_t		NextPatternHigh = 0;
+			bool		IsA12High = false;				// Last pattern fetch was from $1000-$1FFF
+			uint64_t	A12LowClock = 0;				// When it last fell
+			data_t		SpriteSlotTables = 0;			// Bit n: sprite slot n of the next line fetches from $1000-$1FFF
+			data_t		SpriteLine[PpuTiming::NUM_VISIBLE_DOTS] = {};			// Sprite pixels of the current scanline, fetched during the previous one
+		};
+		static_assert( std::is_trivially_copyable_v<PpuState> );
+
+		// How often the scanline engine's nametable cache saves fetching a background tile
+		struct NametableCacheStatistics final
+		{
+			uint64_t	NumTileHits = 0;			// Tiles a scanline copied out of the cache as they were
+			uint64_t	NumTileMisses = 0;			// Tiles drawn again first: new nametable entry, attribute, pattern or CHR bank
+			uint64_t	NumUncachedScanlines = 0;	// Lines scrolled into the attribute rows, fetched tile by tile instead
+
+			inline double	GetHitRate() const noexcept
+			{
+				const uint64_t numTiles = NumTileHits + NumTileMisses;
+				return numTiles > 0 ? static_cast< double >( NumTileHits ) / static_cast< double >( numTiles ) : 0.0;
+			}
+		};
+
+		// Renders one scanline at a time into an indexed framebuffer of 6-bit NES color indices. There is no
+		// display behind it: a frontend, a test or a benchmark reads GetFramebuffer() once FrameCount advances,
+		// and only a frontend turns the indices into RGB, with a ColorConverter.
+		// Background tiles are fetched one 8-pixel row at a time (nametable, attribute, two bitplanes) instead of dot by dot,
+		// so register writes land between scanlines, not between pixels.
+		class Ppu final
+		{
+		public:
+			static constexpr const uint32_t		FRAME_WIDTH				= PpuTiming::NUM_VISIBLE_DOTS;
+			static constexpr const uint32_t		FRAME_HEIGHT			= PpuTiming::NUM_VISIBLE_SCANLINES;
+			static constexpr const size_t		FRAMEBUFFER_SIZE		= static_cast< size_t >( FRAME_WIDTH ) * FRAME_HEIGHT;
+			static constexpr const size_t		FRAME_SIZE				= FRAMEBUFFER_SIZE + FRAME_HEIGHT;	// The color indices, then the emphasis bits of every line
+			static constexpr const address_t	PALETTE_ADDRESS			= 0x3F00;
+			static constexpr const address_t	NAMETABLE_ADDRESS		= 0x2000;
+			static constexpr const address_t	PATTERN_TABLE_SIZE		= 0x1000;
+
+			static constexpr const size_t		NAMETABLE_CACHE_SIZE	= PpuState::NUM_NAMETABLES * FRAMEBUFFER_SIZE;	// One screen of pixels per nametable
+
+			static inline constexpr size_t		GetRequiredArenaSize() noexcept { return FRAME_SIZE + NAMETABLE_CACHE_SIZE + 2 * Arena::DEFAULT_ALIGNMENT; }
+
+		public:
+			Ppu() = delete;
+			Ppu( PpuState& state, Arena& arena ) noexcept;
+			Ppu( const Ppu& ) = delete;
+			Ppu( Ppu&& ) = delete;
+			~Ppu() = default;
+
+			Ppu& operator=( const Ppu& ) = delete;
+			Ppu& operator=( Ppu&& ) = delete;
+
+		public:
+			// The cartridge supplies the pattern tables and the nametable mirroring, and watches the rendering configuration
+			void					SetMapper( Mapper& mapper ) noexcept;
+			// Before the mapper is destroyed, e.g. when the cartridge is pulled out
+			inline void				RemoveMapper() noexcept { mMapperOrNull = nullptr; }
+			// After PpuState was replaced as a whole, e.g. by loading a state
+			void					Update() noexcept;
+
+			// CPU $2000-$3FFF
+			data_t					ReadRegister( const address_t address ) noexcept;
+			void					WriteRegister( const address_t address, const data_t data ) noexcept;
+			// CPU $4014; the 513 CPU cycles the copy stalls for are not modeled
+			void					WriteOam( const data_t* page ) noexcept;
+
+			// Advances numDots PPU dots, rendering every visible pixel it passes
+			template <ePpuAccuracy Accuracy>
+			inline void				Run( const uint64_t numDots ) noexcept;
+
+			// Catch-up scheduling. The CPU runs ahead and only reports its time through AdvanceCpuClock(); the PPU renders
+			// everything it owes in one batch when CatchUp() is called. The CPU bus calls it before every access that can see
+			// or change PPU state, and the console once IsSyncDue() says the CPU reached an event it sees without an access:
+			// vblank (the NMI edge and the end of the frame), the end of vblank, a predicted mapper IRQ, or an access that just
+			// moved an interrupt line. The console samples IsNmiAsserted() and the mapper's IRQ at every sync.
+			inline void				SetAccuracy( const ePpuAccuracy accuracy ) noexcept { mAccuracy = accuracy; }
+			inline ePpuAccuracy		GetAccuracy() const noexcept { return mAccuracy; }
+			inline void				AdvanceCpuClock( const uint64_t numDots ) noexcept { mState.CpuClock += numDots; }
+			inline bool				IsSyncDue() const noexcept { return mState.CpuClock >= mState.SyncClock; }
+			template <ePpuAccuracy Accuracy>
+			inline void				CatchUp() noexcept;
+			// Same, with the engine picked at run time; for the CPU bus
+			void					CatchUp() noexcept;
+			// After the CPU writes a mapper register: the write may move the next sync point, and a deferred frame needs it
+			void					OnMapperRegisterWritten( const address_t address, const data_t data ) noexcept;
+
+			// Deferred rendering. While a log is set, the scanline engine draws nothing and records every access that changes
+			// the picture, so a DeferredRenderer can draw the frame on another thread. Status flags are still computed here.
+			inline void				SetFrameLog( PpuFrameLog* logOrNull ) noexcept { mFrameLogOrNull = logOrNull; }
+
+			inline uint64_t			GetClock() const noexcept { return mState.Clock; }
+			inline uint64_t			GetFrameCount() const noexcept { return mState.FrameCount; }
+			inline bool				IsNmiAsserted() const noexcept { return ( mState.Status & STATUS_VBLANK ) != 0 && ( mState.Control & CONTROL_NMI ) != 0; }
+			inline const data_t*	GetFramebuffer() const noexcept { return mFramebuffer; }
+			// PPUMASK bits 5-7 (red, green, blue) each line was drawn with, FRAME_HEIGHT of them right after the framebuffer
+			inline const data_t*	GetLineEmphasis() const noexcept { return mFramebuffer + FRAMEBUFFER_SIZE; }
+			inline const NametableCacheStatistics&
+									GetNametableCacheStatistics() const noexcept { return mNametableCacheStatistics; }
+
+		private:
+			static constexpr const data_t		CONTROL_NAMETABLE		= 0x03;
+			static constexpr const data_t		CONTROL_INCREMENT_32	= 0x04;
+			static constexpr const data_t		CONTROL_SPRITE_TABLE	= 0x08;
+			static constexpr const data_t		CONTROL_BACKGROUND_TABLE	= 0x10;
+			static constexpr const data_t		CONTROL_SPRITE_8X16		= 0x20;
+			static constexpr const data_t		CONTROL_NMI				= 0x80;
+			static constexpr const data_t		MASK_GRAYSCALE			= 0x01;
+			static constexpr const data_t		MASK_BACKGROUND_LEFT	= 0x02;
+			static constexpr const data_t		MASK_SPRITE_LEFT		= 0x04;
+			static constexpr const data_t		MASK_BACKGROUND			= 0x08;
+			static constexpr const data_t		MASK_SPRITE				= 0x10;
+			static constexpr const uint32_t		MASK_EMPHASIS_SHIFT		= 5;
+			static constexpr const data_t		STATUS_SPRITE_OVERFLOW	= 0x20;
+			static constexpr const data_t		STATUS_SPRITE_ZERO_HIT	= 0x40;
+			static constexpr const data_t		STATUS_VBLANK			= 0x80;
+
+			static constexpr const uint32_t		RENDER_DOT				= 256;	// Where a scanline renderer commits the line: the last visible dot
+			static constexpr const uint32_t		VBLANK_SCANLINE			= 241;
+			static constexpr const uint32_t		VBLANK_DOT				= 1;
+			static constexpr const uint32_t		MAX_SPRITES_PER_SCANLINE	= 8;
+			static constexpr const uint64_t		A12_FILTER_DOTS			= 9;	// MMC3 ignores A12 rises after less than three CPU cycles low
+			static constexpr const uint32_t		NUM_TILE_COLUMNS		= 32;
+			static constexpr const uint32_t		NUM_TILE_ROWS			= 30;	// Coarse Y 30 and 31 are the attribute table; those lines skip the cache
+			static constexpr const size_t		NUM_TILES				= 2 * PATTERN_TABLE_SIZE / 16;
+			static constexpr const size_t		NUM_PATTERN_TABLE_PAGES	= 4;	// 1 KB CHR pages
+			static constexpr const uint32_t		NUM_SPRITE_SCANLINES	= PpuTiming::NUM_VISIBLE_SCANLINES + 1;	// The dot engine also evaluates for line 240
+
+			inline bool				isRenderingEnabled() const noexcept { return ( mState.Mask & ( MASK_BACKGROUND | MASK_SPRITE ) ) != 0; }
+
+			data_t					readMemory( const address_t address ) const noexcept;
+			void					writeMemory( const address_t address, const data_t data ) noexcept;
+			inline size_t			getNametableOffset( const address_t address ) const noexcept;
+			inline data_t			readNametable( const address_t address ) const noexcept;
+			void					updateRenderingConfiguration() noexcept;
+			void					scheduleSync() noexcept;
+			// Stops the CPU after its current cycle, so the console sees an interrupt line the access moved
+			inline void				requestSync() noexcept { mState.SyncClock = mState.CpuClock; }
+			void					recordEvent( const ePpuEventType type, const address_t address, const data_t data ) noexcept;
+
+			inline data_t			composePixel( const data_t backgroundPixel, const data_t spritePixel, const uint32_t x ) noexcept;
+
+			// Scanline engine
+			void					runScanlines( const uint64_t numDots ) noexcept;
+			uint64_t				getNextEventClock( const uint64_t clock ) const noexcept;
+			void					processEvent() noexcept;
+			void					renderScanline( const uint32_t scanline ) noexcept;
+			void					evaluateSpriteOverflow( const uint32_t scanline ) noexcept;
+			void					renderBackground( data_t* outLine ) noexcept;
+			void					fetchBackground( data_t* outLine ) noexcept;
+			void					validateNametableCache() noexcept;
+			void					refreshNametableCacheTiles( const size_t nametableIndex, const uint32_t row, const uint32_t columnMask ) noexcept;
+			void					drawNametableCacheTile( const size_t nametableIndex, const uint32_t row, const uint32_t column ) noexcept;
+			void					invalidateNametableCache() noexcept;
+			void					invalidateNametableCacheEntry( const size_t nametableOffset ) noexcept;
+			void					renderSprites( const uint32_t scanline, data_t* outLine ) noexcept;
+			data_t					getSpriteSlotTables( const uint32_t scanline ) noexcept;
+			inline uint64_t			getScanlineSprites( const uint32_t scanline ) noexcept;
+			void					buildScanlineSprites( const uint32_t height ) noexcept;
+			void					incrementVerticalScroll() noexcept;
+
+			// Dot engine
+			void					runDots( const uint64_t numDots ) noexcept;
+			void					stepDot( const uint32_t scanline, const uint32_t dot ) noexcept;
+			void					fetchDot( const uint32_t scanline, const uint32_t dot ) noexcept;
+			void					outputDot( const uint32_t scanline, const uint32_t x ) noexcept;
+			void					loadBackgroundShifts() noexcept;
+			void					incrementHorizontalScroll() noexcept;
+			void					observeA12( const bool isA12High ) noexcept;
+
+		private:
+			PpuState&				mState;
+			Mapper*					mMapperOrNull;
+			data_t*					mFramebuffer;	// FRAME_SIZE bytes: color indices and line emphasis, in mState's arena
+			ePpuAccuracy			mAccuracy;
+			PpuFrameLog*			mFrameLogOrNull;
+
+			// Scanline engine background cache: every physical nametable drawn as 256x240 palette addresses, redrawn a tile
+			// at a time when its entry or attribute is written, when CHR-RAM under its pattern changes, or when the
+			// background pattern table or its banks change. Derived from PpuState and CHR memory, so it is not state itself.
+			data_t*					mNametableCache;
+			uint32_t				mDirtyTiles[PpuState::NUM_NAMETABLES][NUM_TILE_ROWS];	// One bit per tile column
+			uint64_t				mWrittenPatterns[NUM_TILES / 64];		// Tiles of $0000-$1FFF written since the cache last checked
+			size_t					mCachedPatternPages[NUM_PATTERN_TABLE_PAGES];	// CHR offsets the cache was drawn from
+			NametableCacheStatistics
+									mNametableCacheStatistics;
+
+			// Sprite evaluation table: bit n of a line is set when OAM sprite n covers it. Rebuilt when OAM Y or the sprite
+			// height changes, so a line finds its sprites in OAM order and counts them with a popcount.
+			uint64_t				mScanlineSprites[NUM_SPRITE_SCANLINES];
+			uint32_t				mScanlineSpritesHeight;	// Sprite height the table was built for; 0 until it is built
+		};
+
+		template <ePpuAccuracy Accuracy>
+		inline void Ppu::Run( const uint64_t numDots ) noexcept
+		{
+			static_assert( Accuracy < ePpuAccuracy::COUNT );
+			if constexpr ( Accuracy == ePpuAccuracy::DOT )
+			{
+				runDots( numDots );
+			}
+			else
+			{
+				runScanlines( numDots );
+			}
+		}
+
+		template <ePpuAccuracy Accuracy>
+		inline void Ppu::CatchUp() noexcept
+		{
+			// The benchmark and tests drive the PPU directly with Run(), ahead of a CPU that never moves
+			if ( mState.CpuClock > mState.Clock )
+			{
+				Run<Accuracy>( mState.CpuClock - mState.Clock );
+			}
+			scheduleSync();
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "NES/Common.h"
+
+namespace ninmuse
+{
+	namespace nes
+	{
+		// [REF]: https://www.nesdev.org/wiki/PPU_frame_timing
+		// PPU time is counted in dots since power-on. The dot skipped on odd frames is not modeled.
+		// The geometry is the NTSC RP2C02 one. Nes refuses PAL and Dendy cartridges at power-on rather than run them on it.
+		struct PpuTiming final
+		{
+			static constexpr const uint32_t	NUM_DOTS_PER_SCANLINE	= 341;
+			static constexpr const uint32_t	NUM_VISIBLE_DOTS		= 256;
+			static constexpr const uint32_t	NUM_VISIBLE_SCANLINES	= 240;
+			static constexpr const uint32_t	PRE_RENDER_SCANLINE		= 261;
+			static constexpr const uint32_t	NUM_SCANLINES_PER_FRAME	= PRE_RENDER_SCANLINE + 1;
+			static constexpr const uint64_t	NUM_DOTS_PER_FRAME		= static_cast< uint64_t >( NUM_DOTS_PER_SCANLINE ) * NUM_SCANLINES_PER_FRAME;
+
+			static inline constexpr uint32_t	GetScanline( const uint64_t ppuClock ) noexcept { return static_cast< uint32_t >( ppuClock % NUM_DOTS_PER_FRAME / NUM_DOTS_PER_SCANLINE ); }
+			static inline constexpr uint32_t	GetDot( const uint64_t ppuClock ) noexcept { return static_cast< uint32_t >( ppuClock % NUM_DOTS_PER_SCANLINE ); }
+		};
+		static_assert( PpuTiming::NUM_DOTS_PER_FRAME == 89'342 );
+
+		// What the PPU is set up to fetch, from PPUCTRL ($2000) and PPUMASK ($2001).
+		// Enough to tell when the pattern table address line A12 rises during a scanline.
+		struct PpuRenderingConfiguration final
+		{
+			bool	IsBackgroundEnabled				= false;
+			bool	IsSpriteEnabled					= false;
+			bool	IsBackgroundPatternTableHigh	= false;	// Background tiles at $1000
+			bool	IsSpritePatternTableHigh		= false;	// 8x8 sprite tiles at $1000
+			bool	IsSprite8x16					= false;	// Each sprite picks its own pattern table
+
+			inline constexpr bool	IsRenderingEnabled() const noexcept { return IsBackgroundEnabled || IsSpriteEnabled; }
+
+			static inline constexpr PpuRenderingConfiguration FromRegisters( const data_t control, const data_t mask ) noexcept
+			{
+				return PpuRenderingConfiguration
+				{
+					.IsBackgroundEnabled = ( mask & 0x08 ) != 0,
+					.IsSpriteEnabled = ( mask & 0x10 ) != 0,
+					.IsBackgroundPatternTableHigh = ( control & 0x10 ) != 0,
+					.IsSpritePatternTableHigh = ( control & 0x08 ) != 0,
+					.IsSprite8x16 = ( control & 0x20 ) != 0,
+				};
+			}
+		};
+	}
+}
\ No newline at end of file
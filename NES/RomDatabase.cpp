@@ -0,0 +1,157 @@
+#include "stdafx.h"
+
+#include "NES/RomDatabase.h"
+
+namespace ninmuse
+{
+	namespace nes
+	{
+		namespace
+		{
+			// Keep sorted by CRC-32
+			constexpr const RomDatabaseEntry ROM_DATABASE_ENTRIES[] =
+			{
+				// Driar's Golf (homebrew): UxROM, CHR-RAM
+				{ 0x1629E5E2, 2, 0, eMirroringType::VERTICAL, eConsoleType::NES_FAMICOM, eCpuPpuTimingMode::MULTIPLE_REGION, false, 32 * KILO_BYTE, 0, 0, 0, 8 * KILO_BYTE, 0 },
+				// The Legend of Zelda: SxROM, battery-backed PRG-RAM, CHR-RAM
+				{ 0xEAF7ED72, 1, 0, eMirroringType::HORIZONTAL, eConsoleType::NES_FAMICOM, eCpuPpuTimingMode::RP2C02, true, 128 * KILO_BYTE, 0, 0, 8 * KILO_BYTE, 8 * KILO_BYTE, 0 },
+			};
+			constexpr const size_t NUM_ROM_DATABASE_ENTRIES = sizeof( ROM_DATABASE_ENTRIES ) / sizeof( ROM_DATABASE_ENTRIES[0] );
+			static_assert( NUM_ROM_DATABASE_ENTRIES < UINT16_MAX );
+
+			constexpr bool HasUniqueKeys() noexcept
+			{
+				for ( size_t index = 1; index < NUM_ROM_DATABASE_ENTRIES; ++index )
+				{
+					if ( ROM_DATABASE_ENTRIES[index - 1].Crc32 >= ROM_DATABASE_ENTRIES[index].Crc32 )
+					{
+						return false;
+					}
+				}
+
+				return true;
+			}
+			static_assert( HasUniqueKeys(), "ROM database must be sorted by CRC-32 without duplicates!!" );
+
+			constexpr uint32_t GetNumSlotBits() noexcept
+			{
+				// At most half full, which keeps the multiplier search short
+				uint32_t numSlotBits = 1;
+				while ( ( static_cast< size_t >( 1 ) << numSlotBits ) < NUM_ROM_DATABASE_ENTRIES * 2 )
+				{
+					++numSlotBits;
+				}
+
+				return numSlotBits;
+			}
+
+			// Multiplicative hashing into a power-of-two table. The multiplier is searched for at compile time
+			// until every key lands in its own slot, so a lookup is one multiply, one shift and one compare.
+			struct PerfectHashTable final
+			{
+				static constexpr const uint32_t NUM_SLOT_BITS = GetNumSlotBits();
+				static constexpr const size_t NUM_SLOTS = static_cast< size_t >( 1 ) << NUM_SLOT_BITS;
+				static constexpr const uint16_t EMPTY_SLOT = UINT16_MAX;
+				static constexpr const uint32_t INITIAL_MULTIPLIER = 0x9E3779B1;	// 2^32 / golden ratio, rounded to odd
+				static constexpr const uint32_t MAX_NUM_ATTEMPTS = 1 << 16;
+
+				uint32_t	Multiplier = 0;		// 0 if no perfect multiplier was found
+				uint16_t	Slots[NUM_SLOTS] = {};
+
+				inline constexpr size_t GetSlotIndex( const uint32_t crc32 ) const noexcept
+				{
+					return static_cast< uint32_t >( crc32 * Multiplier ) >> ( 32 - NUM_SLOT_BITS );
+				}
+			};
+
+			constexpr PerfectHashTable BuildPerfectHashTable() noexcept
+			{
+				PerfectHashTable table;
+				for ( uint32_t attempt = 0; attempt < PerfectHashTable::MAX_NUM_ATTEMPTS; ++attempt )
+				{
+					table.Multiplier = PerfectHashTable::INITIAL_MULTIPLIER + attempt * 2;
+					for ( uint16_t& slot : table.Slots )
+					{
+						slot = PerfectHashTable::EMPTY_SLOT;
+					}
+
+					bool isPerfect = true;
+					for ( size_t index = 0; index < NUM_ROM_DATABASE_ENTRIES && isPerfect; ++index )
+					{
+						uint16_t& slot = table.Slots[table.GetSlotIndex( ROM_DATABASE_ENTRIES[index].Crc32 )];
+						isPerfect = slot == PerfectHashTable::EMPTY_SLOT;
+						slot = static_cast< uint16_t >( index );
+					}
+
+					if ( isPerfect )
+					{
+						return table;
+					}
+				}
+
+				table.Multiplier = 0;
+				return table;
+			}
+
+			constexpr const PerfectHashTable ROM_DATABASE_TABLE = BuildPerfectHashTable();
+			static_assert( ROM_DATABASE_TABLE.Multiplier != 0, "No perfect hash multiplier for the ROM database!!" );
+
+			constexpr const RomDatabaseEntry* FindEntry( const uint32_t crc32 ) noexcept
+			{
+				const uint16_t slot = ROM_DATABASE_TABLE.Slots[ROM_DATABASE_TABLE.GetSlotIndex( crc32 )];
+				if ( slot == PerfectHashTable::EMPTY_SLOT || ROM_DATABASE_ENTRIES[slot].Crc32 != crc32 )
+				{
+					return nullptr;
+				}
+
+				return &ROM_DATABASE_ENTRIES[slot];
+			}
+
+			constexpr bool CanFindEveryEntry() noexcept
+			{
+				for ( const RomDatabaseEntry& entry : ROM_DATABASE_ENTRIES )
+				{
+					if ( FindEntry( entry.Crc32 ) != &entry )
+					{
+						return false;
+					}
+				}
+
+				return true;
+			}
+			static_assert( CanFindEveryEntry() );
+			static_assert( FindEntry( 0 ) == nullptr && FindEntry( 0xFFFFFFFF ) == nullptr );
+
+			// A Zelda dump with a NES 2.0 header that leaves out every RAM size and mirrors the wrong way
+			constexpr const data_t BROKEN_ZELDA_HEADER[CartridgeInfo::HEADER_SIZE] = { 0x4E, 0x45, 0x53, 0x1A, 0x08, 0x00, 0x13, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+			constexpr CartridgeInfo CorrectWithDatabase( const data_t* header, const uint32_t crc32 ) noexcept
+			{
+				CartridgeInfo info = ParseCartridgeInfo( header );
+				if ( const RomDatabaseEntry* entry = FindEntry( crc32 ); entry != nullptr )
+				{
+					ApplyRomDatabaseEntry( *entry, info );
+				}
+
+				return info;
+			}
+			constexpr const CartridgeInfo BROKEN_ZELDA_INFO = ParseCartridgeInfo( BROKEN_ZELDA_HEADER );
+			static_assert( BROKEN_ZELDA_INFO.IsValid && BROKEN_ZELDA_INFO.IsNes2_0 && BROKEN_ZELDA_INFO.IsCorrected == false );
+			static_assert( BROKEN_ZELDA_INFO.ProgramNvramSize == 0 && BROKEN_ZELDA_INFO.CharacterRamSize == 0 );
+			static_assert( BROKEN_ZELDA_INFO.MirroringType == eMirroringType::VERTICAL );
+
+			constexpr const CartridgeInfo CORRECTED_ZELDA_INFO = CorrectWithDatabase( BROKEN_ZELDA_HEADER, 0xEAF7ED72 );
+			static_assert( CORRECTED_ZELDA_INFO.IsValid && CORRECTED_ZELDA_INFO.IsNes2_0 && CORRECTED_ZELDA_INFO.IsCorrected );
+			static_assert( CORRECTED_ZELDA_INFO.MapperNumber == 1 && CORRECTED_ZELDA_INFO.HasBattery );
+			static_assert( CORRECTED_ZELDA_INFO.ProgramNvramSize == 8 * KILO_BYTE && CORRECTED_ZELDA_INFO.CharacterRamSize == 8 * KILO_BYTE );
+			static_assert( CORRECTED_ZELDA_INFO.MirroringType == eMirroringType::HORIZONTAL );
+
+			// Unknown dumps keep what their header says
+			static_assert( CorrectWithDatabase( BROKEN_ZELDA_HEADER, 0 ).IsCorrected == false );
+		}
+
+		const RomDatabaseEntry* FindRomDatabaseEntry( const uint32_t crc32 ) noexcept
+		{
+			return FindEntry( crc32 );
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "NES/Cartridge.h"
+
+namespace ninmuse
+{
+	namespace nes
+	{
+		// Known-good header of one dump, keyed by the CRC-32 of everything after the 16-byte header.
+		// Overrides what the file claims, so dumps with wrong or pre-NES 2.0 headers still get the right board.
+		struct RomDatabaseEntry final
+		{
+			uint32_t			Crc32;
+			uint16_t			MapperNumber;
+			uint8_t				SubmapperNumber;
+			eMirroringType		MirroringType;
+			eConsoleType		ConsoleType;
+			eCpuPpuTimingMode	CpuPpuTimingMode;
+			bool				HasBattery;
+			uint32_t			ProgramRomSize;
+			uint32_t			CharacterRomSize;
+			uint32_t			ProgramRamSize;
+			uint32_t			ProgramNvramSize;
+			uint32_t			CharacterRamSize;
+			uint32_t			CharacterNvramSize;
+		};
+
+		// O(1) lookup into the built-in database. Returns nullptr for unknown dumps.
+		const RomDatabaseEntry*	FindRomDatabaseEntry( const uint32_t crc32 ) noexcept;
+
+		// Layout flags read from the file itself (trainer, format) are kept; everything describing the board is replaced.
+		inline constexpr void ApplyRomDatabaseEntry( const RomDatabaseEntry& entry, CartridgeInfo& info ) noexcept
+		{
+			info.IsCorrected = true;
+			info.HasBattery = entry.HasBattery;
+			info.MirroringType = entry.MirroringType;
+			info.ConsoleType = entry.ConsoleType;
+			info.CpuPpuTimingMode = entry.CpuPpuTimingMode;
+			info.SubmapperNumber = entry.SubmapperNumber;
+			info.MapperNumber = entry.MapperNumber;
+			info.ProgramRomSize = entry.ProgramRomSize;
+			info.CharacterRomSize = entry.CharacterRomSize;
+			info.ProgramRamSize = entry.ProgramRamSize;
+			info.ProgramNvramSize = entry.ProgramNvramSize;
+			info.CharacterRamSize = entry.CharacterRamSize;
+			info.CharacterNvramSize = entry.CharacterNvramSize;
+		}
+	}
+}
\ No newline at end of file
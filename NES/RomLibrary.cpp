@@ -0,0 +1,336 @@
+#include "stdafx.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <map>
+#include <thread>
+
+#include "NES/DynamicArray.hpp"
+#include "NES/RomLibrary.h"
+
+namespace ninmuse
+{
+	namespace nes
+	{
+		// On-disk layout: IndexFileHeader, NumEntries fixed-size IndexFileEntry records, then one blob of UTF-8 paths.
+		// Written in host byte order; a header mismatch simply means a full rescan.
+		struct IndexFileHeader final
+		{
+			static constexpr const char		MAGIC[4] = { 'N', 'M', 'R', 'L' };
+			static constexpr const uint32_t	VERSION = 1;
+
+			char		Magic[4];
+			uint32_t	Version;
+			uint32_t	NumEntries;
+			uint32_t	PathBlobSize;
+		};
+		static_assert( sizeof( IndexFileHeader ) == 16 );
+
+		struct IndexFileEntry final
+		{
+			uint64_t	FileSize;
+			int64_t		ModifiedTime;
+			uint32_t	Crc32;
+			uint32_t	PathOffset;
+			uint32_t	PathSize;
+			uint32_t	ProgramRomSize;
+			uint32_t	CharacterRomSize;
+			uint16_t	MapperNumber;
+			uint8_t		TvSystem;
+			uint8_t		Reserved;
+			uint8_t		Sha1[Sha1Digest::SIZE];
+			uint8_t		Padding[4];
+		};
+		static_assert( sizeof( IndexFileEntry ) == CACHE_LINE_SIZE );
+		static_assert( std::is_trivially_copyable_v<IndexFileEntry> );
+
+		static bool IsRomFile( const std::filesystem::path& filePath ) noexcept
+		{
+			const std::filesystem::path extension = filePath.extension();
+			return extension == ".nes" || extension == ".NES";
+		}
+
+		static bool IsInDirectory( const std::filesystem::path& filePath, const std::filesystem::path& directory ) noexcept
+		{
+			const std::filesystem::path relativePath = filePath.lexically_relative( directory );
+			return relativePath.empty() == false && *relativePath.begin() != "..";
+		}
+
+		RomLibrary::RomLibrary( const std::filesystem::path& indexFilePath ) noexcept
+			: mIndexFilePath( indexFilePath )
+			, mEntries()
+		{
+			load();
+		}
+
+		size_t RomLibrary::Scan( const std::filesystem::path& directory ) noexcept
+		{
+			std::error_code errorCode;
+			const std::filesystem::path scanDirectory = std::filesystem::weakly_canonical( directory, errorCode );
+			std::filesystem::recursive_directory_iterator iterator( scanDirectory, std::filesystem::directory_options::skip_permission_denied, errorCode );
+			if ( errorCode )
+			{
+				return 0;
+			}
+
+			// Entries outside of the directory are kept as they are; entries inside are matched against what is on disk now
+			DynamicArray<Entry> entries;
+			std::map<std::filesystem::path, const Entry*> previousEntries;
+			for ( const Entry& entry : mEntries )
+			{
+				if ( IsInDirectory( entry.Path, scanDirectory ) )
+				{
+					previousEntries.emplace( entry.Path, &entry );
+				}
+				else
+				{
+					entries.PushBack( entry );
+				}
+			}
+
+			DynamicArray<size_t> staleEntryIndices;
+			for ( ; iterator != std::filesystem::recursive_directory_iterator(); iterator.increment( errorCode ) )
+			{
+				if ( errorCode )
+				{
+					break;
+				}
+
+				if ( iterator->is_regular_file( errorCode ) == false || IsRomFile( iterator->path() ) == false )
+				{
+					continue;
+				}
+
+				Entry& entry = entries.EmplaceBack();
+				entry.Path = iterator->path();
+				entry.FileSize = iterator->file_size( errorCode );
+				entry.ModifiedTime = static_cast< int64_t >( iterator->last_write_time( errorCode ).time_since_epoch().count() );
+
+				const auto previousEntry = previousEntries.find( entry.Path );
+				if ( previousEntry != previousEntries.end()
+					&& previousEntry->second->FileSize == entry.FileSize
+					&& previousEntry->second->ModifiedTime == entry.ModifiedTime )
+				{
+					entry = *previousEntry->second;
+				}
+				else
+				{
+					staleEntryIndices.PushBack( entries.GetSize() - 1 );
+				}
+			}
+
+			// Parse and hash what changed on every hardware thread. Each worker claims the next stale entry until none are left.
+			const size_t numStaleEntries = staleEntryIndices.GetSize();
+			DynamicArray<uint8_t> isValid;
+			isValid.SetSize( numStaleEntries );
+			{
+				std::atomic<size_t> nextStaleEntry = 0;
+				const size_t numWorkers = std::min<size_t>( std::max( std::thread::hardware_concurrency(), 1u ), numStaleEntries );
+
+				DynamicArray<std::jthread> workers;
+				workers.SetCapacity( numWorkers );
+				for ( size_t worker = 0; worker < numWorkers; ++worker )
+				{
+					workers.EmplaceBack( [&]() noexcept
+						{
+							for ( size_t index = nextStaleEntry.fetch_add( 1 ); index < numStaleEntries; index = nextStaleEntry.fetch_add( 1 ) )
+							{
+								Entry& entry = entries[staleEntryIndices[index]];
+								isValid[index] = readEntry( entry.Path, entry );
+							}
+						} );
+				}
+			}
+
+			// Files that failed to parse are dropped rather than indexed
+			mEntries.Clear();
+			mEntries.SetCapacity( entries.GetSize() );
+			for ( size_t index = 0, staleIndex = 0; index < entries.GetSize(); ++index )
+			{
+				const bool isStale = staleIndex < numStaleEntries && staleEntryIndices[staleIndex] == index;
+				if ( isStale == false || isValid[staleIndex++] )
+				{
+					mEntries.PushBack( std::move( entries[index] ) );
+				}
+			}
+			sortByCrc32();
+
+			return numStaleEntries;
+		}
+
+		bool RomLibrary::Save() const noexcept
+		{
+			DynamicArray<IndexFileEntry> fileEntries;
+			fileEntries.SetSize( mEntries.GetSize() );
+
+			std::string pathBlob;
+			for ( size_t index = 0; index < mEntries.GetSize(); ++index )
+			{
+				const Entry& entry = mEntries[index];
+				const std::u8string path = entry.Path.u8string();
+
+				IndexFileEntry& fileEntry = fileEntries[index];
+				fileEntry.FileSize = entry.FileSize;
+				fileEntry.ModifiedTime = entry.ModifiedTime;
+				fileEntry.Crc32 = entry.Crc32;
+				fileEntry.PathOffset = static_cast< uint32_t >( pathBlob.size() );
+				fileEntry.PathSize = static_cast< uint32_t >( path.size() );
+				fileEntry.ProgramRomSize = entry.ProgramRomSize;
+				fileEntry.CharacterRomSize = entry.CharacterRomSize;
+				fileEntry.MapperNumber = entry.MapperNumber;
+				fileEntry.TvSystem = static_cast< uint8_t >( entry.TvSystem );
+				memcpy( fileEntry.Sha1, entry.Sha1.Bytes, Sha1Digest::SIZE );
+
+				pathBlob.append( reinterpret_cast<const char*>( path.data() ), path.size() );
+			}
+
+			IndexFileHeader header = {};
+			memcpy( header.Magic, IndexFileHeader::MAGIC, sizeof( header.Magic ) );
+			header.Version = IndexFileHeader::VERSION;
+			header.NumEntries = static_cast< uint32_t >( fileEntries.GetSize() );
+			header.PathBlobSize = static_cast< uint32_t >( pathBlob.size() );
+
+			// Written next to the index and renamed over it, so an interrupted save never leaves a torn index behind
+			std::filesystem::path temporaryFilePath = mIndexFilePath;
+			temporaryFilePath += ".tmp";
+			{
+				std::ofstream indexFile( temporaryFilePath, std::ios_base::binary | std::ios_base::out | std::ios_base::trunc );
+				indexFile.write( reinterpret_cast<const char*>( &header ), sizeof( header ) );
+				indexFile.write( reinterpret_cast<const char*>( fileEntries.GetData() ), static_cast< std::streamsize >( sizeof( IndexFileEntry ) * fileEntries.GetSize() ) );
+				indexFile.write( pathBlob.data(), static_cast< std::streamsize >( pathBlob.size() ) );
+				if ( indexFile.good() == false )
+				{
+					return false;
+				}
+			}
+
+			std::error_code errorCode;
+			std::filesystem::rename( temporaryFilePath, mIndexFilePath, errorCode );
+			return !errorCode;
+		}
+
+		const RomLibrary::Entry* RomLibrary::FindByCrc32( const uint32_t crc32 ) const noexcept
+		{
+			const Entry* entry = std::lower_bound( mEntries.begin(), mEntries.end(), crc32,
+				[]( const Entry& lhs, const uint32_t rhs ) noexcept { return lhs.Crc32 < rhs; } );
+			return entry != mEntries.end() && entry->Crc32 == crc32 ? entry : nullptr;
+		}
+
+		const RomLibrary::Entry* RomLibrary::FindBySha1( const Sha1Digest& sha1 ) const noexcept
+		{
+			// Entries are ordered by CRC-32 only; a library of a few thousand ROMs is a short linear scan
+			for ( const Entry& entry : mEntries )
+			{
+				if ( entry.Sha1 == sha1 )
+				{
+					return &entry;
+				}
+			}
+
+			return nullptr;
+		}
+
+		bool RomLibrary::load() noexcept
+		{
+			std::error_code errorCode;
+			const uint64_t indexFileSize = std::filesystem::file_size( mIndexFilePath, errorCode );
+			if ( errorCode )
+			{
+				return false;
+			}
+
+			std::ifstream indexFile( mIndexFilePath, std::ios_base::binary | std::ios_base::in );
+			if ( indexFile.is_open() == false )
+			{
+				return false;
+			}
+
+			IndexFileHeader header = {};
+			indexFile.read( reinterpret_cast<char*>( &header ), sizeof( header ) );
+			if ( indexFile.good() == false
+				|| memcmp( header.Magic, IndexFileHeader::MAGIC, sizeof( header.Magic ) ) != 0
+				|| header.Version != IndexFileHeader::VERSION )
+			{
+				return false;
+			}
+
+			// The header of a corrupt index can ask for anything; it must describe exactly the bytes on disk before anything is allocated for it
+			const uint64_t expectedFileSize = sizeof( IndexFileHeader ) + static_cast< uint64_t >( sizeof( IndexFileEntry ) ) * header.NumEntries + header.PathBlobSize;
+			if ( expectedFileSize != indexFileSize )
+			{
+				return false;
+			}
+
+			DynamicArray<IndexFileEntry> fileEntries;
+			fileEntries.SetSize( header.NumEntries );
+			DynamicArray<char> pathBlob;
+			pathBlob.SetSize( header.PathBlobSize );
+			if ( fileEntries.GetSize() != header.NumEntries || pathBlob.GetSize() != header.PathBlobSize )
+			{
+				return false;
+			}
+
+			indexFile.read( reinterpret_cast<char*>( fileEntries.GetData() ), static_cast< std::streamsize >( sizeof( IndexFileEntry ) * header.NumEntries ) );
+			indexFile.read( pathBlob.GetData(), static_cast< std::streamsize >( header.PathBlobSize ) );
+			if ( indexFile.good() == false )
+			{
+				return false;
+			}
+
+			mEntries.Clear();
+			mEntries.SetCapacity( header.NumEntries );
+			for ( const IndexFileEntry& fileEntry : fileEntries )
+			{
+				if ( static_cast< size_t >( fileEntry.PathOffset ) + fileEntry.PathSize > pathBlob.GetSize() )
+				{
+					mEntries.Clear();
+					return false;
+				}
+
+				Entry& entry = mEntries.EmplaceBack();
+				entry.Path = std::filesystem::path( std::u8string( reinterpret_cast<const char8_t*>( pathBlob.GetData() + fileEntry.PathOffset ), fileEntry.PathSize ) );
+				entry.FileSize = fileEntry.FileSize;
+				entry.ModifiedTime = fileEntry.ModifiedTime;
+				entry.Crc32 = fileEntry.Crc32;
+				memcpy( entry.Sha1.Bytes, fileEntry.Sha1, Sha1Digest::SIZE );
+				entry.MapperNumber = fileEntry.MapperNumber;
+				entry.ProgramRomSize = fileEntry.ProgramRomSize;
+				entry.CharacterRomSize = fileEntry.CharacterRomSize;
+				entry.TvSystem = static_cast< eTvSystemType >( fileEntry.TvSystem );
+			}
+			sortByCrc32();
+
+			return true;
+		}
+
+		void RomLibrary::sortByCrc32() noexcept
+		{
+			std::sort( mEntries.begin(), mEntries.end(), []( const Entry& lhs, const Entry& rhs ) noexcept { return lhs.Crc32 < rhs.Crc32; } );
+		}
+
+		bool RomLibrary::readEntry( const std::filesystem::path& romFilePath, Entry& outEntry ) noexcept
+		{
+			// Same parser as a cartridge, without going through the shared image cache
+			const RomImage romImage( romFilePath );
+			if ( romImage.IsValid() == false )
+			{
+				return false;
+			}
+
+			const MappedFile& romFile = romImage.GetFile();
+			const std::byte* contents = romFile.GetData() + CartridgeInfo::HEADER_SIZE;
+			const size_t contentsSize = romFile.GetSize() - CartridgeInfo::HEADER_SIZE;
+
+			outEntry.FileSize = romFile.GetSize();
+			outEntry.Crc32 = romImage.GetCrc32();
+			outEntry.Sha1 = ComputeSha1( contents, contentsSize );
+			outEntry.MapperNumber = romImage.GetInfo().MapperNumber;
+			outEntry.ProgramRomSize = static_cast< uint32_t >( romImage.GetProgramRom().Data.GetSize() );
+			outEntry.CharacterRomSize = static_cast< uint32_t >( romImage.GetCharacterRom().Data.GetSize() );
+			outEntry.TvSystem = romImage.GetTvSystem();
+
+			return true;
+		}
+	}
+}
\ No newline at end of file
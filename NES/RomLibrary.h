@@ -0,0 +1,61 @@
+#pragma once
+
+#include "NES/Cartridge.h"
+#include "NES/DynamicArray.h"
+#include "NES/Hash.h"
+
+namespace ninmuse
+{
+	namespace nes
+	{
+		// Index of every .nes file under the scanned directories. It is persisted to a compact binary file, so
+		// later launches can find a ROM by hash without opening it, and rescans only re-read files whose size or mtime changed.
+		class RomLibrary final
+		{
+		public:
+			struct Entry final
+			{
+				std::filesystem::path	Path;
+				uint64_t				FileSize = 0;
+				int64_t					ModifiedTime = 0;
+				uint32_t				Crc32 = 0;			// Hashes cover everything after the 16-byte header
+				Sha1Digest				Sha1;
+				uint16_t				MapperNumber = 0;
+				uint32_t				ProgramRomSize = 0;
+				uint32_t				CharacterRomSize = 0;
+				eTvSystemType			TvSystem = eTvSystemType::NTSC;
+			};
+
+		public:
+			RomLibrary() = delete;
+			explicit RomLibrary( const std::filesystem::path& indexFilePath ) noexcept;
+			RomLibrary( const RomLibrary& ) = delete;
+			RomLibrary( RomLibrary&& ) = delete;
+			~RomLibrary() = default;
+
+			RomLibrary& operator=( const RomLibrary& ) = delete;
+			RomLibrary& operator=( RomLibrary&& ) = delete;
+
+		public:
+			// Walks directory recursively and parses and hashes new or modified ROMs on every hardware thread.
+			// Returns the number of files that had to be opened.
+			size_t			Scan( const std::filesystem::path& directory ) noexcept;
+			bool			Save() const noexcept;
+
+			const Entry*	FindByCrc32( const uint32_t crc32 ) const noexcept;
+			const Entry*	FindBySha1( const Sha1Digest& sha1 ) const noexcept;
+
+			inline constexpr const DynamicArray<Entry>&
+							GetEntries() const noexcept { return mEntries; }
+
+		private:
+			bool			load() noexcept;
+			void			sortByCrc32() noexcept;
+			static bool		readEntry( const std::filesystem::path& romFilePath, Entry& outEntry ) noexcept;
+
+		private:
+			std::filesystem::path	mIndexFilePath;
+			DynamicArray<Entry>		mEntries;		// Sorted by Crc32
+		};
+	}
+}
\ No newline at end of file
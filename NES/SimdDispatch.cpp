@@ -0,0 +1,55 @@
+#include "stdafx.h"
+
+#include "NES/SimdDispatch.h"
+
+#if defined(NM_SIMD_X64) && defined(_MSC_VER)
+#include <intrin.h>
+#endif	// defined(NM_SIMD_X64) && defined(_MSC_VER)
+
+namespace ninmuse
+{
+	namespace nes
+	{
+		namespace
+		{
+#if defined(NM_SIMD_X64)
+			bool IsAvx2Supported() noexcept
+			{
+#if defined(_MSC_VER)
+				int info[4] = {};
+				__cpuid( info, 0 );
+				if ( info[0] < 7 )
+				{
+					return false;
+				}
+
+				// The OS must save the YMM registers too
+				__cpuid( info, 1 );
+				const bool isAvxUsable = ( info[2] & ( 1 << 27 ) ) != 0 && ( info[2] & ( 1 << 28 ) ) != 0 && ( _xgetbv( 0 ) & 0x06 ) == 0x06;
+				__cpuidex( info, 7, 0 );
+				return isAvxUsable && ( info[1] & ( 1 << 5 ) ) != 0;
+#else	// NOT defined(_MSC_VER)
+				return __builtin_cpu_supports( "avx2" );
+#endif	// defined(_MSC_VER)
+			}
+#endif	// defined(NM_SIMD_X64)
+		}
+
+		bool IsSimdLevelSupported( const eSimdLevel simdLevel ) noexcept
+		{
+			switch ( simdLevel )
+			{
+			case eSimdLevel::SCALAR:
+				return true;
+#if defined(NM_SIMD_X64)
+			case eSimdLevel::SSE2:
+				return true;
+			case eSimdLevel::AVX2:
+				return IsAvx2Supported();
+#endif	// defined(NM_SIMD_X64)
+			default:
+				return false;
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <type_traits>
+
+#include "NES/Common.h"
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define NM_SIMD_X64
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#define NM_TARGET_AVX2
+#else	// NOT defined(_MSC_VER)
+#define NM_TARGET_AVX2 __attribute__( ( target( "avx2" ) ) )
+#endif	// defined(_MSC_VER)
+#endif	// defined(_M_X64) || defined(__x86_64__)
+
+namespace ninmuse
+{
+	namespace nes
+	{
+		enum class eSimdLevel : uint8_t
+		{
+			SCALAR,
+			SSE2,
+			AVX2,
+			COUNT,
+		};
+
+		// Whether this CPU, and the OS for AVX2's wider registers, can run kernels of simdLevel
+		bool	IsSimdLevelSupported( const eSimdLevel simdLevel ) noexcept;
+
+		// Kernels is a table of structs with a SimdLevel member, the scalar reference first and the widest last.
+		// Returns the widest kernel this CPU runs, picked on first use. Debug builds also check every supported kernel
+		// with IsMatchingReference( reference, kernel ), which runs both over the same input and compares their outputs.
+		template <const auto& Kernels, auto IsMatchingReference>
+		const auto& SelectWidestKernel() noexcept
+		{
+			using KernelType = std::remove_cvref_t<decltype( Kernels[0] )>;
+			static const KernelType& KERNEL = []() noexcept -> const KernelType&
+				{
+					NM_ASSERT( Kernels[0].SimdLevel == eSimdLevel::SCALAR, "The first kernel must be the scalar reference!!" );
+					const KernelType* selectedKernel = &Kernels[0];
+					for ( const KernelType& kernel : Kernels )
+					{
+						if ( IsSimdLevelSupported( kernel.SimdLevel ) )
+						{
+							NM_ASSERT( IsMatchingReference( Kernels[0], kernel ), "Kernel disagrees with the scalar reference!!" );
+							selectedKernel = &kernel;
+						}
+					}
+
+					return *selectedKernel;
+				}();
+			return KERNEL;
+		}
+	}
+}
\ No newline at end of file
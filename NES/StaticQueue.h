@@ -0,0 +1,42 @@
+#pragma once
+
+#include "NES/Common.h"
+
+namespace ninmuse
+{
+	// Fixed capacity FIFO ring buffer. Holds its elements inline and never allocates, so it stays
+	// trivially copyable whenever ElementType is and can be part of a memcpy-able state block.
+	template <typename ElementType, size_t Capacity>
+	class StaticQueue final
+	{
+	public:
+		constexpr StaticQueue() = default;
+
+	public:
+		// Element Access
+		inline constexpr ElementType&			Front() noexcept { NM_ASSERT( IsEmpty() == false, "Queue is empty!!" ); return mData[mHead]; }
+		inline constexpr const ElementType&		Front() const noexcept { NM_ASSERT( IsEmpty() == false, "Queue is empty!!" ); return mData[mHead]; }
+
+		// Capacities
+		[[nodiscard]] inline constexpr bool		IsEmpty() const noexcept { return mSize == 0; }
+		inline constexpr size_t					GetSize() const noexcept { return mSize; }
+		inline constexpr size_t					GetCapacity() const noexcept { return Capacity; }
+
+		// Modifiers
+		constexpr void							Push( const ElementType& value ) noexcept;
+		constexpr void							Pop() noexcept;
+		constexpr void							Clear() noexcept;
+
+	private:
+		static_assert( Capacity > 0 && ( Capacity & ( Capacity - 1 ) ) == 0, "Capacity must be a power of two!!" );
+		static constexpr const size_t INDEX_MASK = Capacity - 1;
+
+		// Smallest index type that fits, so small queues pack tightly into hot state
+		using index_t = std::conditional_t<Capacity < UINT8_MAX, uint8_t, uint32_t>;
+
+	private:
+		ElementType	mData[Capacity] = {};
+		index_t		mHead = 0;
+		index_t		mSize = 0;
+	};
+}
\ No newline at end of file
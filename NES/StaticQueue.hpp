@@ -0,0 +1,29 @@
+#pragma once
+
+#include "StaticQueue.h"
+
+namespace ninmuse
+{
+	template<typename ElementType, size_t Capacity>
+	inline constexpr void StaticQueue<ElementType, Capacity>::Push( const ElementType& value ) noexcept
+	{
+		NM_ASSERT( mSize < Capacity, "Queue overflow!!" );
+		mData[( mHead + mSize ) & INDEX_MASK] = value;
+		++mSize;
+	}
+
+	template<typename ElementType, size_t Capacity>
+	inline constexpr void StaticQueue<ElementType, Capacity>::Pop() noexcept
+	{
+		NM_ASSERT( mSize > 0, "Queue is empty!!" );
+		mHead = static_cast< index_t >( ( mHead + 1 ) & INDEX_MASK );
+		--mSize;
+	}
+
+	template<typename ElementType, size_t Capacity>
+	inline constexpr void StaticQueue<ElementType, Capacity>::Clear() noexcept
+	{
+		mHead = 0;
+		mSize = 0;
+	}
+}
\ No newline at end of file
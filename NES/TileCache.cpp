@@ -0,0 +1,68 @@
+#include "stdafx.h"
+
+#include "NES/DynamicArray.hpp"
+#include "NES/TileCache.h"
+
+namespace ninmuse
+{
+	namespace nes
+	{
+		namespace
+		{
+			void FlipTilesX( const data_t* pixels, const size_t numTiles, data_t* outPixels ) noexcept
+			{
+				for ( size_t row = 0; row < numTiles * TileDecoder::TILE_SIZE; ++row )
+				{
+					const data_t* source = pixels + row * TileDecoder::TILE_SIZE;
+					data_t* destination = outPixels + row * TileDecoder::TILE_SIZE;
+					for ( size_t pixel = 0; pixel < TileDecoder::TILE_SIZE; ++pixel )
+					{
+						destination[pixel] = source[TileDecoder::TILE_SIZE - 1 - pixel];
+					}
+				}
+			}
+		}
+
+		TileCache::TileCache() noexcept
+			: mCharacterMemory( nullptr )
+			, mNumTiles( 0 )
+			, mPixels()
+			, mIsStale()
+		{
+		}
+
+		void TileCache::Build( const data_t* characterMemory, const size_t size ) noexcept
+		{
+			NM_ASSERT( size % TileDecoder::TILE_BYTES == 0, "CHR memory is not made of whole tiles!!" );
+			mCharacterMemory = characterMemory;
+			mNumTiles = size / TileDecoder::TILE_BYTES;
+
+			const size_t numPixels = mNumTiles * TileDecoder::NUM_TILE_PIXELS;
+			mPixels.SetSize( 2 * numPixels );
+			mIsStale.SetSize( mNumTiles );
+			for ( size_t tileIndex = 0; tileIndex < mNumTiles; ++tileIndex )
+			{
+				mIsStale[tileIndex] = false;
+			}
+
+			DecodeTiles( mCharacterMemory, mNumTiles, mPixels.GetData() );
+			FlipTilesX( mPixels.GetData(), mNumTiles, mPixels.GetData() + numPixels );
+		}
+
+		void TileCache::InvalidateAll() noexcept
+		{
+			for ( size_t tileIndex = 0; tileIndex < mNumTiles; ++tileIndex )
+			{
+				mIsStale[tileIndex] = true;
+			}
+		}
+
+		void TileCache::decodeTile( const size_t tileIndex ) noexcept
+		{
+			data_t* pixels = mPixels.GetData() + tileIndex * TileDecoder::NUM_TILE_PIXELS;
+			DecodeTiles( mCharacterMemory + tileIndex * TileDecoder::TILE_BYTES, 1, pixels );
+			FlipTilesX( pixels, 1, pixels + mNumTiles * TileDecoder::NUM_TILE_PIXELS );
+			mIsStale[tileIndex] = false;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "NES/DynamicArray.h"
+#include "NES/TileDecoder.h"
+
+namespace ninmuse
+{
+	namespace nes
+	{
+		// CHR memory pre-decoded to one color index per byte: every tile as 8x8 bytes, and again mirrored horizontally
+		// for sprites. The renderer copies rows out of it instead of decoding bitplanes on every scanline.
+		// CHR-ROM never changes after the build, so one cache is shared read-only by every console using the ROM image.
+		// A CHR-RAM write marks its tile stale, and Refresh() decodes the tile again before its next read.
+		// About 8 bytes of cache per byte of CHR: 64 KB for an 8 KB board.
+		class TileCache final
+		{
+		public:
+			TileCache() noexcept;
+			TileCache( const TileCache& ) = delete;
+			TileCache( TileCache&& ) = delete;
+			~TileCache() = default;
+
+			TileCache& operator=( const TileCache& ) = delete;
+			TileCache& operator=( TileCache&& ) = delete;
+
+		public:
+			// Decodes all of characterMemory, which must outlive the cache
+			void					Build( const data_t* characterMemory, const size_t size ) noexcept;
+
+			// offset is the CHR memory offset of a low bitplane row, i.e. tile * TILE_BYTES + row
+			inline const data_t*	GetRow( const size_t offset, const bool isFlippedX ) const noexcept;
+			// After a write to the CHR byte at offset
+			inline void				Invalidate( const size_t offset ) noexcept { mIsStale[offset / TileDecoder::TILE_BYTES] = true; }
+			// After all of the CHR memory was replaced
+			void					InvalidateAll() noexcept;
+			// Before reading a row of a cache that can be written to
+			inline void				Refresh( const size_t offset ) noexcept;
+
+			inline size_t			GetNumTiles() const noexcept { return mNumTiles; }
+
+		private:
+			void					decodeTile( const size_t tileIndex ) noexcept;
+
+		private:
+			const data_t*			mCharacterMemory;
+			size_t					mNumTiles;
+			DynamicArray<data_t>	mPixels;		// Every tile as stored, then every tile flipped
+			DynamicArray<bool>		mIsStale;
+		};
+
+		inline const data_t* TileCache::GetRow( const size_t offset, const bool isFlippedX ) const noexcept
+		{
+			NM_ASSERT( offset % TileDecoder::TILE_BYTES < TileDecoder::TILE_SIZE, "Not a low bitplane row!!" );
+			const size_t tileIndex = offset / TileDecoder::TILE_BYTES;
+			NM_ASSERT( mIsStale[tileIndex] == false, "Tile was written but not refreshed!!" );
+
+			const size_t variantOffset = isFlippedX ? mNumTiles * TileDecoder::NUM_TILE_PIXELS : 0;
+			return mPixels.GetData() + variantOffset + tileIndex * TileDecoder::NUM_TILE_PIXELS + ( offset % TileDecoder::TILE_BYTES ) * TileDecoder::TILE_SIZE;
+		}
+
+		inline void TileCache::Refresh( const size_t offset ) noexcept
+		{
+			const size_t tileIndex = offset / TileDecoder::TILE_BYTES;
+			if ( mIsStale[tileIndex] )
+			{
+				decodeTile( tileIndex );
+			}
+		}
+	}
+}
\ No newline at end of file
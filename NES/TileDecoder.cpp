@@ -0,0 +1,154 @@
+#include "stdafx.h"
+
+#include "NES/DynamicArray.hpp"
+#include "NES/TileDecoder.h"
+
+namespace ninmuse
+{
+	namespace nes
+	{
+		namespace
+		{
+			// Every kernel decodes groups of eight rows. Group g reads its bitplanes at lows/highs + g * groupStride,
+			// so the same kernel takes gathered rows (stride 8) and whole tiles (stride 16, highs = lows + 8).
+			using DecodeRowGroupsFunction = void ( * )( const data_t* lows, const data_t* highs, const size_t groupStride, const size_t numGroups, data_t* outPixels ) noexcept;
+
+			struct TileDecoderKernel final
+			{
+				eSimdLevel				SimdLevel;
+				DecodeRowGroupsFunction	DecodeRowGroups;
+			};
+
+			void DecodeRowGroupsScalar( const data_t* lows, const data_t* highs, const size_t groupStride, const size_t numGroups, data_t* outPixels ) noexcept
+			{
+				for ( size_t group = 0; group < numGroups; ++group )
+				{
+					for ( size_t row = 0; row < TileDecoder::TILE_SIZE; ++row )
+					{
+						const uint64_t pixels = DecodeTileRow( lows[group * groupStride + row], highs[group * groupStride + row] );
+						memcpy( outPixels + ( group * TileDecoder::TILE_SIZE + row ) * TileDecoder::TILE_SIZE, &pixels, sizeof( pixels ) );
+					}
+				}
+			}
+
+#if defined(NM_SIMD_X64)
+			// Each row byte is repeated over the eight bytes of its pixels, then every byte keeps only its own bit
+			inline __m128i SelectPixelBits( const __m128i repeatedRows, const __m128i bitMask, const __m128i value ) noexcept
+			{
+				return _mm_and_si128( _mm_cmpeq_epi8( _mm_and_si128( repeatedRows, bitMask ), bitMask ), value );
+			}
+
+			void DecodeRowGroupsSse2( const data_t* lows, const data_t* highs, const size_t groupStride, const size_t numGroups, data_t* outPixels ) noexcept
+			{
+				const __m128i bitMask = _mm_set_epi8( 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, static_cast<char>( 0x80 ), 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, static_cast<char>( 0x80 ) );
+				const __m128i one = _mm_set1_epi8( 1 );
+				const __m128i two = _mm_set1_epi8( 2 );
+				for ( size_t group = 0; group < numGroups; ++group )
+				{
+					// 8 rows -> each repeated 2, 4, then 8 times: two rows per register
+					__m128i planes[2] = { _mm_loadl_epi64( reinterpret_cast<const __m128i*>( lows + group * groupStride ) ),
+										  _mm_loadl_epi64( reinterpret_cast<const __m128i*>( highs + group * groupStride ) ) };
+					__m128i rowPairs[2][4];
+					for ( size_t plane = 0; plane < 2; ++plane )
+					{
+						const __m128i repeated2 = _mm_unpacklo_epi8( planes[plane], planes[plane] );
+						const __m128i repeated4Low = _mm_unpacklo_epi16( repeated2, repeated2 );
+						const __m128i repeated4High = _mm_unpackhi_epi16( repeated2, repeated2 );
+						rowPairs[plane][0] = _mm_unpacklo_epi32( repeated4Low, repeated4Low );
+						rowPairs[plane][1] = _mm_unpackhi_epi32( repeated4Low, repeated4Low );
+						rowPairs[plane][2] = _mm_unpacklo_epi32( repeated4High, repeated4High );
+						rowPairs[plane][3] = _mm_unpackhi_epi32( repeated4High, repeated4High );
+					}
+
+					__m128i* out = reinterpret_cast<__m128i*>( outPixels + group * TileDecoder::NUM_TILE_PIXELS );
+					for ( size_t pair = 0; pair < 4; ++pair )
+					{
+						_mm_storeu_si128( out + pair, _mm_or_si128( SelectPixelBits( rowPairs[0][pair], bitMask, one ), SelectPixelBits( rowPairs[1][pair], bitMask, two ) ) );
+					}
+				}
+			}
+
+			NM_TARGET_AVX2 inline __m256i SelectPixelBitsAvx2( const __m256i repeatedRows, const __m256i bitMask, const __m256i value ) noexcept
+			{
+				return _mm256_and_si256( _mm256_cmpeq_epi8( _mm256_and_si256( repeatedRows, bitMask ), bitMask ), value );
+			}
+
+			NM_TARGET_AVX2 void DecodeRowGroupsAvx2( const data_t* lows, const data_t* highs, const size_t groupStride, const size_t numGroups, data_t* outPixels ) noexcept
+			{
+				// Both bitplanes of a group fit in one register; byte shuffles repeat four rows at a time across 32 bytes
+				const __m256i bitMask = _mm256_set1_epi64x( static_cast<long long>( 0x0102'0408'1020'4080ull ) );
+				const __m256i one = _mm256_set1_epi8( 1 );
+				const __m256i two = _mm256_set1_epi8( 2 );
+				const __m256i lowRows0123 = _mm256_setr_epi8( 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3 );
+				const __m256i lowRows4567 = _mm256_add_epi8( lowRows0123, _mm256_set1_epi8( 4 ) );
+				const __m256i highRows0123 = _mm256_add_epi8( lowRows0123, _mm256_set1_epi8( 8 ) );
+				const __m256i highRows4567 = _mm256_add_epi8( lowRows0123, _mm256_set1_epi8( 12 ) );
+				for ( size_t group = 0; group < numGroups; ++group )
+				{
+					const __m128i planes = _mm_unpacklo_epi64( _mm_loadl_epi64( reinterpret_cast<const __m128i*>( lows + group * groupStride ) ),
+															   _mm_loadl_epi64( reinterpret_cast<const __m128i*>( highs + group * groupStride ) ) );
+					const __m256i bothLanes = _mm256_broadcastsi128_si256( planes );
+
+					const __m256i rows0123 = _mm256_or_si256( SelectPixelBitsAvx2( _mm256_shuffle_epi8( bothLanes, lowRows0123 ), bitMask, one ),
+															  SelectPixelBitsAvx2( _mm256_shuffle_epi8( bothLanes, highRows0123 ), bitMask, two ) );
+					const __m256i rows4567 = _mm256_or_si256( SelectPixelBitsAvx2( _mm256_shuffle_epi8( bothLanes, lowRows4567 ), bitMask, one ),
+															  SelectPixelBitsAvx2( _mm256_shuffle_epi8( bothLanes, highRows4567 ), bitMask, two ) );
+
+					__m256i* out = reinterpret_cast<__m256i*>( outPixels + group * TileDecoder::NUM_TILE_PIXELS );
+					_mm256_storeu_si256( out, rows0123 );
+					_mm256_storeu_si256( out + 1, rows4567 );
+				}
+			}
+#endif	// defined(NM_SIMD_X64)
+
+			// Widest last
+			constexpr const TileDecoderKernel TILE_DECODER_KERNELS[] =
+			{
+				{ eSimdLevel::SCALAR,	DecodeRowGroupsScalar },
+#if defined(NM_SIMD_X64)
+				{ eSimdLevel::SSE2,		DecodeRowGroupsSse2 },	// Baseline on x64
+				{ eSimdLevel::AVX2,		DecodeRowGroupsAvx2 },
+#endif	// defined(NM_SIMD_X64)
+			};
+
+			// On every pair of bitplane bytes
+			bool IsDecodingLikeReference( const TileDecoderKernel& reference, const TileDecoderKernel& kernel ) noexcept
+			{
+				static constexpr const size_t NUM_ROWS = 256 * 256;
+				static constexpr const size_t NUM_GROUPS = NUM_ROWS / TileDecoder::TILE_SIZE;
+				DynamicArray<data_t> lows( NUM_ROWS );
+				DynamicArray<data_t> highs( NUM_ROWS );
+				DynamicArray<data_t> expectedPixels( NUM_ROWS * TileDecoder::TILE_SIZE );
+				DynamicArray<data_t> pixels( NUM_ROWS * TileDecoder::TILE_SIZE );
+				lows.SetSize( NUM_ROWS );
+				highs.SetSize( NUM_ROWS );
+				expectedPixels.SetSize( NUM_ROWS * TileDecoder::TILE_SIZE );
+				pixels.SetSize( NUM_ROWS * TileDecoder::TILE_SIZE );
+				for ( size_t row = 0; row < NUM_ROWS; ++row )
+				{
+					lows[row] = static_cast<data_t>( row );
+					highs[row] = static_cast<data_t>( row >> NUM_BITS_IN_BYTE );
+				}
+
+				reference.DecodeRowGroups( lows.GetData(), highs.GetData(), TileDecoder::TILE_SIZE, NUM_GROUPS, expectedPixels.GetData() );
+				kernel.DecodeRowGroups( lows.GetData(), highs.GetData(), TileDecoder::TILE_SIZE, NUM_GROUPS, pixels.GetData() );
+				return memcmp( pixels.GetData(), expectedPixels.GetData(), pixels.GetSize() ) == 0;
+			}
+
+			const TileDecoderKernel& GetTileDecoderKernel() noexcept
+			{
+				return SelectWidestKernel<TILE_DECODER_KERNELS, IsDecodingLikeReference>();
+			}
+		}
+
+		void DecodeTiles( const data_t* tiles, const size_t numTiles, data_t* outPixels ) noexcept
+		{
+			GetTileDecoderKernel().DecodeRowGroups( tiles, tiles + TileDecoder::TILE_SIZE, TileDecoder::TILE_BYTES, numTiles, outPixels );
+		}
+
+		eSimdLevel GetTileDecoderSimdLevel() noexcept
+		{
+			return GetTileDecoderKernel().SimdLevel;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "NES/Common.h"
+#include "NES/SimdDispatch.h"
+
+namespace ninmuse
+{
+	namespace nes
+	{
+		// CHR tiles are 16 bytes: eight rows of the low bitplane, then eight rows of the high one, with bit 7 of a row
+		// as its leftmost pixel. Decoding turns them into one 2-bit color index per byte, eight bytes per row.
+		// The same kernels read CHR-ROM straight out of the mapped image and CHR-RAM out of the cartridge.
+		struct TileDecoder final
+		{
+			static constexpr const size_t	TILE_SIZE			= 8;
+			static constexpr const size_t	TILE_BYTES			= 2 * TILE_SIZE;
+			static constexpr const size_t	NUM_TILE_PIXELS		= TILE_SIZE * TILE_SIZE;
+
+			// Every byte value with each bit moved to the bottom of its own byte, leftmost pixel in the lowest byte
+			uint64_t	BitSpread[256] = {};
+		};
+
+		inline constexpr TileDecoder CreateTileDecoder() noexcept
+		{
+			TileDecoder decoder;
+			for ( uint32_t value = 0; value < 256; ++value )
+			{
+				for ( uint32_t pixel = 0; pixel < TileDecoder::TILE_SIZE; ++pixel )
+				{
+					const uint64_t bit = ( value >> ( TileDecoder::TILE_SIZE - 1 - pixel ) ) & 1;
+					decoder.BitSpread[value] |= bit << ( pixel * NUM_BITS_IN_BYTE );
+				}
+			}
+
+			return decoder;
+		}
+
+		inline constexpr const TileDecoder TILE_DECODER = CreateTileDecoder();
+		static_assert( TILE_DECODER.BitSpread[0x80] == 0x01 && TILE_DECODER.BitSpread[0x01] == 0x01'00'00'00'00'00'00'00 );
+
+		// One row as eight bytes, to be stored little-endian. Two lookups, no per-pixel work.
+		inline constexpr uint64_t DecodeTileRow( const data_t low, const data_t high ) noexcept
+		{
+			return TILE_DECODER.BitSpread[low] | ( TILE_DECODER.BitSpread[high] << 1 );
+		}
+
+		// numTiles consecutive tiles, NUM_TILE_PIXELS each
+		void		DecodeTiles( const data_t* tiles, const size_t numTiles, data_t* outPixels ) noexcept;
+		// The widest kernel this CPU runs, picked on first use
+		eSimdLevel	GetTileDecoderSimdLevel() noexcept;
+	}
+}
\ No newline at end of file